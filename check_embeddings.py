@@ -0,0 +1,44 @@
+import sys
+
+# Compare an extract_embeddings CSV with the vectors create_test_network.py expects
+# Usage: python3 check_embeddings.py <embeddings_csv> [expected_csv] [tolerance]
+embeddings_csv = sys.argv[1]
+expected_csv = sys.argv[2] if len(sys.argv) > 2 else 'test_net/expected.csv'
+tolerance = float(sys.argv[3]) if len(sys.argv) > 3 else 1e-3   # extract_embeddings writes 4 decimals
+
+
+def read_rows(filename):
+    rows = {}
+    with open(filename) as f:
+        for line in f:
+            values = line.strip().split(',')
+            if len(values) > 1:
+                rows[values[0]] = [float(v) for v in values[1:]]
+    return rows
+
+
+actual = read_rows(embeddings_csv)
+expected = read_rows(expected_csv)
+
+failures = 0
+max_error = 0.0
+for name in sorted(expected):
+    if name not in actual:
+        print("Missing: " + name)
+        failures += 1
+        continue
+    if len(actual[name]) != len(expected[name]):
+        print("%s: %d values, expected %d" % (name, len(actual[name]), len(expected[name])))
+        failures += 1
+        continue
+    error = max(abs(a - e) for a, e in zip(actual[name], expected[name]))
+    max_error = max(max_error, error)
+    if error > tolerance:
+        print("%s: off by %.6f" % (name, error))
+        failures += 1
+for name in sorted(set(actual) - set(expected)):
+    print("Unexpected: " + name)
+    failures += 1
+
+print("%s: %d of %d rows match (max error %.6f)" % (embeddings_csv, len(expected) - failures, len(expected), max_error))
+sys.exit(1 if failures else 0)
@@ -0,0 +1,83 @@
+import sys
+import math
+import cv2
+import numpy as np
+
+# Results of bench_scale (n,path,gen_secs,median_ms,items_per_sec,queries_per_sec,held_mb,rss_mb,agrees,build_secs,recall)
+results_csv = sys.argv[1] if len(sys.argv) > 1 else 'scaling_results.csv'
+output = sys.argv[2] if len(sys.argv) > 2 else 'results/scaling.jpg'
+
+rows = []
+with open(results_csv) as f:
+    header = f.readline().strip().split(',')
+    for line in f:
+        values = line.strip().split(',')
+        if len(values) == len(header):
+            rows.append(dict(zip(header, values)))
+
+paths = []
+for r in rows:
+    if r['path'] not in paths:
+        paths.append(r['path'])
+colors = {'stream': (0, 140, 255), 'memory': (255, 160, 0), 'blocked': (0, 200, 0), 'pq': (200, 0, 200),
+          'inverted': (0, 0, 220), 'pca': (160, 120, 0)}
+
+# Three log-log panels against N
+panels = [('median_ms', 'Latency (ms per query)'),
+          ('items_per_sec', 'Throughput (images scored / s)'),
+          ('held_mb', 'Memory held (MB)')]
+width, height = 420, 340
+left, right, top, bottom = 70, 20, 40, 50
+font = cv2.FONT_HERSHEY_SIMPLEX
+
+all_n = [float(r['n']) for r in rows]
+x_lo = math.floor(math.log10(min(all_n)))
+x_hi = max(math.ceil(math.log10(max(all_n))), x_lo + 1)
+
+images = []
+for key, title in panels:
+    panel = np.full((height, width, 3), 255, dtype=np.uint8)
+    values = [float(r[key]) for r in rows if float(r[key]) > 0]
+    y_lo = math.floor(math.log10(min(values)))
+    y_hi = max(math.ceil(math.log10(max(values))), y_lo + 1)
+
+    def point(n, v):
+        x = left + (math.log10(n) - x_lo) / (x_hi - x_lo) * (width - left - right)
+        y = height - bottom - (math.log10(v) - y_lo) / (y_hi - y_lo) * (height - top - bottom)
+        return (int(round(x)), int(round(y)))
+
+    # Axes and decade grid lines
+    for e in range(x_lo, x_hi + 1):
+        x, _ = point(10 ** e, 10 ** y_lo)
+        cv2.line(panel, (x, top), (x, height - bottom), (220, 220, 220), 1)
+        cv2.putText(panel, '1e%d' % e, (x - 14, height - bottom + 18), font, 0.4, (0, 0, 0), 1)
+    for e in range(y_lo, y_hi + 1):
+        _, y = point(10 ** x_lo, 10 ** e)
+        cv2.line(panel, (left, y), (width - right, y), (220, 220, 220), 1)
+        cv2.putText(panel, '1e%d' % e, (left - 40, y + 4), font, 0.4, (0, 0, 0), 1)
+    cv2.rectangle(panel, (left, top), (width - right, height - bottom), (0, 0, 0), 1)
+    cv2.putText(panel, title, (left, top - 14), font, 0.5, (0, 0, 0), 1)
+    cv2.putText(panel, 'images (N)', (width // 2 - 30, height - 12), font, 0.45, (0, 0, 0), 1)
+
+    # One line per query path
+    for p in paths:
+        points = [point(float(r['n']), float(r[key])) for r in rows if r['path'] == p and float(r[key]) > 0]
+        color = colors.get(p, (120, 120, 120))
+        for a, b in zip(points, points[1:]):
+            cv2.line(panel, a, b, color, 2)
+        for a in points:
+            cv2.circle(panel, a, 3, color, -1)
+    images.append(panel)
+
+figure = np.hstack(images)
+
+# Legend, three paths per row
+for i, p in enumerate(paths):
+    x = left + 10 + (i % 3) * 110
+    y = top + 14 + (i // 3) * 18
+    cv2.line(figure, (x, y), (x + 24, y), colors.get(p, (120, 120, 120)), 2)
+    cv2.putText(figure, p, (x + 30, y + 4), font, 0.45, (0, 0, 0), 1)
+
+# Save
+cv2.imwrite(output, figure)
+print("Saved to " + output)
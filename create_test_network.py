@@ -0,0 +1,100 @@
+import os
+import sys
+import cv2
+import numpy as np
+
+# Tiny ONNX network with known weights, test images and the embeddings extract_embeddings must give
+#   input (N x 3 x S x S) -> GlobalAveragePool -> Flatten -> Gemm (W: D x 3, b: D) -> output (N x D)
+# Usage: python3 create_test_network.py [output_dir]
+#   writes <dir>/tiny_net.onnx, <dir>/images/*.png and <dir>/expected.csv
+output_dir = sys.argv[1] if len(sys.argv) > 1 else 'test_net'
+size = 32          # run extract_embeddings with --size 32, so nothing is resized
+dim = 8
+num_images = 7     # not a multiple of the batch sizes, so the last batch is partial
+
+
+# Minimal protobuf encoding (varint and length-delimited fields only)
+def varint(v):
+    out = b''
+    while True:
+        byte = v & 0x7f
+        v >>= 7
+        if v:
+            out += bytes([byte | 0x80])
+        else:
+            return out + bytes([byte])
+
+
+def field_int(num, v):
+    return varint(num << 3) + varint(v)
+
+
+def field_bytes(num, data):
+    if isinstance(data, str):
+        data = data.encode()
+    return varint((num << 3) | 2) + varint(len(data)) + data
+
+
+def tensor(name, array):
+    array = np.ascontiguousarray(array, dtype=np.float32)
+    out = b''.join(field_int(1, d) for d in array.shape)
+    return out + field_int(2, 1) + field_bytes(8, name) + field_bytes(9, array.tobytes())
+
+
+def value_info(name, dims):
+    shape = b''
+    for d in dims:
+        shape += field_bytes(1, field_bytes(2, d) if isinstance(d, str) else field_int(1, d))
+    tensor_type = field_int(1, 1) + field_bytes(2, shape)
+    return field_bytes(1, name) + field_bytes(2, field_bytes(1, tensor_type))
+
+
+def node(op, inputs, outputs, attributes=()):
+    out = b''.join(field_bytes(1, i) for i in inputs)
+    out += b''.join(field_bytes(2, o) for o in outputs)
+    out += field_bytes(3, op.lower()) + field_bytes(4, op)
+    for name, value in attributes:
+        out += field_bytes(5, field_bytes(1, name) + field_int(3, value) + field_int(20, 2))
+    return out
+
+
+# Known weights: W[d][c] and b[d] from a fixed formula, so the net is the same everywhere
+W = np.array([[((d * 3 + c) % 7 - 3) * 0.25 for c in range(3)] for d in range(dim)], dtype=np.float32)
+b = np.array([(d - dim / 2) * 0.125 for d in range(dim)], dtype=np.float32)
+
+graph = field_bytes(1, node('GlobalAveragePool', ['input'], ['pooled']))
+graph += field_bytes(1, node('Flatten', ['pooled'], ['flat'], [('axis', 1)]))
+graph += field_bytes(1, node('Gemm', ['flat', 'W', 'b'], ['output'], [('transB', 1)]))
+graph += field_bytes(2, 'tiny_net')
+graph += field_bytes(5, tensor('W', W)) + field_bytes(5, tensor('b', b))
+graph += field_bytes(11, value_info('input', ['N', 3, size, size]))
+graph += field_bytes(12, value_info('output', ['N', dim]))
+
+model = field_int(1, 7) + field_bytes(2, 'create_test_network.py')
+model += field_bytes(7, graph) + field_bytes(8, field_bytes(1, '') + field_int(2, 11))
+
+os.makedirs(os.path.join(output_dir, 'images'), exist_ok=True)
+with open(os.path.join(output_dir, 'tiny_net.onnx'), 'wb') as f:
+    f.write(model)
+
+# Test images: seeded noise with a different colour cast each, saved losslessly at the input size
+rng = np.random.RandomState(1234)
+mean = np.array([123.675, 116.28, 103.53])      # RGB, as in embed_batch
+std = np.array([0.229, 0.224, 0.225])
+rows = []
+for i in range(num_images):
+    cast = rng.randint(0, 256, size=3)
+    img = np.clip(rng.randint(-60, 61, size=(size, size, 3)) + cast, 0, 255).astype(np.uint8)
+    name = 'tiny.%04d.png' % i
+    cv2.imwrite(os.path.join(output_dir, 'images', name), img)
+
+    # embed_batch: BGR -> RGB, (x - mean) / 255 / std, then the network: channel means, W m + b
+    rgb = img[:, :, ::-1].astype(np.float64)
+    pooled = ((rgb - mean) / 255.0 / std).reshape(-1, 3).mean(axis=0)
+    rows.append((name, W.astype(np.float64) @ pooled + b))
+
+with open(os.path.join(output_dir, 'expected.csv'), 'w') as f:
+    for name, v in sorted(rows):
+        f.write(name + ',' + ','.join('%.6f' % x for x in v) + '\n')
+
+print("Saved to " + output_dir + " (tiny_net.onnx, %d images, expected.csv; run with --size %d)" % (num_images, size))
@@ -0,0 +1,260 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Feature kernel benchmark: the fused kernels against the multi-pass OpenCV versions they replace,
+           checking that both give identical histograms
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "features.h"
+#include "image_source.h"
+
+/*
+  Previous gradient magnitude histogram: two Sobel images, two convertScaleAbs, addWeighted, then a binning pass
+*/
+static void magnitude_counts_multipass(const cv::Mat &src, int *counts) {
+    cv::Mat gray;
+    cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    
+    cv::Mat grad_x, grad_y;
+    cv::Sobel(gray, grad_x, CV_16S, 1, 0, 3);
+    cv::Sobel(gray, grad_y, CV_16S, 0, 1, 3);
+    
+    cv::Mat abs_grad_x, abs_grad_y;
+    cv::convertScaleAbs(grad_x, abs_grad_x);
+    cv::convertScaleAbs(grad_y, abs_grad_y);
+    
+    cv::Mat magnitude;
+    cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, magnitude);
+    
+    for(int i = 0; i < GRADIENT_MAGNITUDE_BINS; i++) counts[i] = 0;
+    for(int i = 0; i < magnitude.rows; i++) {
+        for(int j = 0; j < magnitude.cols; j++) {
+            counts[magnitude.at<uchar>(i, j) / 16]++;
+        }
+    }
+}
+
+/*
+  Previous Task 7 edge direction histogram: float Sobel images and atan2 per pixel
+*/
+static void direction_counts_multipass(const cv::Mat &src, int *counts) {
+    cv::Mat gray;
+    cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    
+    cv::Mat gx, gy;
+    cv::Sobel(gray, gx, CV_32F, 1, 0, 3);
+    cv::Sobel(gray, gy, CV_32F, 0, 1, 3);
+    
+    for(int i = 0; i < GRADIENT_DIRECTION_BINS; i++) counts[i] = 0;
+    for(int y = 0; y < gray.rows; y++) {
+        const float *gx_row = gx.ptr<float>(y);
+        const float *gy_row = gy.ptr<float>(y);
+        for(int x = 0; x < gray.cols; x++) {
+            float dx = gx_row[x];
+            float dy = gy_row[x];
+            if(std::fabs(dx) + std::fabs(dy) < 20.0f) continue;
+    
+            float ang = std::atan2(dy, dx);
+            if(ang < 0) ang += 2.0f * (float)M_PI;
+            int bin = (int)(ang / (2.0f * (float)M_PI) * 8.0f);
+            if(bin < 0) bin = 0;
+            if(bin > 7) bin = 7;
+            counts[bin]++;
+        }
+    }
+}
+
+/*
+  Previous HSV histogram: a full cv::cvtColor(COLOR_BGR2HSV) image, then a binning pass
+*/
+static void hsv_counts_twopass(const cv::Mat &src, int (*hue_bin)(int), int *counts) {
+    cv::Mat hsv;
+    cv::cvtColor(src, hsv, cv::COLOR_BGR2HSV);
+    
+    for(int i = 0; i < 128; i++) counts[i] = 0;
+    for(int y = 0; y < hsv.rows; y++) {
+        const cv::Vec3b *row = hsv.ptr<cv::Vec3b>(y);
+        for(int x = 0; x < hsv.cols; x++) {
+            int s_bin = row[x][1] / 64;
+            int v_bin = row[x][2] / 64;
+            counts[hue_bin(row[x][0]) * 16 + s_bin * 4 + v_bin]++;
+        }
+    }
+}
+
+// Task 7 hue bins: (H * 8) / 180
+static int hue_bin_8(int hue) {
+    return std::min((hue * 8) / 180, 7);
+}
+
+/*
+  Best time of R passes of one kernel over every image, in ms
+*/
+template <typename Kernel>
+static double best_ms(const std::vector<cv::Mat> &images, int repeat, Kernel kernel) {
+    double best = 1e30;
+    for(int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        for(const cv::Mat &img : images) {
+            kernel(img);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ms);
+    }
+    return best;
+}
+
+/*
+  Single-query extraction latency on one large image: every method on one core versus in row stripes
+*/
+static void large_image_latency(const cv::Mat &img, double mpix, long long parallel_pixels, int repeat) {
+    double scale = std::sqrt(mpix * 1e6 / (double)img.total());
+    cv::Mat large;
+    cv::resize(img, large, cv::Size(), scale, scale, cv::INTER_LINEAR);
+    std::vector<cv::Mat> one = {large};
+    
+    printf("\nsingle %dx%d image (%.1f Mpixel), %d threads, stripes from %lld pixels\n",
+           large.cols, large.rows, large.total() / 1e6, cv::getNumThreads(), parallel_pixels);
+    printf("%-16s %12s %12s %10s %12s\n", "method", "1 core ms", "striped ms", "speedup", "max |diff|");
+    
+    long long saved = parallel_extraction_pixels();
+    const char *methods[] = {"rgb", "hsv", "pyramid", "color_texture", "laws", "gabor"};
+    for(const char *method : methods) {
+        std::vector<float> serial, striped;
+        
+        set_parallel_extraction_pixels(0);
+        extract_feature(method, large, serial);
+        double serial_ms = best_ms(one, repeat, [&](const cv::Mat &m) {
+            extract_feature(method, const_cast<cv::Mat &>(m), serial);
+        });
+        
+        set_parallel_extraction_pixels(parallel_pixels);
+        extract_feature(method, large, striped);
+        double striped_ms = best_ms(one, repeat, [&](const cv::Mat &m) {
+            extract_feature(method, const_cast<cv::Mat &>(m), striped);
+        });
+        
+        // Histograms match exactly; filter energies only differ in summation order
+        float max_diff = 0.0f;
+        for(size_t i = 0; i < serial.size() && i < striped.size(); i++) {
+            max_diff = std::max(max_diff, std::fabs(serial[i] - striped[i]));
+        }
+        printf("%-16s %12.2f %12.2f %9.2fx %12.2g\n", method, serial_ms, striped_ms, serial_ms / striped_ms, max_diff);
+    }
+    set_parallel_extraction_pixels(saved);
+}
+
+static void print_row(const char *name, double ms, size_t images, size_t pixels) {
+    printf("%-34s %12.3f %12.1f\n", name, ms / images, pixels / 1e3 / ms);
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        printf("Usage: %s <image_directory|pack> [--repeat R] [--limit N] [--large-mpix M] [--parallel-pixels P]\n", argv[0]);
+        printf("  --repeat: timed passes over the images (default 3, best pass reported)\n");
+        printf("  --limit: only use the first N images (default all)\n");
+        printf("  --large-mpix: also time single-image extraction on the first image scaled to M Mpixel (default 24, 0 skips)\n");
+        printf("  --parallel-pixels: row-stripe threshold for that test (default %lld)\n", parallel_extraction_pixels());
+        printf("Example: ./bench_features src/olympus --repeat 5\n");
+        return -1;
+    }
+    
+    int repeat = 3;
+    int limit = 0;
+    double large_mpix = 24.0;
+    long long parallel_pixels = parallel_extraction_pixels();
+    for(int i = 2; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--repeat") == 0) repeat = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--limit") == 0) limit = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--large-mpix") == 0) large_mpix = atof(argv[i + 1]);
+        else if(strcmp(argv[i], "--parallel-pixels") == 0) parallel_pixels = atoll(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(repeat < 1) repeat = 1;
+    
+    // Decode everything up front so only the kernels are timed
+    ImageSource source;
+    if(open_image_source(argv[1], source) != 0) {
+        return -1;
+    }
+    std::vector<cv::Mat> images;
+    size_t pixels = 0;
+    for(int i = 0; i < source.count() && (limit <= 0 || (int)images.size() < limit); i++) {
+        cv::Mat img = read_source_image(source, i);
+        if(img.empty()) continue;
+        pixels += img.total();
+        images.push_back(img);
+    }
+    if(images.empty()) {
+        printf("Error: No images in %s\n", argv[1]);
+        return -1;
+    }
+    printf("%lu images, %.1f Mpixel\n", images.size(), pixels / 1e6);
+    
+    // Both versions must agree bin for bin on every image
+    int gradient_mismatches = 0;
+    int hsv_mismatches = 0;
+    for(const cv::Mat &img : images) {
+        int mag_ref[GRADIENT_MAGNITUDE_BINS], dir_ref[GRADIENT_DIRECTION_BINS];
+        int mag[GRADIENT_MAGNITUDE_BINS], dir[GRADIENT_DIRECTION_BINS];
+        magnitude_counts_multipass(img, mag_ref);
+        direction_counts_multipass(img, dir_ref);
+        gradient_histogram_counts(img, mag, dir);
+        if(memcmp(mag, mag_ref, sizeof(mag)) != 0 || memcmp(dir, dir_ref, sizeof(dir)) != 0) {
+            gradient_mismatches++;
+        }
+        
+        // Both hue binnings in use (histogram_feature_hsv and Task 7)
+        int hsv_ref[128], hsv[128];
+        bool same = true;
+        for(int (*hue_bin)(int) : {hue_bin_23, hue_bin_8}) {
+            hsv_counts_twopass(img, hue_bin, hsv_ref);
+            hsv_histogram_counts(img, hue_bin, hsv);
+            if(memcmp(hsv, hsv_ref, sizeof(hsv)) != 0) same = false;
+        }
+        if(!same) hsv_mismatches++;
+    }
+    printf("gradient histograms: %d of %lu images differ\n", gradient_mismatches, images.size());
+    printf("HSV histograms: %d of %lu images differ\n", hsv_mismatches, images.size());
+    
+    int mag[GRADIENT_MAGNITUDE_BINS], dir[GRADIENT_DIRECTION_BINS];
+    int hsv[128];
+    double gradient_multipass = best_ms(images, repeat, [&](const cv::Mat &img) {
+        magnitude_counts_multipass(img, mag);
+        direction_counts_multipass(img, dir);
+    });
+    double gradient_fused = best_ms(images, repeat, [&](const cv::Mat &img) {
+        gradient_histogram_counts(img, mag, dir);
+    });
+    double hsv_twopass = best_ms(images, repeat, [&](const cv::Mat &img) {
+        hsv_counts_twopass(img, hue_bin_23, hsv);
+    });
+    double hsv_direct = best_ms(images, repeat, [&](const cv::Mat &img) {
+        hsv_histogram_counts(img, hue_bin_23, hsv);
+    });
+    
+    printf("\n%-34s %12s %12s\n", "kernel", "ms/image", "Mpixel/s");
+    print_row("gradient multi-pass (mag + dir)", gradient_multipass, images.size(), pixels);
+    print_row("gradient fused", gradient_fused, images.size(), pixels);
+    print_row("HSV cvtColor + bin pass", hsv_twopass, images.size(), pixels);
+    print_row("HSV direct from BGR", hsv_direct, images.size(), pixels);
+    printf("speedup: gradient %.2fx, HSV %.2fx\n", gradient_multipass / gradient_fused, hsv_twopass / hsv_direct);
+    
+    if(large_mpix > 0) {
+        large_image_latency(images[0], large_mpix, parallel_pixels, repeat);
+    }
+    
+    return gradient_mismatches == 0 && hsv_mismatches == 0 ? 0 : 1;
+}
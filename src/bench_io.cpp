@@ -0,0 +1,178 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Image loading throughput: one blocking read at a time versus read-ahead at several depths
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <opencv2/opencv.hpp>
+#include "image_source.h"
+
+/*
+  Drop a file's cached pages so the next read goes to the device
+*/
+static void evict_file(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static void evict_source(const char *path, const ImageSource &source) {
+    if(source.packed) {
+        evict_file(path);
+        return;
+    }
+    for(const std::string &name : source.names) {
+        evict_file(source.directory + "/" + name);
+    }
+}
+
+// Keeps the checksums from being optimized away
+static volatile unsigned long checksum_sink = 0;
+
+/*
+  Touch the data so mapped pages are really read
+*/
+static unsigned long checksum(const unsigned char *data, size_t length) {
+    unsigned long sum = 0;
+    for(size_t i = 0; i < length; i += 64) sum += data[i];
+    return sum;
+}
+
+struct RunStats {
+    int images = 0;
+    size_t bytes = 0;
+    double secs = 0.0;
+};
+
+/*
+  Baseline: one image at a time, each read (and decoded) before the next starts
+*/
+static RunStats run_blocking(const ImageSource &source, bool decode) {
+    RunStats stats;
+    std::vector<unsigned char> buffer;
+    auto start = std::chrono::steady_clock::now();
+    
+    for(int i = 0; i < source.count(); i++) {
+        if(decode) {
+            cv::Mat img = read_source_image(source, i);
+            if(img.empty()) continue;
+            stats.bytes += img.total() * img.elemSize();
+        } else if(source.packed) {
+            const PackEntry &e = source.pack.entries[i];
+            checksum_sink += checksum(source.pack.data(i), e.length);
+            stats.bytes += e.length;
+        } else {
+            FILE *fp = fopen((source.directory + "/" + source.names[i]).c_str(), "rb");
+            if(!fp) continue;
+            fseek(fp, 0, SEEK_END);
+            long length = ftell(fp);
+            fseek(fp, 0, SEEK_SET);
+            buffer.resize(length > 0 ? length : 0);
+            size_t n = fread(buffer.data(), 1, buffer.size(), fp);
+            fclose(fp);
+            stats.bytes += n;
+        }
+        stats.images++;
+    }
+    
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/*
+  Read-ahead: depth reads in flight while the consumer decodes (or checksums)
+*/
+static RunStats run_read_ahead(const ImageSource &source, int depth, int threads, bool decode, const char *&backend) {
+    RunStats stats;
+    auto start = std::chrono::steady_clock::now();
+    
+    ImageReadAhead reader;
+    start_source_read_ahead(source, std::vector<int>(), depth, threads, reader);
+    backend = reader.backend();
+    
+    int id;
+    const unsigned char *data;
+    size_t length;
+    while(reader.next(id, data, length)) {
+        if(length == 0) continue;
+        if(decode) {
+            cv::Mat img = cv::imdecode(cv::Mat(1, (int)length, CV_8U, (void *)data), cv::IMREAD_COLOR);
+            if(img.empty()) continue;
+            stats.bytes += img.total() * img.elemSize();
+        } else {
+            checksum_sink += checksum(data, length);
+            stats.bytes += length;
+        }
+        stats.images++;
+    }
+    
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+static void print_row(const char *mode, const RunStats &s, bool decode) {
+    printf("%-22s %8d %10.1f %12.1f %s\n", mode, s.images, s.images / s.secs,
+           s.bytes / s.secs / (1024.0 * 1024.0), decode ? "(decoded MB/s)" : "");
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 2) {
+        printf("Usage: %s <image_directory|pack> [--depths 1,4,16,64] [--io-threads T] [--cold] [--decode]\n", argv[0]);
+        printf("  --cold     drop the files from the page cache before every run\n");
+        printf("  --decode   include cv::imdecode (otherwise raw read throughput)\n");
+        printf("Example: ./bench_io src/olympus --cold\n");
+        return -1;
+    }
+    
+    char *path = argv[1];
+    std::vector<int> depths = {1, 4, 16, 64};
+    int io_threads = 4;
+    bool cold = false;
+    bool decode = false;
+    
+    for(int i = 2; i < argc; i++) {
+        if(strcmp(argv[i], "--cold") == 0) cold = true;
+        else if(strcmp(argv[i], "--decode") == 0) decode = true;
+        else if(strcmp(argv[i], "--io-threads") == 0 && i + 1 < argc) io_threads = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--depths") == 0 && i + 1 < argc) {
+            depths.clear();
+            for(char *tok = strtok(argv[++i], ","); tok; tok = strtok(NULL, ",")) depths.push_back(atoi(tok));
+        } else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    printf("%-22s %8s %10s %12s\n", "mode", "images", "images/s", "MB/s");
+    
+    // Each run reopens the source so a pack is mapped fresh after eviction
+    {
+        ImageSource source;
+        if(open_image_source(path, source) != 0) return -1;
+        if(cold) evict_source(path, source);
+        print_row("blocking", run_blocking(source, decode), decode);
+    }
+    
+    for(int depth : depths) {
+        ImageSource source;
+        if(open_image_source(path, source) != 0) return -1;
+        if(cold) evict_source(path, source);
+        const char *backend = "";
+        RunStats stats = run_read_ahead(source, depth, io_threads, decode, backend);
+        char mode[64];
+        snprintf(mode, sizeof(mode), "read-ahead %d (%s)", depth, backend);
+        print_row(mode, stats, decode);
+    }
+    
+    return 0;
+}
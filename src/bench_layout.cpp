@@ -0,0 +1,175 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Layout benchmark: scoring a query against a row-major database versus the column-blocked
+           layout, for 128-, 512- and 1024-d features, checking that both give identical distances
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "distance.h"
+#include "block_kernels.h"
+
+/*
+  Row-major scoring, one image at a time with a single accumulator (the loops of
+  ssd_distance, histogram_intersection_distance and the dnn cosine distance)
+*/
+static void row_ssd_distances(const float *rows, size_t num_rows, int dim, const float *query, float *distances) {
+    for(size_t i = 0; i < num_rows; i++) {
+        const float *x = rows + i * dim;
+        float ssd = 0.0f;
+        for(int d = 0; d < dim; d++) {
+            float diff = query[d] - x[d];
+            ssd += diff * diff;
+        }
+        distances[i] = ssd;
+    }
+}
+
+static void row_intersection_distances(const float *rows, size_t num_rows, int dim, const float *query, float *distances) {
+    for(size_t i = 0; i < num_rows; i++) {
+        const float *x = rows + i * dim;
+        float intersection = 0.0f;
+        for(int d = 0; d < dim; d++) {
+            intersection += std::min(query[d], x[d]);
+        }
+        distances[i] = 1.0f - intersection;
+    }
+}
+
+static void row_cosine_distances(const float *rows, size_t num_rows, int dim, const float *query, float *distances) {
+    for(size_t i = 0; i < num_rows; i++) {
+        const float *x = rows + i * dim;
+        float dot = 0.0f, nq = 0.0f, nx = 0.0f;
+        for(int d = 0; d < dim; d++) {
+            dot += query[d] * x[d];
+            nq += query[d] * query[d];
+            nx += x[d] * x[d];
+        }
+        distances[i] = cosine_distance_from_sums(dot, nq, nx);
+    }
+}
+
+typedef void (*RowDistance)(const float *rows, size_t num_rows, int dim, const float *query, float *distances);
+
+/*
+  Best time of R full scans, in ms
+*/
+template <typename Scan>
+static double best_ms(int repeat, Scan scan) {
+    double best = 1e30;
+    for(int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        scan();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ms);
+    }
+    return best;
+}
+
+/*
+  Parse a list such as "128,512,1024"
+*/
+static int parse_dims(const char *spec, std::vector<int> &dims) {
+    dims.clear();
+    std::string s(spec);
+    size_t start = 0;
+    while(start <= s.size()) {
+        size_t end = s.find(',', start);
+        if(end == std::string::npos) end = s.size();
+        int d = atoi(s.substr(start, end - start).c_str());
+        if(d <= 0) return -1;
+        dims.push_back(d);
+        start = end + 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = 20000;
+    int repeat = 5;
+    std::vector<int> dims = {128, 512, 1024};
+    for(int i = 1; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--count") == 0) count = strtoul(argv[i + 1], NULL, 10);
+        else if(strcmp(argv[i], "--repeat") == 0) repeat = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--dims") == 0) {
+            if(parse_dims(argv[i + 1], dims) != 0) {
+                printf("Error: Bad dimension list %s\n", argv[i + 1]);
+                return -1;
+            }
+        }
+        else {
+            printf("Usage: %s [--count N] [--dims 128,512,1024] [--repeat R]\n", argv[0]);
+            printf("  --count: database images (default 20000)\n");
+            printf("  --dims: feature dimensions to test (default 128,512,1024)\n");
+            printf("  --repeat: timed scans per kernel (default 5, best reported)\n");
+            return -1;
+        }
+    }
+    if(repeat < 1) repeat = 1;
+    if(count == 0) count = 1;
+    
+    struct Kernel {
+        const char *name;
+        RowDistance row;
+        BlockDistance block;
+    };
+    const Kernel kernels[] = {
+        {"ssd", row_ssd_distances, block_ssd_distances},
+        {"intersection", row_intersection_distances, block_intersection_distances},
+        {"cosine", row_cosine_distances, block_cosine_distances},
+    };
+    
+    printf("%lu images, block of %d, best of %d scans\n", count, FEATURE_BLOCK, repeat);
+    printf("%-6s %-14s %12s %10s %12s %10s %9s %10s\n", "dim", "distance", "row-major ms", "GB/s",
+           "blocked ms", "GB/s", "speedup", "identical");
+    
+    int mismatches = 0;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    for(int dim : dims) {
+        // Random histograms normalized to sum 1, like the color features
+        std::vector<float> rows(count * dim);
+        for(size_t i = 0; i < count; i++) {
+            float sum = 0.0f;
+            for(int d = 0; d < dim; d++) sum += rows[i * dim + d] = uniform(rng);
+            for(int d = 0; d < dim; d++) rows[i * dim + d] /= sum;
+        }
+        size_t num_blocks = (count + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+        std::vector<float> blocks(num_blocks * FEATURE_BLOCK * dim);
+        transpose_to_blocks(rows.data(), count, dim, blocks.data());
+        
+        std::vector<float> query(rows.begin() + (count / 2) * dim, rows.begin() + (count / 2 + 1) * dim);
+        std::vector<float> row_dists(count), block_dists(num_blocks * FEATURE_BLOCK);
+        double gb = count * (double)dim * sizeof(float) / 1e9;
+        
+        for(const Kernel &k : kernels) {
+            double row_ms = best_ms(repeat, [&]() {
+                k.row(rows.data(), count, dim, query.data(), row_dists.data());
+            });
+            double block_ms = best_ms(repeat, [&]() {
+                k.block(blocks.data(), num_blocks, dim, query.data(), block_dists.data());
+            });
+            bool identical = memcmp(row_dists.data(), block_dists.data(), count * sizeof(float)) == 0;
+            if(!identical) mismatches++;
+            printf("%-6d %-14s %12.2f %10.2f %12.2f %10.2f %8.2fx %10s\n", dim, k.name, row_ms, gb / (row_ms / 1e3),
+                   block_ms, gb / (block_ms / 1e3), row_ms / block_ms, identical ? "yes" : "NO");
+        }
+        
+        // The row-major kernels must also agree with the distance functions the matchers use
+        std::vector<float> a(query), b(rows.begin(), rows.begin() + dim);
+        float ssd = 0.0f, intersection = 0.0f;
+        row_ssd_distances(b.data(), 1, dim, a.data(), &ssd);
+        row_intersection_distances(b.data(), 1, dim, a.data(), &intersection);
+        if(ssd != ssd_distance(a, b) || intersection != histogram_intersection_distance(a, b)) mismatches++;
+    }
+    
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,547 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Scaling benchmark: query latency, throughput and memory of the streaming, in-memory and
+           column-blocked scans, and of the PQ, inverted index and PCA paths, over synthetic feature
+           stores of 10^3 to 10^7 images
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <queue>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <unistd.h>
+#include "synthetic_data.h"
+#include "retrieval_engine.h"
+#include "feature_store.h"
+#include "parallel_scan.h"
+#include "block_kernels.h"
+#include "pq_index.h"
+#include "sparse_hist.h"
+#include "embedding_store.h"
+#include "pca_index.h"
+
+/*
+  Resident set size now, in MB (0 where /proc is not available)
+*/
+static double current_rss_mb() {
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if(!fp) return 0.0;
+    long pages = 0, resident = 0;
+    int fields = fscanf(fp, "%ld %ld", &pages, &resident);
+    fclose(fp);
+    if(fields != 2) return 0.0;
+    return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+/*
+  Parse a list such as "1e3,1e4,1e5"
+*/
+static int parse_sizes(const char *spec, std::vector<uint64_t> &sizes) {
+    sizes.clear();
+    std::string s(spec);
+    size_t start = 0;
+    while(start <= s.size()) {
+        size_t end = s.find(',', start);
+        if(end == std::string::npos) end = s.size();
+        double n = atof(s.substr(start, end - start).c_str());
+        if(n < 1.0) return -1;
+        sizes.push_back((uint64_t)std::llround(n));
+        start = end + 1;
+    }
+    return 0;
+}
+
+/*
+  Top k distances of one query over the store, read in chunks under the
+  memory budget (the stream_query path for a row-major store)
+*/
+static int stream_top_k(const char *store_path, const FeatureStoreInfo &info, const RetrievalMethod &method,
+                        const std::vector<float> &query, int k, size_t mem_budget, std::vector<float> &distances,
+                        StreamScanStats &stats) {
+    std::priority_queue<float> best;
+    std::vector<float> row_vec(info.dim);
+    int status = stream_scan(store_path, info, mem_budget,
+        [&](uint64_t first_row, const float *rows, size_t num_rows) {
+            for(size_t r = 0; r < num_rows; r++) {
+                row_vec.assign(rows + r * info.dim, rows + (r + 1) * info.dim);
+                float d = method.distance(query, row_vec);
+                if((int)best.size() < k) {
+                    best.push(d);
+                } else if(d < best.top()) {
+                    best.pop();
+                    best.push(d);
+                }
+            }
+        },
+        stats);
+    distances.clear();
+    while(!best.empty()) {
+        distances.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(distances.begin(), distances.end());
+    return status;
+}
+
+/*
+  The k smallest distances with their rows, best first
+*/
+static void smallest_k(const std::vector<float> &distances, int k, std::vector<std::pair<float, int>> &best) {
+    std::priority_queue<std::pair<float, int>> heap;
+    for(size_t i = 0; i < distances.size(); i++) {
+        if((int)heap.size() < k) {
+            heap.push({distances[i], (int)i});
+        } else if(distances[i] < heap.top().first) {
+            heap.pop();
+            heap.push({distances[i], (int)i});
+        }
+    }
+    best.clear();
+    while(!heap.empty()) {
+        best.push_back(heap.top());
+        heap.pop();
+    }
+    std::reverse(best.begin(), best.end());
+}
+
+/*
+  Re-rank an approximate shortlist with the method's exact distance and keep the best k
+*/
+static void rerank(const std::vector<float> &data, int dim, const RetrievalMethod &method,
+                   const std::vector<float> &query, int k, std::vector<std::pair<float, int>> &best) {
+    std::vector<float> row_vec(dim);
+    for(std::pair<float, int> &b : best) {
+        row_vec.assign(&data[(size_t)b.second * dim], &data[(size_t)(b.second + 1) * dim]);
+        b.first = method.distance(query, row_vec);
+    }
+    std::sort(best.begin(), best.end());
+    best.resize(std::min(k, (int)best.size()));
+}
+
+/*
+  Recall@k of re-ranked results: those within the k-th exact distance of the
+  streaming scan (so ties at the k-th distance count, whichever row the scan kept)
+*/
+static double recall_at_k(const std::vector<std::pair<float, int>> &best, const std::vector<float> &expected) {
+    if(expected.empty()) return 1.0;
+    int hits = 0;
+    for(const std::pair<float, int> &b : best) {
+        if(b.first <= expected.back()) hits++;
+    }
+    return std::min(1.0, (double)hits / expected.size());
+}
+
+/*
+  PQ index of the loaded rows: codebooks trained on up to sample rows spread
+  over the store, then every row encoded, a slice per pool worker
+*/
+static int build_pq(ScanPool &pool, const std::vector<float> &data, uint64_t n, int dim, int num_sub, int sample,
+                    PQIndex &index) {
+    int rows = (int)std::min<uint64_t>(n, sample);
+    std::vector<std::vector<float>> training(rows);
+    for(int r = 0; r < rows; r++) {
+        const float *x = &data[(size_t)((uint64_t)r * n / rows) * dim];
+        training[r].assign(x, x + dim);
+    }
+    if(pq_train(training, num_sub, 8, 8, index) != 0) {
+        return -1;
+    }
+    
+    index.codes.assign((size_t)n * num_sub, 0);
+    int workers = pool.size();
+    pool.run([&](int w) {
+        PQIndex slice;
+        slice.dim = index.dim;
+        slice.num_sub = index.num_sub;
+        slice.sub_dim = index.sub_dim;
+        slice.nbits = index.nbits;
+        slice.centroids = index.centroids;
+        uint64_t end = n * (w + 1) / workers;
+        std::vector<std::vector<float>> chunk;
+        for(uint64_t first = n * w / workers; first < end; first += 4096) {
+            uint64_t last = std::min<uint64_t>(end, first + 4096);
+            chunk.resize(last - first);
+            for(uint64_t i = first; i < last; i++) {
+                chunk[i - first].assign(&data[i * dim], &data[(i + 1) * dim]);
+            }
+            pq_encode(chunk, std::vector<std::string>(chunk.size()), slice);
+            std::copy(slice.codes.begin(), slice.codes.end(), index.codes.begin() + first * num_sub);
+        }
+    });
+    index.filenames.assign(n, std::string());
+    return 0;
+}
+
+/*
+  PCA index of the loaded rows: the projection fitted to up to sample rows
+  spread over the store, then every normalized row projected, a slice per worker
+*/
+static int build_pca(ScanPool &pool, const std::vector<float> &data, uint64_t n, int dim, int components, int sample,
+                     PCAIndex &index) {
+    int rows = (int)std::min<uint64_t>(n, sample);
+    std::vector<std::string> names(rows);
+    std::vector<float> values((size_t)rows * dim);
+    for(int r = 0; r < rows; r++) {
+        const float *x = &data[(size_t)((uint64_t)r * n / rows) * dim];
+        std::copy(x, x + dim, &values[(size_t)r * dim]);
+        names[r] = std::to_string(r);
+    }
+    EmbeddingStore training;
+    if(build_embedding_store(names, values, dim, training) != 0 || pca_train(training, components, 0, index) != 0) {
+        return -1;
+    }
+    
+    index.names.assign(n, std::string());
+    index.reduced.assign((size_t)n * index.stride, 0.0f);
+    index.offsets.resize(n);
+    int workers = pool.size();
+    pool.run([&](int w) {
+        std::vector<float> x(dim);
+        for(uint64_t i = n * w / workers; i < n * (w + 1) / workers; i++) {
+            const float *row = &data[i * dim];
+            float norm = 0.0f;
+            for(int d = 0; d < dim; d++) norm += row[d] * row[d];
+            float scale = norm > 0.0f ? 1.0f / std::sqrt(norm) : 0.0f;
+            for(int d = 0; d < dim; d++) x[d] = row[d] * scale;
+            pca_project(index, x.data(), &index.reduced[i * index.stride], index.offsets[i]);
+        }
+    });
+    return 0;
+}
+
+struct PathResult {
+    const char *path;
+    std::vector<double> ms;       // one per query
+    double held_mb = 0.0;         // feature data the path keeps in memory
+    double rss_mb = 0.0;
+    double build_secs = 0.0;      // index build, for the paths that have one
+    bool exact = true;            // exact paths must agree; approximate ones report recall
+    bool agrees = true;           // same top-k distances as the streaming scan
+    double recall = 0.0;          // mean recall@k against the streaming scan (approximate paths)
+};
+
+static double median(std::vector<double> values) {
+    if(values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 3) {
+        printf("Usage: %s <features_csv> <method> [--sizes 1e3,1e4,1e5,1e6,1e7] [--queries Q] [--k K] [--threads T]\n", argv[0]);
+        printf("       [--budget MB] [--mem-limit MB] [--dir D] [--out results.csv] [--seed S] [--keep]\n");
+        printf("  Each size gets a synthetic store made from the real features (see scale_dataset), then\n");
+        printf("  Q queries through each path: stream (chunks under --budget, default 256 MB),\n");
+        printf("  memory (loaded rows, parallel_top_k) and blocked (column-blocked kernel, if the method has one),\n");
+        printf("  then the indexes built from the loaded rows for the methods they serve: pq (baseline, rgb, hsv),\n");
+        printf("  inverted (rgb, hsv) and pca (dnn); pq and pca re-rank 10 x K candidates exactly and report recall@K.\n");
+        printf("  BoW, LSH/hybrid and sharded queries need images or several stores and are not run here\n");
+        printf("  --mem-limit: skip the in-memory paths and indexes when they would need more (default half of RAM)\n");
+        printf("  --dir: where the stores go (default .); --keep leaves them there\n");
+        printf("  --out: results CSV for create_scaling_figure.py (default scaling_results.csv)\n");
+        printf("Example: ./bench_scale olympus_rgb.csv rgb --sizes 1e3,1e4,1e5,1e6\n");
+        return -1;
+    }
+    
+    const char *features_csv = argv[1];
+    const char *method_name = argv[2];
+    std::vector<uint64_t> sizes = {1000, 10000, 100000, 1000000, 10000000};
+    int num_queries = 10;
+    int k = 10;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t budget = (size_t)256 << 20;
+    double mem_limit_mb = sysconf(_SC_PHYS_PAGES) * (double)sysconf(_SC_PAGESIZE) / (2.0 * 1024.0 * 1024.0);
+    std::string dir = ".";
+    const char *out_csv = "scaling_results.csv";
+    uint64_t seed = 42;
+    bool keep = false;
+    for(int i = 3; i < argc; i++) {
+        if(strcmp(argv[i], "--keep") == 0) keep = true;
+        else if(i + 1 < argc && strcmp(argv[i], "--sizes") == 0) {
+            if(parse_sizes(argv[++i], sizes) != 0) {
+                printf("Error: Bad size list %s\n", argv[i]);
+                return -1;
+            }
+        }
+        else if(i + 1 < argc && strcmp(argv[i], "--queries") == 0) num_queries = std::max(1, atoi(argv[++i]));
+        else if(i + 1 < argc && strcmp(argv[i], "--k") == 0) k = std::max(1, atoi(argv[++i]));
+        else if(i + 1 < argc && strcmp(argv[i], "--threads") == 0) threads = std::max(1, atoi(argv[++i]));
+        else if(i + 1 < argc && strcmp(argv[i], "--budget") == 0) budget = (size_t)std::max(1, atoi(argv[++i])) << 20;
+        else if(i + 1 < argc && strcmp(argv[i], "--mem-limit") == 0) mem_limit_mb = atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--dir") == 0) dir = argv[++i];
+        else if(i + 1 < argc && strcmp(argv[i], "--out") == 0) out_csv = argv[++i];
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    const RetrievalMethod *method = find_retrieval_method(method_name);
+    if(!method) {
+        printf("Error: Unknown method %s\n", method_name);
+        return -1;
+    }
+    FeatureDatabase db;
+    if(load_feature_database(features_csv, db) != 0) {
+        return -1;
+    }
+    FeatureModel model;
+    if(fit_feature_model(db, model) != 0) {
+        return -1;
+    }
+    
+    // Queries are synthetic rows from another seed, so none of them is in a store
+    std::vector<std::vector<float>> queries(num_queries, std::vector<float>(model.dim));
+    for(int q = 0; q < num_queries; q++) {
+        synthesize_feature_row(model, seed + 1, q, queries[q].data());
+    }
+    
+    FILE *out = fopen(out_csv, "w");
+    if(!out) {
+        printf("Error: Unable to write %s\n", out_csv);
+        return -1;
+    }
+    fprintf(out, "n,path,gen_secs,median_ms,items_per_sec,queries_per_sec,held_mb,rss_mb,agrees,build_secs,recall\n");
+    
+    ScanPool pool(threads);
+    printf("%s, %d-d, %d queries, top %d, %d threads, stream budget %lu MB, in-memory limit %.0f MB\n",
+           method_name, model.dim, num_queries, k, threads, (unsigned long)(budget >> 20), mem_limit_mb);
+    printf("%10s %-8s %9s %11s %14s %10s %10s %10s %7s %9s %7s\n", "images", "path", "gen s", "median ms", "images/s",
+           "queries/s", "held MB", "RSS MB", "agrees", "build s", "recall");
+    
+    int mismatches = 0;
+    for(uint64_t n : sizes) {
+        char store_name[64];
+        snprintf(store_name, sizeof(store_name), "/scale_%llu.store", (unsigned long long)n);
+        std::string store_path = dir + store_name;
+        
+        auto start = std::chrono::steady_clock::now();
+        if(write_synthetic_store(store_path.c_str(), model, n, seed, threads) < 0) {
+            fclose(out);
+            return -1;
+        }
+        double gen_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        FeatureStoreInfo info;
+        if(read_feature_store_info(store_path.c_str(), info) != 0) {
+            fclose(out);
+            return -1;
+        }
+        double data_mb = n * (double)info.row_bytes() / (1024.0 * 1024.0);
+        std::vector<PathResult> results;
+        
+        // Streaming: chunks of the store under the budget (warm page cache unless the store exceeds RAM)
+        std::vector<std::vector<float>> expected(num_queries);
+        PathResult stream = {"stream"};
+        StreamScanStats stream_stats;
+        for(int q = 0; q < num_queries; q++) {
+            auto t0 = std::chrono::steady_clock::now();
+            if(stream_top_k(store_path.c_str(), info, *method, queries[q], k, budget, expected[q], stream_stats) != 0) {
+                fclose(out);
+                return -1;
+            }
+            stream.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+        }
+        stream.held_mb = 2.0 * stream_stats.chunk_rows * info.row_bytes() / (1024.0 * 1024.0);
+        stream.rss_mb = current_rss_mb();
+        results.push_back(stream);
+        
+        auto same_top = [&](const std::vector<ScanMatch> &matches, int q) {
+            if(matches.size() != expected[q].size()) return false;
+            for(size_t i = 0; i < matches.size(); i++) {
+                if(matches[i].distance != expected[q][i]) return false;
+            }
+            return true;
+        };
+        
+        // In memory: row-major, then column-blocked (rows and blocks both exist while transposing)
+        if(data_mb <= mem_limit_mb) {
+            std::vector<float> data;
+            if(load_feature_store(store_path.c_str(), info, data) != 0) {
+                fclose(out);
+                return -1;
+            }
+            PathResult memory = {"memory"};
+            std::vector<ScanMatch> matches;
+            ParallelScanStats scan_stats;
+            for(int q = 0; q < num_queries; q++) {
+                auto t0 = std::chrono::steady_clock::now();
+                parallel_top_k(pool, info, data, *method, queries[q], k, matches, scan_stats);
+                memory.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                memory.agrees = memory.agrees && same_top(matches, q);
+            }
+            memory.held_mb = data_mb;
+            memory.rss_mb = current_rss_mb();
+            results.push_back(memory);
+            
+            // Indexes over the loaded rows, for the methods whose distance they compute
+            std::vector<float> distances;
+            std::vector<std::pair<float, int>> best;
+            auto same_best = [&](const std::vector<std::pair<float, int>> &found, int q) {
+                if(found.size() != expected[q].size()) return false;
+                for(size_t i = 0; i < found.size(); i++) {
+                    if(found[i].first != expected[q][i]) return false;
+                }
+                return true;
+            };
+            bool histogram = strcmp(method_name, "rgb") == 0 || strcmp(method_name, "hsv") == 0;
+            
+            // Approximate paths re-rank this many candidates with the exact distance
+            int shortlist = 10 * k;
+            
+            // PQ: 8-bit codes of 8-value subvectors, asymmetric distances from a lookup table
+            if(histogram || strcmp(method_name, "baseline") == 0) {
+                int metric = histogram ? PQ_INTERSECTION : PQ_SSD;
+                auto t0 = std::chrono::steady_clock::now();
+                PQIndex pq;
+                if(build_pq(pool, data, n, info.dim, (info.dim + 7) / 8, 20000, pq) != 0) {
+                    fclose(out);
+                    return -1;
+                }
+                PathResult pq_path = {"pq"};
+                pq_path.exact = false;
+                pq_path.build_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                std::vector<float> table;
+                float offset = 0.0f;
+                for(int q = 0; q < num_queries; q++) {
+                    t0 = std::chrono::steady_clock::now();
+                    pq_distance_table(pq, queries[q], metric, table, offset);
+                    pq_scan(pq, table, offset, distances);
+                    smallest_k(distances, shortlist, best);
+                    rerank(data, info.dim, *method, queries[q], k, best);
+                    pq_path.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                    pq_path.recall += recall_at_k(best, expected[q]) / num_queries;
+                }
+                pq_path.held_mb = (pq.codes.size() + pq.centroids.size() * sizeof(float)) / (1024.0 * 1024.0);
+                pq_path.rss_mb = current_rss_mb();
+                results.push_back(pq_path);
+            }
+            
+            // Inverted index: exact intersection over the posting lists of the query's non-zero bins
+            if(histogram) {
+                uint64_t nonzero = 0;
+                for(float v : data) nonzero += v != 0.0f;
+                double index_mb = (nonzero * (sizeof(int) + sizeof(float) + sizeof(Posting)) + n * sizeof(SparseHist)) /
+                                  (1024.0 * 1024.0);
+                if(data_mb + index_mb <= mem_limit_mb) {
+                    auto t0 = std::chrono::steady_clock::now();
+                    InvertedIndex inverted;
+                    {
+                        std::vector<SparseHist> hists(n);
+                        std::vector<float> row_vec;
+                        for(uint64_t i = 0; i < n; i++) {
+                            row_vec.assign(&data[i * info.dim], &data[(i + 1) * info.dim]);
+                            to_sparse_hist(row_vec, hists[i]);
+                        }
+                        build_inverted_index(hists, info.dim, inverted);
+                    }
+                    PathResult inverted_path = {"inverted"};
+                    inverted_path.build_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                    SparseHist query;
+                    for(int q = 0; q < num_queries; q++) {
+                        t0 = std::chrono::steady_clock::now();
+                        to_sparse_hist(queries[q], query);
+                        inverted_intersection_distances(inverted, query, distances);
+                        smallest_k(distances, k, best);
+                        inverted_path.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                        inverted_path.agrees = inverted_path.agrees && same_best(best, q);
+                    }
+                    inverted_path.held_mb = nonzero * sizeof(Posting) / (1024.0 * 1024.0);
+                    inverted_path.rss_mb = current_rss_mb();
+                    results.push_back(inverted_path);
+                } else {
+                    printf("%10llu %-8s skipped: building it needs %.0f MB more, over the in-memory limit\n",
+                           (unsigned long long)n, "inverted", index_mb);
+                }
+            }
+            
+            // PCA: 64 principal axes of the normalized rows, reduced-space dot products
+            if(strcmp(method_name, "dnn") == 0) {
+                auto t0 = std::chrono::steady_clock::now();
+                PCAIndex pca;
+                if(build_pca(pool, data, n, info.dim, std::min(64, info.dim), 20000, pca) != 0) {
+                    fclose(out);
+                    return -1;
+                }
+                PathResult pca_path = {"pca"};
+                pca_path.exact = false;
+                pca_path.build_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                std::vector<float> x(info.dim), y(pca.stride);
+                for(int q = 0; q < num_queries; q++) {
+                    t0 = std::chrono::steady_clock::now();
+                    float norm = 0.0f;
+                    for(float v : queries[q]) norm += v * v;
+                    float scale = norm > 0.0f ? 1.0f / std::sqrt(norm) : 0.0f;
+                    for(int d = 0; d < info.dim; d++) x[d] = queries[q][d] * scale;
+                    float offset = 0.0f;
+                    pca_project(pca, x.data(), y.data(), offset);
+                    pca_scan(pca, y.data(), offset, distances);
+                    smallest_k(distances, shortlist, best);
+                    rerank(data, info.dim, *method, queries[q], k, best);
+                    pca_path.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                    pca_path.recall += recall_at_k(best, expected[q]) / num_queries;
+                }
+                pca_path.held_mb = n * (double)pca.image_bytes() / (1024.0 * 1024.0);
+                pca_path.rss_mb = current_rss_mb();
+                results.push_back(pca_path);
+            }
+            
+            if(method->block_distance && 2.0 * data_mb <= mem_limit_mb) {
+                FeatureStoreInfo blocked_info = info;
+                blocked_info.layout = FEATURE_STORE_BLOCKED;
+                std::vector<float> blocks(blocked_info.stored_rows() * info.dim);
+                transpose_to_blocks(data.data(), n, info.dim, blocks.data());
+                std::vector<float>().swap(data);
+                
+                PathResult blocked = {"blocked"};
+                for(int q = 0; q < num_queries; q++) {
+                    auto t0 = std::chrono::steady_clock::now();
+                    parallel_top_k(pool, blocked_info, blocks, *method, queries[q], k, matches, scan_stats);
+                    blocked.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                    blocked.agrees = blocked.agrees && same_top(matches, q);
+                }
+                blocked.held_mb = blocks.size() * sizeof(float) / (1024.0 * 1024.0);
+                blocked.rss_mb = current_rss_mb();
+                results.push_back(blocked);
+            }
+        }
+        
+        for(const PathResult &r : results) {
+            double ms = median(r.ms);
+            double items_per_sec = n / std::max(ms / 1e3, 1e-12);
+            double queries_per_sec = 1e3 / std::max(ms, 1e-9);
+            if(r.exact && !r.agrees) mismatches++;
+            
+            // Exact paths report agreement, approximate ones recall@k
+            char recall[16] = "";
+            if(!r.exact) snprintf(recall, sizeof(recall), "%.4f", r.recall);
+            const char *agrees = !r.exact ? "" : r.agrees ? "1" : "0";
+            printf("%10llu %-8s %9.2f %11.3f %14.3e %10.1f %10.1f %10.1f %7s %9.2f %7s\n", (unsigned long long)n, r.path,
+                   gen_secs, ms, items_per_sec, queries_per_sec, r.held_mb, r.rss_mb,
+                   !r.exact ? "-" : r.agrees ? "yes" : "NO", r.build_secs, r.exact ? "-" : recall);
+            fprintf(out, "%llu,%s,%.3f,%.4f,%.1f,%.3f,%.2f,%.2f,%s,%.3f,%s\n", (unsigned long long)n, r.path, gen_secs, ms,
+                    items_per_sec, queries_per_sec, r.held_mb, r.rss_mb, agrees, r.build_secs, recall);
+        }
+        if(data_mb > mem_limit_mb) {
+            printf("%10llu %-8s skipped: %.0f MB of features is over the in-memory limit\n", (unsigned long long)n,
+                   "memory", data_mb);
+        } else if(method->block_distance && 2.0 * data_mb > mem_limit_mb) {
+            printf("%10llu %-8s skipped: transposing needs %.0f MB, over the in-memory limit\n", (unsigned long long)n,
+                   "blocked", 2.0 * data_mb);
+        }
+        fflush(out);
+        
+        if(!keep) remove(store_path.c_str());
+    }
+    fclose(out);
+    printf("Results written to %s (plot with create_scaling_figure.py)\n", out_csv);
+    
+    return mismatches == 0 ? 0 : 1;
+}
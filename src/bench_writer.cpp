@@ -0,0 +1,237 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Feature file write throughput: append_image_data_csv against the buffered FeatureWriter
+           (CSV and binary store, one or several submitting threads) and a raw fwrite of the same bytes
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include "csv_util.h"
+#include "feature_writer.h"
+#include "feature_store.h"
+
+// Distinct synthetic rows; row i reuses pattern i % SYNTHETIC_ROWS
+#define SYNTHETIC_ROWS 1024
+
+struct WriteStats {
+    uint64_t rows = 0;
+    uint64_t bytes = 0;
+    double secs = 0.0;
+};
+
+static std::string row_name(uint64_t i) {
+    char name[32];
+    snprintf(name, sizeof(name), "pic.%07lu.jpg", (unsigned long)i);
+    return name;
+}
+
+static uint64_t file_size(const std::string &path) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if(!fp) return 0;
+    fseek(fp, 0, SEEK_END);
+    uint64_t size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+static void sync_file(const std::string &path) {
+    FILE *fp = fopen(path.c_str(), "rb");
+    if(!fp) return;
+    fsync(fileno(fp));
+    fclose(fp);
+}
+
+static bool same_prefix(const std::string &a, const std::string &b, uint64_t length) {
+    FILE *fa = fopen(a.c_str(), "rb");
+    FILE *fb = fopen(b.c_str(), "rb");
+    bool same = fa && fb;
+    std::vector<char> ba(1 << 20), bb(1 << 20);
+    while(same && length > 0) {
+        size_t n = std::min<uint64_t>(length, ba.size());
+        same = fread(ba.data(), 1, n, fa) == n && fread(bb.data(), 1, n, fb) == n && memcmp(ba.data(), bb.data(), n) == 0;
+        length -= n;
+    }
+    if(fa) fclose(fa);
+    if(fb) fclose(fb);
+    return same;
+}
+
+/*
+  Old path: one append_image_data_csv call (fopen, a sprintf and fwrite per value, fclose) per row
+*/
+static WriteStats run_legacy(const std::string &path, const std::vector<std::vector<float>> &rows, uint64_t count,
+                             bool sync) {
+    WriteStats stats;
+    auto start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0; i < count; i++) {
+        std::vector<float> &row = const_cast<std::vector<float> &>(rows[i % rows.size()]);
+        append_image_data_csv((char *)path.c_str(), (char *)row_name(i).c_str(), row, i == 0);
+    }
+    if(sync) sync_file(path);
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.rows = count;
+    stats.bytes = file_size(path);
+    return stats;
+}
+
+/*
+  FeatureWriter with rows submitted from several threads, each taking the next row number
+*/
+static WriteStats run_writer(const std::string &path, int format, const std::vector<std::vector<float>> &rows,
+                             uint64_t count, int threads, bool sync) {
+    WriteStats stats;
+    auto start = std::chrono::steady_clock::now();
+    FeatureWriter writer;
+    if(writer.open(path.c_str(), format) != 0) return stats;
+    
+    std::atomic<uint64_t> next{0};
+    auto producer = [&]() {
+        uint64_t i;
+        while((i = next++) < count) {
+            writer.submit(i, row_name(i), rows[i % rows.size()]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int t = 1; t < threads; t++) workers.emplace_back(producer);
+    producer();
+    for(std::thread &w : workers) w.join();
+    
+    int64_t written = writer.close();
+    if(sync) sync_file(path);
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.rows = written < 0 ? 0 : written;
+    stats.bytes = writer.bytes();
+    return stats;
+}
+
+/*
+  Device ceiling: the same number of bytes in large fwrite calls, nothing to format
+*/
+static WriteStats run_raw(const std::string &path, uint64_t bytes, bool sync) {
+    WriteStats stats;
+    std::vector<char> block(FEATURE_WRITER_BUFFER, '7');
+    auto start = std::chrono::steady_clock::now();
+    FILE *fp = fopen(path.c_str(), "wb");
+    if(!fp) return stats;
+    for(uint64_t done = 0; done < bytes; done += block.size()) {
+        fwrite(block.data(), 1, std::min<uint64_t>(block.size(), bytes - done), fp);
+    }
+    if(sync) {
+        fflush(fp);
+        fsync(fileno(fp));
+    }
+    fclose(fp);
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.bytes = bytes;
+    return stats;
+}
+
+static void print_stats(const char *label, const WriteStats &s) {
+    printf("%-24s %10lu %10.2f %12.0f %10.1f\n", label, (unsigned long)s.rows, s.secs,
+           s.rows > 0 ? s.rows / s.secs : 0.0, s.bytes / s.secs / (1 << 20));
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t count = 100000;
+    int dims = 512;
+    uint64_t legacy_rows = 20000;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string prefix = "bench_writer";
+    bool sync = false;
+    bool keep = false;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--sync") == 0) sync = true;
+        else if(strcmp(argv[i], "--keep") == 0) keep = true;
+        else if(i + 1 < argc && strcmp(argv[i], "--count") == 0) count = atoll(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--dims") == 0) dims = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--legacy-rows") == 0) legacy_rows = atoll(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--threads") == 0) threads = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--out") == 0) prefix = argv[++i];
+        else {
+            printf("Usage: %s [--count N] [--dims D] [--legacy-rows L] [--threads T] [--out prefix] [--sync] [--keep]\n", argv[0]);
+            printf("  --count: rows written by the FeatureWriter runs (default 100000)\n");
+            printf("  --legacy-rows: rows written through append_image_data_csv (default 20000, 0 = skip)\n");
+            printf("  --sync: include fsync in every timing, so the device is measured and not the page cache\n");
+            printf("Example: ./bench_writer --count 1000000 --dims 512 --sync\n");
+            return -1;
+        }
+    }
+    if(count == 0 || dims <= 0 || threads <= 0) {
+        printf("Error: count, dims and threads must be > 0\n");
+        return -1;
+    }
+    legacy_rows = std::min(legacy_rows, count);
+    
+    // Histogram-like rows: mostly small fractions, some empty bins
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::vector<std::vector<float>> rows(SYNTHETIC_ROWS, std::vector<float>(dims));
+    for(std::vector<float> &row : rows) {
+        for(float &v : row) v = uniform(rng) < 0.3f ? 0.0f : uniform(rng) * uniform(rng);
+    }
+    
+    std::string legacy_path = prefix + ".legacy.csv";
+    std::string csv_path = prefix + ".csv";
+    std::string csv_mt_path = prefix + ".mt.csv";
+    std::string store_path = prefix + ".fstore";
+    std::string raw_path = prefix + ".raw";
+    
+    printf("%lu rows x %d dims, %d threads%s\n\n", (unsigned long)count, dims, threads, sync ? ", fsync included" : "");
+    printf("%-24s %10s %10s %12s %10s\n", "writer", "rows", "secs", "rows/s", "MB/s");
+    
+    WriteStats legacy;
+    if(legacy_rows > 0) {
+        legacy = run_legacy(legacy_path, rows, legacy_rows, sync);
+        print_stats("append_image_data_csv", legacy);
+    }
+    WriteStats csv = run_writer(csv_path, FEATURE_WRITER_CSV, rows, count, 1, sync);
+    print_stats("FeatureWriter csv", csv);
+    WriteStats csv_mt = run_writer(csv_mt_path, FEATURE_WRITER_CSV, rows, count, threads, sync);
+    char label[64];
+    snprintf(label, sizeof(label), "FeatureWriter csv x%d", threads);
+    print_stats(label, csv_mt);
+    WriteStats store = run_writer(store_path, FEATURE_WRITER_STORE, rows, count, threads, sync);
+    snprintf(label, sizeof(label), "FeatureWriter store x%d", threads);
+    print_stats(label, store);
+    WriteStats raw = run_raw(raw_path, csv.bytes, sync);
+    print_stats("raw fwrite (csv bytes)", raw);
+    
+    // Same bytes as the old writer, and the same file whatever the thread count
+    bool csv_ok = csv.rows == count && csv_mt.rows == count && csv.bytes == csv_mt.bytes &&
+                  same_prefix(csv_path, csv_mt_path, csv.bytes);
+    if(legacy_rows > 0) {
+        csv_ok = csv_ok && same_prefix(legacy_path, csv_path, legacy.bytes);
+        printf("\nFeatureWriter vs append_image_data_csv: %.1fx rows/s\n", (csv.rows / csv.secs) / (legacy.rows / legacy.secs));
+    }
+    printf("FeatureWriter csv at %.0f%% of raw fwrite throughput\n", 100.0 * (csv.bytes / csv.secs) / (raw.bytes / raw.secs));
+    printf("CSV output identical to the old writer and across threads: %s\n", csv_ok ? "yes" : "NO");
+    
+    // The store must load back as the rows that were submitted
+    FeatureStoreInfo info;
+    std::vector<float> data;
+    bool store_ok = read_feature_store_info(store_path.c_str(), info) == 0 && info.count == count &&
+                    info.dim == dims && load_feature_store(store_path.c_str(), info, data) == 0;
+    for(uint64_t i = 0; store_ok && i < count; i++) {
+        store_ok = memcmp(&data[i * dims], rows[i % rows.size()].data(), dims * sizeof(float)) == 0;
+    }
+    printf("Feature store reads back exactly: %s (%.1fx smaller than the CSV)\n", store_ok ? "yes" : "NO",
+           (double)csv.bytes / store.bytes);
+    
+    if(!keep) {
+        remove(legacy_path.c_str());
+        remove(csv_path.c_str());
+        remove(csv_mt_path.c_str());
+        remove(store_path.c_str());
+        remove(raw_path.c_str());
+    }
+    return csv_ok && store_ok ? 0 : -1;
+}
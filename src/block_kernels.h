@@ -0,0 +1,45 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the column-blocked (SoA) feature layout and its batched distance kernels
+*/
+
+#ifndef BLOCK_KERNELS_H
+#define BLOCK_KERNELS_H
+
+#include <cstddef>
+
+/*
+  Images per block. A block stores dimension 0 of its 16 images, then
+  dimension 1, and so on (dim x 16 floats), so one vector register holds the
+  same dimension of 8 or 16 images and every lane accumulates its own image's
+  distance: no horizontal reduction per image. Missing images in the last
+  block are zero padding.
+*/
+#define FEATURE_BLOCK 16
+
+/*
+  Transpose num_rows row-major vectors into ceil(num_rows / 16) blocks
+*/
+void transpose_to_blocks(const float *rows, size_t num_rows, int dim, float *blocks);
+
+/*
+  Copy image lane of a block back into a row-major vector
+*/
+void gather_block_row(const float *block, int dim, int lane, float *row);
+
+/*
+  Distances from the query to all 16 images of each block (num_blocks x 16 outputs)
+  Each lane adds its dimensions in the same order as the row-major functions,
+  so results are bit-identical to them:
+    ssd:          ssd_distance
+    intersection: histogram_intersection_distance (1 - sum of minima)
+    cosine:       1 - cosine similarity, 2 for zero vectors (the dnn method)
+*/
+typedef void (*BlockDistance)(const float *blocks, size_t num_blocks, int dim, const float *query, float *distances);
+
+void block_ssd_distances(const float *blocks, size_t num_blocks, int dim, const float *query, float *distances);
+void block_intersection_distances(const float *blocks, size_t num_blocks, int dim, const float *query, float *distances);
+void block_cosine_distances(const float *blocks, size_t num_blocks, int dim, const float *query, float *distances);
+
+#endif
@@ -0,0 +1,132 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Build an ORB bag-of-visual-words index: extract descriptors, train a binary vocabulary
+           with k-majority clustering, and store every image as a TF-IDF vector with an inverted file
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "bow_index.h"
+#include "image_source.h"
+
+int main(int argc, char *argv[]) {
+    if(argc < 3) {
+        printf("Usage: %s <image_directory|pack> <index_file> [--words K] [--features F] [--sample S] [--iterations I]\n", argv[0]);
+        printf("  --words: vocabulary size (default 1000)\n");
+        printf("  --features: ORB keypoints per image (default 500)\n");
+        printf("  --sample: descriptors used to train the vocabulary (default 200000)\n");
+        printf("  --iterations: k-majority iterations (default 10)\n");
+        printf("  --readahead: image reads kept in flight (default 16)\n");
+        printf("Example: ./bow_build src/olympus olympus.bow --words 2000\n");
+        return -1;
+    }
+    
+    const char *directory = argv[1];
+    const char *index_file = argv[2];
+    int num_words = 1000;
+    int max_features = 500;
+    int sample_size = 200000;
+    int iterations = 10;
+    int readahead = 16;
+    for(int i = 3; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--words") == 0) num_words = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--features") == 0) max_features = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--sample") == 0) sample_size = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--iterations") == 0) iterations = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--readahead") == 0) readahead = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(num_words <= 0 || max_features <= 0 || sample_size <= 0) {
+        printf("Error: words, features and sample must be > 0\n");
+        return -1;
+    }
+    
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    
+    // Pass over the images: ORB descriptors of each one
+    auto start = std::chrono::steady_clock::now();
+    ImageReadAhead reader;
+    start_source_read_ahead(source, std::vector<int>(), readahead, 4, reader);
+    
+    BowIndex index;
+    index.num_words = num_words;
+    index.max_features = max_features;
+    std::vector<cv::Mat> descriptors;
+    size_t total_descriptors = 0;
+    int i;
+    cv::Mat img;
+    while(next_source_image(reader, i, img)) {
+        if(img.empty()) continue;
+        cv::Mat desc;
+        extract_orb_descriptors(img, max_features, desc);
+        index.filenames.push_back(source.names[i]);
+        descriptors.push_back(desc);
+        total_descriptors += desc.rows;
+    }
+    if(total_descriptors == 0) {
+        printf("Error: No ORB descriptors found in %s\n", directory);
+        return -1;
+    }
+    double extract_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Extracted %lu descriptors from %lu images in %.2f s\n", total_descriptors, index.filenames.size(), extract_secs);
+    
+    // Vocabulary from a random sample of all descriptors (fixed seed)
+    std::vector<std::pair<int, int>> all;
+    all.reserve(total_descriptors);
+    for(int img_idx = 0; img_idx < (int)descriptors.size(); img_idx++) {
+        for(int r = 0; r < descriptors[img_idx].rows; r++) all.push_back({img_idx, r});
+    }
+    std::mt19937 rng(42);
+    std::shuffle(all.begin(), all.end(), rng);
+    all.resize(std::min(all.size(), (size_t)sample_size));
+    
+    cv::Mat sample((int)all.size(), ORB_DESCRIPTOR_BYTES, CV_8U);
+    for(size_t s = 0; s < all.size(); s++) {
+        descriptors[all[s].first].row(all[s].second).copyTo(sample.row((int)s));
+    }
+    
+    start = std::chrono::steady_clock::now();
+    if(train_binary_vocabulary(sample, num_words, iterations, index.words) != 0) {
+        printf("Error: Could not train the vocabulary\n");
+        return -1;
+    }
+    double train_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Trained %d words on %d descriptors in %.2f s\n", num_words, sample.rows, train_secs);
+    
+    // Quantize every image and build the TF-IDF vectors and inverted file
+    std::vector<std::vector<int>> image_words(descriptors.size());
+    cv::parallel_for_(cv::Range(0, (int)descriptors.size()), [&](const cv::Range &range) {
+        for(int k = range.start; k < range.end; k++) {
+            quantize_descriptors(index.words, num_words, descriptors[k], image_words[k]);
+        }
+    });
+    build_bow_index(image_words, index);
+    
+    long long postings = 0;
+    int used_words = 0;
+    for(const std::vector<Posting> &list : index.inverted.lists) {
+        postings += list.size();
+        if(!list.empty()) used_words++;
+    }
+    if(write_bow_index(index_file, index) != 0) {
+        return -1;
+    }
+    printf("Wrote %s: %lu images, %d of %d words in use, %.1f words per image, %lld postings\n", index_file,
+           index.filenames.size(), used_words, num_words, (double)postings / index.filenames.size(), postings);
+    
+    return 0;
+}
@@ -0,0 +1,354 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of ORB extraction, k-majority vocabulary training, TF-IDF and inverted-file scoring
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include "bow_index.h"
+
+static const char BOW_MAGIC[4] = {'B', 'O', 'W', 'I'};
+
+int extract_orb_descriptors(const cv::Mat &src, int max_features, cv::Mat &descriptors) {
+    descriptors.release();
+    if(src.empty()) return -1;
+    
+    cv::Mat gray;
+    if(src.channels() == 3) cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    else gray = src;
+    
+    static thread_local cv::Ptr<cv::ORB> orb;
+    static thread_local int orb_features = 0;
+    if(orb.empty() || orb_features != max_features) {
+        orb = cv::ORB::create(max_features);
+        orb_features = max_features;
+    }
+    std::vector<cv::KeyPoint> keypoints;
+    orb->detectAndCompute(gray, cv::noArray(), keypoints, descriptors);
+    return 0;
+}
+
+/*
+  Hamming distance between two 256-bit descriptors
+*/
+static inline int hamming_256(const unsigned char *a, const unsigned char *b) {
+    int distance = 0;
+    for(int i = 0; i < ORB_DESCRIPTOR_BYTES; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        distance += __builtin_popcountll(x ^ y);
+    }
+    return distance;
+}
+
+static int nearest_word(const unsigned char *words, int num_words, const unsigned char *desc) {
+    int best = 0;
+    int best_distance = INT32_MAX;
+    for(int w = 0; w < num_words; w++) {
+        int d = hamming_256(desc, words + (size_t)w * ORB_DESCRIPTOR_BYTES);
+        if(d < best_distance) {
+            best_distance = d;
+            best = w;
+        }
+    }
+    return best;
+}
+
+int train_binary_vocabulary(const cv::Mat &descriptors, int num_words, int iterations,
+                            std::vector<unsigned char> &words) {
+    int n = descriptors.rows;
+    if(n == 0 || num_words <= 0 || descriptors.cols != ORB_DESCRIPTOR_BYTES) {
+        return -1;
+    }
+    
+    // Fixed seed so the same descriptors always give the same vocabulary
+    std::mt19937 rng(1234);
+    
+    // k-means++ seeding: each new word is a descriptor drawn with probability
+    // proportional to its squared Hamming distance from the nearest word so far
+    words.assign((size_t)num_words * ORB_DESCRIPTOR_BYTES, 0);
+    std::vector<double> nearest(n, std::numeric_limits<double>::max());
+    int pick = rng() % n;
+    for(int w = 0; w < num_words; w++) {
+        unsigned char *word = &words[(size_t)w * ORB_DESCRIPTOR_BYTES];
+        memcpy(word, descriptors.ptr<unsigned char>(pick), ORB_DESCRIPTOR_BYTES);
+        if(w + 1 == num_words) break;
+        
+        double total = 0.0;
+        for(int i = 0; i < n; i++) {
+            double d = hamming_256(word, descriptors.ptr<unsigned char>(i));
+            nearest[i] = std::min(nearest[i], d * d);
+            total += nearest[i];
+        }
+        if(total == 0.0) {
+            // Fewer distinct descriptors than words: repeat random ones
+            pick = rng() % n;
+            continue;
+        }
+        double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+        for(pick = 0; pick < n - 1; pick++) {
+            r -= nearest[pick];
+            if(r < 0.0) break;
+        }
+    }
+    
+    std::vector<int> assign(n, -1);
+    std::vector<int> votes((size_t)num_words * ORB_DESCRIPTOR_BYTES * 8);
+    std::vector<int> sizes(num_words);
+    for(int it = 0; it < iterations; it++) {
+        // Assignment step, split across OpenCV's thread pool
+        std::vector<int> previous = assign;
+        cv::parallel_for_(cv::Range(0, n), [&](const cv::Range &range) {
+            for(int i = range.start; i < range.end; i++) {
+                assign[i] = nearest_word(words.data(), num_words, descriptors.ptr<unsigned char>(i));
+            }
+        });
+        if(assign == previous) break;
+        
+        // Majority vote of every bit over each word's descriptors
+        std::fill(votes.begin(), votes.end(), 0);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for(int i = 0; i < n; i++) {
+            const unsigned char *desc = descriptors.ptr<unsigned char>(i);
+            int *v = &votes[(size_t)assign[i] * ORB_DESCRIPTOR_BYTES * 8];
+            for(int bit = 0; bit < ORB_DESCRIPTOR_BYTES * 8; bit++) {
+                v[bit] += (desc[bit >> 3] >> (bit & 7)) & 1;
+            }
+            sizes[assign[i]]++;
+        }
+        for(int w = 0; w < num_words; w++) {
+            unsigned char *word = &words[(size_t)w * ORB_DESCRIPTOR_BYTES];
+            if(sizes[w] == 0) {
+                // Empty word: restart it on a random descriptor
+                memcpy(word, descriptors.ptr<unsigned char>(rng() % n), ORB_DESCRIPTOR_BYTES);
+                continue;
+            }
+            const int *v = &votes[(size_t)w * ORB_DESCRIPTOR_BYTES * 8];
+            for(int bit = 0; bit < ORB_DESCRIPTOR_BYTES * 8; bit++) {
+                // Ties keep the current bit
+                if(2 * v[bit] > sizes[w]) word[bit >> 3] |= (unsigned char)(1 << (bit & 7));
+                else if(2 * v[bit] < sizes[w]) word[bit >> 3] &= (unsigned char)~(1 << (bit & 7));
+            }
+        }
+    }
+    
+    return 0;
+}
+
+void quantize_descriptors(const std::vector<unsigned char> &words, int num_words, const cv::Mat &descriptors,
+                          std::vector<int> &word_ids) {
+    word_ids.resize(descriptors.rows);
+    for(int i = 0; i < descriptors.rows; i++) {
+        word_ids[i] = nearest_word(words.data(), num_words, descriptors.ptr<unsigned char>(i));
+    }
+}
+
+void bow_vector(const BowIndex &index, const std::vector<int> &word_ids, SparseHist &vec) {
+    vec.bins.clear();
+    vec.weights.clear();
+    if(word_ids.empty()) return;
+    
+    std::vector<int> sorted(word_ids);
+    std::sort(sorted.begin(), sorted.end());
+    
+    // Term frequency x idf for every distinct word, in word order
+    float norm = 0.0f;
+    for(size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while(j < sorted.size() && sorted[j] == sorted[i]) j++;
+        float w = (float)(j - i) / sorted.size() * index.idf[sorted[i]];
+        if(w > 0.0f) {
+            vec.bins.push_back(sorted[i]);
+            vec.weights.push_back(w);
+            norm += w * w;
+        }
+        i = j;
+    }
+    
+    if(norm > 0.0f) {
+        float scale = 1.0f / std::sqrt(norm);
+        for(float &w : vec.weights) w *= scale;
+    }
+}
+
+void build_bow_index(const std::vector<std::vector<int>> &image_words, BowIndex &index) {
+    int n = image_words.size();
+    
+    // Document frequency: images containing each word
+    std::vector<int> df(index.num_words, 0);
+    std::vector<int> seen(index.num_words, -1);
+    for(int img = 0; img < n; img++) {
+        for(int w : image_words[img]) {
+            if(seen[w] != img) {
+                seen[w] = img;
+                df[w]++;
+            }
+        }
+    }
+    index.idf.assign(index.num_words, 0.0f);
+    for(int w = 0; w < index.num_words; w++) {
+        if(df[w] > 0) index.idf[w] = std::log((float)n / df[w]);
+    }
+    
+    index.vectors.resize(n);
+    for(int img = 0; img < n; img++) {
+        bow_vector(index, image_words[img], index.vectors[img]);
+    }
+    build_inverted_index(index.vectors, index.num_words, index.inverted);
+}
+
+long long bow_distances(const BowIndex &index, const SparseHist &query, std::vector<std::pair<float, int>> &touched) {
+    // Scores only for the images the postings reach, slot[image] -> position in touched
+    std::unordered_map<int, int> slot;
+    touched.clear();
+    long long visited = 0;
+    for(size_t i = 0; i < query.bins.size(); i++) {
+        float qw = query.weights[i];
+        const std::vector<Posting> &list = index.inverted.lists[query.bins[i]];
+        for(const Posting &p : list) {
+            auto it = slot.emplace(p.image, (int)touched.size());
+            if(it.second) touched.push_back({0.0f, p.image});
+            touched[it.first->second].first += qw * p.weight;
+        }
+        visited += list.size();
+    }
+    
+    for(std::pair<float, int> &t : touched) t.first = 1.0f - t.first;
+    return visited;
+}
+
+long long bow_top_k(const BowIndex &index, const SparseHist &query, int k, int skip,
+                    std::vector<std::pair<float, int>> &results) {
+    long long visited = bow_distances(index, query, results);
+    results.erase(std::remove_if(results.begin(), results.end(),
+                                 [skip](const std::pair<float, int> &r) { return r.second == skip; }),
+                  results.end());
+    
+    int keep = std::max(0, std::min(k, (int)results.size()));
+    std::partial_sort(results.begin(), results.begin() + keep, results.end());
+    results.resize(keep);
+    
+    // Too few images share a word: the rest tie at distance 1
+    if(keep < k) {
+        std::unordered_set<int> taken;
+        for(const std::pair<float, int> &r : results) taken.insert(r.second);
+        for(int i = 0; i < (int)index.filenames.size() && (int)results.size() < k; i++) {
+            if(i != skip && taken.count(i) == 0) results.push_back({1.0f, i});
+        }
+    }
+    return visited;
+}
+
+float bow_distance(const SparseHist &a, const SparseHist &b) {
+    float dot = 0.0f;
+    size_t i = 0, j = 0;
+    while(i < a.bins.size() && j < b.bins.size()) {
+        if(a.bins[i] < b.bins[j]) i++;
+        else if(a.bins[i] > b.bins[j]) j++;
+        else {
+            dot += a.weights[i] * b.weights[j];
+            i++;
+            j++;
+        }
+    }
+    return 1.0f - dot;
+}
+
+/*
+  Layout: "BOWI", int num_words, int images, int ORB features, the vocabulary, idf, then per image:
+  int name length, name, int nonzero words, word ids, weights
+*/
+int write_bow_index(const char *filename, const BowIndex &index) {
+    FILE *fp = fopen(filename, "wb");
+    if(!fp) {
+        printf("Unable to open output file %s\n", filename);
+        return -1;
+    }
+    
+    int header[3] = {index.num_words, (int)index.filenames.size(), index.max_features};
+    fwrite(BOW_MAGIC, sizeof(char), 4, fp);
+    fwrite(header, sizeof(int), 3, fp);
+    fwrite(index.words.data(), sizeof(unsigned char), index.words.size(), fp);
+    fwrite(index.idf.data(), sizeof(float), index.idf.size(), fp);
+    
+    for(size_t i = 0; i < index.filenames.size(); i++) {
+        int len = index.filenames[i].size();
+        fwrite(&len, sizeof(int), 1, fp);
+        fwrite(index.filenames[i].data(), sizeof(char), len, fp);
+        int nnz = index.vectors[i].bins.size();
+        fwrite(&nnz, sizeof(int), 1, fp);
+        if(nnz > 0) {
+            fwrite(index.vectors[i].bins.data(), sizeof(int), nnz, fp);
+            fwrite(index.vectors[i].weights.data(), sizeof(float), nnz, fp);
+        }
+    }
+    
+    bool ok = !ferror(fp);
+    fclose(fp);
+    if(!ok) {
+        printf("Error: Failed to write %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+int read_bow_index(const char *filename, BowIndex &index) {
+    FILE *fp = fopen(filename, "rb");
+    if(!fp) {
+        printf("Unable to open BoW index %s\n", filename);
+        return -1;
+    }
+    
+    char magic[4];
+    int header[3];
+    if(fread(magic, sizeof(char), 4, fp) != 4 || memcmp(magic, BOW_MAGIC, 4) != 0 ||
+       fread(header, sizeof(int), 3, fp) != 3 || header[0] <= 0 || header[1] < 0) {
+        printf("%s is not a BoW index\n", filename);
+        fclose(fp);
+        return -1;
+    }
+    
+    index.num_words = header[0];
+    int count = header[1];
+    index.max_features = header[2];
+    index.words.resize((size_t)index.num_words * ORB_DESCRIPTOR_BYTES);
+    index.idf.resize(index.num_words);
+    bool ok = fread(index.words.data(), sizeof(unsigned char), index.words.size(), fp) == index.words.size() &&
+              fread(index.idf.data(), sizeof(float), index.idf.size(), fp) == index.idf.size();
+    
+    index.filenames.clear();
+    index.vectors.assign(count, SparseHist());
+    for(int i = 0; ok && i < count; i++) {
+        int len = 0, nnz = 0;
+        ok = fread(&len, sizeof(int), 1, fp) == 1 && len >= 0;
+        if(!ok) break;
+        std::string name(len, '\0');
+        ok = fread(&name[0], sizeof(char), len, fp) == (size_t)len &&
+             fread(&nnz, sizeof(int), 1, fp) == 1 && nnz >= 0 && nnz <= index.num_words;
+        if(!ok) break;
+        index.filenames.push_back(name);
+        SparseHist &v = index.vectors[i];
+        v.bins.resize(nnz);
+        v.weights.resize(nnz);
+        ok = nnz == 0 || (fread(v.bins.data(), sizeof(int), nnz, fp) == (size_t)nnz &&
+                          fread(v.weights.data(), sizeof(float), nnz, fp) == (size_t)nnz);
+        for(int b : v.bins) ok = ok && b >= 0 && b < index.num_words;
+    }
+    fclose(fp);
+    
+    if(!ok) {
+        printf("Error: %s is truncated or corrupt\n", filename);
+        return -1;
+    }
+    build_inverted_index(index.vectors, index.num_words, index.inverted);
+    return 0;
+}
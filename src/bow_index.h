@@ -0,0 +1,97 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the ORB bag-of-visual-words index (binary vocabulary, TF-IDF, inverted file)
+*/
+
+#ifndef BOW_INDEX_H
+#define BOW_INDEX_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <opencv2/opencv.hpp>
+#include "sparse_hist.h"
+
+// ORB descriptors are 256 bits
+#define ORB_DESCRIPTOR_BYTES 32
+
+/*
+  Bag-of-visual-words index
+  Every image is a sparse, L2-normalized TF-IDF vector over the visual words
+  (SparseHist bins = word ids), and the inverted file lists, for every word,
+  the images that contain it with their TF-IDF weight.
+*/
+struct BowIndex {
+    int num_words = 0;
+    int max_features = 500;                 // ORB keypoints per image, queries use the same
+    std::vector<unsigned char> words;       // num_words x ORB_DESCRIPTOR_BYTES, the vocabulary
+    std::vector<float> idf;                 // log(images / images containing the word), 0 if none
+    std::vector<std::string> filenames;
+    std::vector<SparseHist> vectors;        // one TF-IDF vector per image
+    InvertedIndex inverted;                 // built from vectors (not stored in the file)
+};
+
+/*
+  ORB keypoints and descriptors of an image (up to max_features)
+  descriptors: one CV_8U row of ORB_DESCRIPTOR_BYTES per keypoint, empty if none
+*/
+int extract_orb_descriptors(const cv::Mat &src, int max_features, cv::Mat &descriptors);
+
+/*
+  Binary vocabulary by k-majority clustering: like k-means, but every
+  descriptor goes to the word at the smallest Hamming distance and each word
+  becomes the bitwise majority vote of its descriptors (k-means++ seeding)
+  Returns 0 on success, -1 if there are no descriptors
+*/
+int train_binary_vocabulary(const cv::Mat &descriptors, int num_words, int iterations,
+                            std::vector<unsigned char> &words);
+
+/*
+  Word id (nearest vocabulary word by Hamming distance) of every descriptor
+*/
+void quantize_descriptors(const std::vector<unsigned char> &words, int num_words, const cv::Mat &descriptors,
+                          std::vector<int> &word_ids);
+
+/*
+  Fill idf, vectors and the inverted file from every image's word ids
+*/
+void build_bow_index(const std::vector<std::vector<int>> &image_words, BowIndex &index);
+
+/*
+  TF-IDF vector of one image's word ids under the index's idf, L2-normalized
+*/
+void bow_vector(const BowIndex &index, const std::vector<int> &word_ids, SparseHist &vec);
+
+/*
+  Distance (1 - cosine similarity) from the query vector to the images that
+  share a word with it, accumulated over the posting lists of the query's
+  words only: the work is the total length of those lists, not the number
+  of images. touched holds one (distance, image) pair per such image, in
+  no particular order; every other image is at distance 1.
+  Returns the number of postings visited
+*/
+long long bow_distances(const BowIndex &index, const SparseHist &query, std::vector<std::pair<float, int>> &touched);
+
+/*
+  Top k (distance, image) pairs for the query, best first, leaving out image
+  skip (-1 for none): the touched images, padded with images at distance 1
+  in index order only when fewer than k share a word with the query
+  Returns the number of postings visited
+*/
+long long bow_top_k(const BowIndex &index, const SparseHist &query, int k, int skip,
+                    std::vector<std::pair<float, int>> &results);
+
+/*
+  The same distance from a sorted merge of two vectors (for checking the inverted file)
+*/
+float bow_distance(const SparseHist &a, const SparseHist &b);
+
+/*
+  Write / read a BoW index file (vocabulary, idf, filenames and vectors)
+  read_bow_index rebuilds the inverted file
+*/
+int write_bow_index(const char *filename, const BowIndex &index);
+int read_bow_index(const char *filename, BowIndex &index);
+
+#endif
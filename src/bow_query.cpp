@@ -0,0 +1,132 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Query an ORB bag-of-visual-words index through its inverted file, optionally checked against a full scan
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "bow_index.h"
+
+/*
+  Time one scoring function, in milliseconds per query
+*/
+template <typename ScoreFn>
+static double time_ms(ScoreFn score, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < repeats; r++) {
+        score();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 4) {
+        printf("Usage: %s <index_file> <target> <N> [--check R]\n", argv[0]);
+        printf("  target: an image file (ORB features are extracted from it), or the name of an indexed image\n");
+        printf("  --check: compare every distance with a full scan and time both paths over R runs\n");
+        printf("Example: ./bow_query olympus.bow pic.0164.jpg 5\n");
+        printf("         ./bow_query olympus.bow crop_of_pic.0164.jpg 5 --check 20\n");
+        return -1;
+    }
+    
+    const char *index_file = argv[1];
+    const char *target = argv[2];
+    int N = atoi(argv[3]);
+    int repeats = 0;
+    for(int i = 4; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--check") == 0) repeats = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(N <= 0) {
+        printf("Error: N must be > 0\n");
+        return -1;
+    }
+    
+    BowIndex index;
+    if(read_bow_index(index_file, index) != 0) {
+        return -1;
+    }
+    
+    // Query vector: quantize the target image, or reuse the stored vector of an indexed name
+    SparseHist query;
+    int target_idx = -1;
+    auto start = std::chrono::steady_clock::now();
+    cv::Mat img = cv::imread(target);
+    if(!img.empty()) {
+        cv::Mat desc;
+        std::vector<int> word_ids;
+        extract_orb_descriptors(img, index.max_features, desc);
+        quantize_descriptors(index.words, index.num_words, desc, word_ids);
+        bow_vector(index, word_ids, query);
+    } else {
+        for(int i = 0; i < (int)index.filenames.size(); i++) {
+            if(index.filenames[i] == target) target_idx = i;
+        }
+        if(target_idx < 0) {
+            printf("Error: %s is neither a readable image nor a name in %s\n", target, index_file);
+            return -1;
+        }
+        query = index.vectors[target_idx];
+    }
+    double extract_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    // Inverted-file scoring and top K over the images the postings reach
+    std::vector<std::pair<float, int>> matches;
+    long long visited = bow_top_k(index, query, N, target_idx, matches);
+    int n = index.filenames.size();
+    int k = matches.size();
+    
+    long long total_postings = 0;
+    for(const std::vector<Posting> &list : index.inverted.lists) total_postings += list.size();
+    
+    printf("Target image: %s (%lu distinct words)\n", target, query.bins.size());
+    printf("Postings visited: %lld of %lld (%.1f%%)\n", visited, total_postings,
+           total_postings > 0 ? 100.0 * visited / total_postings : 0.0);
+    
+    printf("\nTop %d matches:\n", k);
+    for(int i = 0; i < k; i++) {
+        printf("%d. %s (distance: %.6f)\n", i + 1, index.filenames[matches[i].second].c_str(), matches[i].first);
+    }
+    
+    if(repeats <= 0) {
+        printf("\nQuery time: ORB + quantize %.3f ms\n", extract_ms);
+        return 0;
+    }
+    
+    // The inverted file must agree with a scan of every vector, and should beat it
+    std::vector<std::pair<float, int>> touched;
+    bow_distances(index, query, touched);
+    std::vector<float> distances(n, 1.0f);
+    for(const std::pair<float, int> &t : touched) distances[t.second] = t.first;
+    int mismatches = 0;
+    for(int i = 0; i < n; i++) {
+        if(bow_distance(query, index.vectors[i]) != distances[i]) mismatches++;
+    }
+    std::vector<std::pair<float, int>> scratch;
+    double scan_ms = time_ms([&]() {
+        scratch.clear();
+        for(int i = 0; i < n; i++) {
+            if(i != target_idx) scratch.push_back({bow_distance(query, index.vectors[i]), i});
+        }
+        std::partial_sort(scratch.begin(), scratch.begin() + std::min(N, (int)scratch.size()), scratch.end());
+    }, repeats);
+    double inverted_ms = time_ms([&]() {
+        bow_top_k(index, query, N, target_idx, scratch);
+    }, repeats);
+    
+    printf("\nExact match with full scan: %s (%d differing distances)\n", mismatches == 0 ? "yes" : "NO", mismatches);
+    printf("Query time over %d runs: ORB + quantize %.3f ms, full scan %.3f ms, inverted file %.3f ms (%.1fx)\n",
+           repeats, extract_ms, scan_ms, inverted_ms, scan_ms / inverted_ms);
+    
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Build a per-cell RGB or HSV histogram index of an image directory for region queries
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "features.h"
+#include "cell_index.h"
+#include "image_source.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 3) {
+        printf("Usage: %s <image_directory|pack> <index_file> [rgb|hsv] [grid]\n", argv[0]);
+        printf("Example: ./build_cell_index src/olympus olympus_rgb.cidx rgb 8x8\n");
+        return -1;
+    }
+    
+    char *directory = argv[1];
+    char *index_file = argv[2];
+    const char *space = (argc >= 4) ? argv[3] : "rgb";
+    const char *grid = (argc >= 5) ? argv[4] : "8x8";
+    
+    bool use_hsv = false;
+    if(strcmp(space, "hsv") == 0) use_hsv = true;
+    else if(strcmp(space, "rgb") != 0) {
+        printf("Error: color space must be 'rgb' or 'hsv'\n");
+        return -1;
+    }
+    
+    int grid_rows = 0, grid_cols = 0;
+    if(sscanf(grid, "%dx%d", &grid_rows, &grid_cols) != 2 || grid_rows <= 0 || grid_cols <= 0) {
+        printf("Error: Invalid grid %s (expected e.g. 8x8)\n", grid);
+        return -1;
+    }
+    int bins = use_hsv ? 128 : 512;
+    
+    // Open the image directory or pack file
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    
+    // Loop through all images in the source
+    int count = 0;
+    for(int i = 0; i < source.count(); i++) {
+        // Read image
+        cv::Mat img = read_source_image(source, i);
+        if(img.empty()) {
+            continue;
+        }
+        
+        // Per-cell histogram counts
+        std::vector<int> counts, cell_pixels;
+        if(use_hsv) {
+            cell_histogram_counts_hsv(img, grid_rows, grid_cols, counts, cell_pixels);
+        } else {
+            cell_histogram_counts(img, grid_rows, grid_cols, counts, cell_pixels);
+        }
+        
+        // First image resets the index file
+        if(append_cell_index(index_file, source.names[i].c_str(), grid_rows, grid_cols, bins, counts, count == 0) != 0) {
+            return -1;
+        }
+        count++;
+    }
+    
+    printf("Indexed %d images into %s (%s, %dx%d cells)\n", count, index_file, space, grid_rows, grid_cols);
+    
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Compute one feature method for every image in a directory and store it in a CSV feature file
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "features.h"
+#include "feature_writer.h"
+#include "image_source.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <image_directory|pack> <method> <output_csv> [--readahead depth] [--io-threads T] [--parallel-pixels P]\n", argv[0]);
+        printf("       [--threads T] [--store]\n");
+        printf("  method: baseline, rgb, hsv, multi, pyramid, color_texture, laws, gabor\n");
+        printf("  --readahead: image reads kept in flight ahead of the extractor (default 16)\n");
+        printf("  --io-threads: pread threads when io_uring is not available (default 4)\n");
+        printf("  --parallel-pixels: split images of at least P pixels into row stripes across cores (default %lld, 0 = never)\n",
+               parallel_extraction_pixels());
+        printf("  --threads: images extracted at once; rows are still written in image order (default 1)\n");
+        printf("  --store: write a binary feature store (for stream_query) instead of CSV\n");
+        printf("Example: ./build_features src/olympus multi olympus_multi.csv\n");
+        return -1;
+    }
+    
+    char *directory = argv[1];
+    char *method = argv[2];
+    char *output_csv = argv[3];
+    int readahead = 16;
+    int io_threads = 4;
+    int threads = 1;
+    int format = FEATURE_WRITER_CSV;
+    
+    for(int i = 4; i < argc; i++) {
+        if(strcmp(argv[i], "--store") == 0) format = FEATURE_WRITER_STORE;
+        else if(i + 1 < argc && strcmp(argv[i], "--readahead") == 0) readahead = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--io-threads") == 0) io_threads = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--parallel-pixels") == 0) set_parallel_extraction_pixels(atoll(argv[++i]));
+        else if(i + 1 < argc && strcmp(argv[i], "--threads") == 0) threads = std::max(1, atoi(argv[++i]));
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    // Open the image directory or pack file
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    
+    FeatureWriter writer;
+    if(writer.open(output_csv, format) != 0) {
+        return -1;
+    }
+    
+    // Loop through all images in the source, reading ahead of the extractors
+    ImageReadAhead reader;
+    start_source_read_ahead(source, std::vector<int>(), readahead, io_threads, reader);
+    
+    // Each extractor takes the next decoded image and its row number; the
+    // writer puts rows back in that order
+    std::mutex source_mutex;
+    uint64_t next_row = 0;
+    bool failed = false;
+    auto extractor = [&]() {
+        for(;;) {
+            int i;
+            cv::Mat img;
+            uint64_t row;
+            {
+                std::lock_guard<std::mutex> lock(source_mutex);
+                do {
+                    if(failed || !next_source_image(reader, i, img)) return;
+                } while(img.empty());
+                row = next_row++;
+            }
+            
+            // Extract features for the chosen method
+            std::vector<float> features;
+            if(extract_feature(method, img, features) != 0) {
+                writer.skip(row);
+                std::lock_guard<std::mutex> lock(source_mutex);
+                failed = true;
+                return;
+            }
+            writer.submit(row, source.names[i], features);
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int t = 1; t < threads; t++) workers.emplace_back(extractor);
+    extractor();
+    for(std::thread &w : workers) w.join();
+    
+    if(failed) {
+        printf("Error: Unknown method %s\n", method);
+        return -1;
+    }
+    int64_t count = writer.close();
+    if(count < 0) {
+        return -1;
+    }
+    
+    printf("Wrote %ld feature vectors (%s) to %s\n", (long)count, method, output_csv);
+    
+    return 0;
+}
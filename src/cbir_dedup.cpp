@@ -0,0 +1,187 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Near-duplicate detection over color histograms using LSH candidates and exact verification
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "csv_util.h"
+#include "sparse_hist.h"
+#include "lsh.h"
+
+/*
+  Union-find over image ids (path halving, union by size)
+*/
+struct DisjointSets {
+    std::vector<int> parent;
+    std::vector<int> size;
+    
+    DisjointSets(int n) : parent(n), size(n, 1) {
+        for(int i = 0; i < n; i++) parent[i] = i;
+    }
+    
+    int find(int x) {
+        while(parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if(a == b) return;
+        if(size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+    }
+};
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 3) {
+        printf("Usage: %s <features_csv> <threshold> [options]\n", argv[0]);
+        printf("  <features_csv>  normalized histograms from build_features (rgb or hsv)\n");
+        printf("  <threshold>     pairs with intersection distance <= threshold are duplicates\n");
+        printf("  --tables L      number of hash tables (default 20)\n");
+        printf("  --hashes k      projections per table (default 8)\n");
+        printf("  --width w       bucket width (default 16 x threshold)\n");
+        printf("  --max-bucket m  buckets of more than m images pair each image with m - 1 others\n");
+        printf("                  in a shuffled order instead of all pairs (default 64, 0 = no cap)\n");
+        printf("  --recall        also run the O(N^2) exact search and report pair recall\n");
+        printf("Example: ./cbir_dedup olympus_rgb.csv 0.1 --recall\n");
+        return -1;
+    }
+    
+    char *features_csv = argv[1];
+    float threshold = atof(argv[2]);
+    LSHParams params;
+    params.bucket_width = 0.0f;
+    bool check_recall = false;
+    
+    for(int i = 3; i < argc; i++) {
+        if(strcmp(argv[i], "--recall") == 0) check_recall = true;
+        else if(strcmp(argv[i], "--tables") == 0 && i + 1 < argc) params.num_tables = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--hashes") == 0 && i + 1 < argc) params.hashes_per_table = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--width") == 0 && i + 1 < argc) params.bucket_width = atof(argv[++i]);
+        else if(strcmp(argv[i], "--max-bucket") == 0 && i + 1 < argc) params.max_bucket = atoi(argv[++i]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(threshold <= 0.0f || params.num_tables <= 0 || params.hashes_per_table <= 0 || params.max_bucket < 0) {
+        printf("Error: threshold, tables and hashes must be > 0 (and max-bucket >= 0)\n");
+        return -1;
+    }
+    // Duplicates are within L1 = 2 x threshold; a bucket several times wider keeps them together
+    if(params.bucket_width <= 0.0f) {
+        params.bucket_width = 16.0f * threshold;
+    }
+    
+    // Load histograms and keep them sparse (hashing and verification only touch occupied bins)
+    std::vector<char *> filenames;
+    std::vector<std::vector<float>> data;
+    if(read_image_data_csv(features_csv, filenames, data, 0) != 0 || data.empty()) {
+        printf("Error: No features in %s\n", features_csv);
+        return -1;
+    }
+    int num_images = data.size();
+    int dim = data[0].size();
+    
+    std::vector<SparseHist> hists(num_images);
+    for(int i = 0; i < num_images; i++) {
+        to_sparse_hist(data[i], hists[i]);
+    }
+    data.clear();
+    data.shrink_to_fit();
+    
+    // Hash every image into every table
+    auto start = std::chrono::steady_clock::now();
+    LSHIndex index;
+    lsh_init(index, dim, params);
+    for(int i = 0; i < num_images; i++) {
+        lsh_insert(index, i, hists[i]);
+    }
+    double hash_ms = elapsed_ms(start);
+    
+    // Candidate pairs from shared buckets, each verified exactly as it comes
+    start = std::chrono::steady_clock::now();
+    size_t candidates = 0;
+    std::vector<uint64_t> duplicates;
+    size_t capped = lsh_candidate_pairs(index, [&](int a, int b) {
+        candidates++;
+        if(sparse_intersection_distance(hists[a], hists[b]) <= threshold) {
+            duplicates.push_back(((uint64_t)a << 32) | b);
+        }
+    });
+    double verify_ms = elapsed_ms(start);
+    
+    // Group duplicate pairs into clusters
+    DisjointSets sets(num_images);
+    for(uint64_t pair : duplicates) {
+        sets.unite(pair >> 32, pair & 0xffffffffULL);
+    }
+    std::vector<std::vector<int>> members(num_images);
+    for(int i = 0; i < num_images; i++) {
+        members[sets.find(i)].push_back(i);
+    }
+    std::vector<std::vector<int>> clusters;
+    for(auto &m : members) {
+        if(m.size() >= 2) clusters.push_back(m);
+    }
+    std::sort(clusters.begin(), clusters.end(), [](const std::vector<int> &a, const std::vector<int> &b) {
+        return a.size() > b.size();
+    });
+    
+    printf("Images: %d, bins: %d, threshold: %.4f\n", num_images, dim, threshold);
+    printf("LSH: %d tables x %d hashes, bucket width %.4f\n", params.num_tables, params.hashes_per_table, params.bucket_width);
+    if(params.max_bucket > 0) {
+        printf("Buckets over %d images sub-sampled: %lu\n", params.max_bucket, capped);
+    }
+    
+    printf("\nDuplicate clusters: %lu\n", clusters.size());
+    for(size_t c = 0; c < clusters.size(); c++) {
+        printf("%lu. (%lu images)", c + 1, clusters[c].size());
+        for(int img : clusters[c]) {
+            printf(" %s", filenames[img]);
+        }
+        printf("\n");
+    }
+    
+    printf("\nCandidate pairs: %lu (%.4f%% of all pairs), verified duplicates: %lu\n",
+           candidates, 100.0 * candidates / ((double)num_images * (num_images - 1) / 2.0),
+           duplicates.size());
+    printf("Time: hashing %.1f ms, candidate pairs and verification %.1f ms\n", hash_ms, verify_ms);
+    
+    // Exhaustive comparison for recall
+    if(check_recall) {
+        start = std::chrono::steady_clock::now();
+        size_t true_pairs = 0;
+        for(int a = 0; a < num_images; a++) {
+            for(int b = a + 1; b < num_images; b++) {
+                if(sparse_intersection_distance(hists[a], hists[b]) <= threshold) {
+                    true_pairs++;
+                }
+            }
+        }
+        double brute_ms = elapsed_ms(start);
+        
+        // Every reported pair is verified exactly, so precision is 1 and recall is found / true
+        printf("\nBrute force: %lu duplicate pairs in %.1f ms\n", true_pairs, brute_ms);
+        printf("Pair recall: %.4f\n", true_pairs == 0 ? 1.0 : (double)duplicates.size() / true_pairs);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Retrieval quality and latency evaluation of every method against a ground-truth query set
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <sys/stat.h>
+#include "ground_truth.h"
+#include "retrieval_engine.h"
+
+// Quality, speed and size of one method
+struct MethodReport {
+    std::string name;
+    int images;
+    int dim;
+    int queries;
+    size_t index_bytes;
+    size_t file_bytes;
+    float precision;
+    float map;
+    double mean_ms;
+    double p99_ms;
+};
+
+/*
+  Split "a,b,c" into names
+*/
+static std::vector<std::string> split_list(const char *list) {
+    std::vector<std::string> items;
+    std::string current;
+    for(const char *p = list; ; p++) {
+        if(*p == ',' || *p == '\0') {
+            if(!current.empty()) items.push_back(current);
+            current.clear();
+            if(*p == '\0') break;
+        } else {
+            current += *p;
+        }
+    }
+    return items;
+}
+
+/*
+  Run every labeled query through the engine for one method
+  Latency is the top-k search; mAP is computed over the full ranking
+*/
+static int evaluate_method(const RetrievalMethod &method, const FeatureDatabase &db,
+                           const std::vector<GroundTruthQuery> &truth, int k, int repeat, MethodReport &report) {
+    std::vector<double> latencies;
+    report.precision = 0.0f;
+    report.map = 0.0f;
+    report.queries = 0;
+    
+    for(const GroundTruthQuery &gt : truth) {
+        auto it = db.rows.find(gt.query);
+        if(it == db.rows.end()) continue;
+        int q = it->second;
+        
+        std::vector<int> relevant;
+        for(const std::string &rel : gt.relevant) {
+            auto r = db.rows.find(rel);
+            if(r != db.rows.end()) relevant.push_back(r->second);
+        }
+        
+        std::vector<int> ranked;
+        for(int r = 0; r < repeat; r++) {
+            auto start = std::chrono::steady_clock::now();
+            rank_images(db, method, q, k, ranked);
+            latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        report.precision += precision_at_k(ranked, relevant, k);
+        
+        std::vector<int> full;
+        rank_images(db, method, q, 0, full);
+        report.map += average_precision(full, relevant, 0);
+        report.queries++;
+    }
+    
+    if(report.queries == 0) return -1;
+    report.precision /= report.queries;
+    report.map /= report.queries;
+    
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0.0;
+    for(double l : latencies) sum += l;
+    report.mean_ms = sum / latencies.size();
+    size_t p99 = (size_t)std::ceil(0.99 * latencies.size());
+    report.p99_ms = latencies[std::max((size_t)1, p99) - 1];
+    return 0;
+}
+
+static int write_json(const char *path, const std::vector<MethodReport> &reports, int k) {
+    FILE *fp = fopen(path, "w");
+    if(!fp) {
+        printf("Unable to open output file %s\n", path);
+        return -1;
+    }
+    
+    fprintf(fp, "{\n  \"k\": %d,\n  \"methods\": [\n", k);
+    for(size_t i = 0; i < reports.size(); i++) {
+        const MethodReport &r = reports[i];
+        fprintf(fp, "    {\"name\": \"%s\", \"images\": %d, \"dim\": %d, \"queries\": %d, "
+                    "\"precision_at_k\": %.6f, \"map\": %.6f, \"latency_mean_ms\": %.6f, \"latency_p99_ms\": %.6f, "
+                    "\"index_bytes\": %lu, \"file_bytes\": %lu}%s\n",
+                r.name.c_str(), r.images, r.dim, r.queries, r.precision, r.map, r.mean_ms, r.p99_ms,
+                r.index_bytes, r.file_bytes, i + 1 < reports.size() ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 3) {
+        printf("Usage: %s <ground_truth> <feature_prefix> [--methods a,b,...] [--k K] [--repeat R] [--json out.json]\n", argv[0]);
+        printf("  Features of method m are read from <feature_prefix>_m.csv (written by build_features)\n");
+        printf("  or, for task7, from <feature_prefix>_task7.hyb (written by task7_custom --build)\n");
+        printf("  --methods  subset to evaluate (default: every method with a feature file)\n");
+        printf("  --k        depth for precision@k and the timed top-k search (default 10)\n");
+        printf("  --repeat   timed searches per query, for stable latency (default 5)\n");
+        printf("  --json     also write the results as JSON\n");
+        printf("Example: ./cbir_eval src/olympus_ground_truth.txt olympus --k 5 --json eval.json\n");
+        return -1;
+    }
+    
+    char *truth_path = argv[1];
+    std::string prefix = argv[2];
+    const char *method_list = NULL;
+    const char *json_path = NULL;
+    int k = 10;
+    int repeat = 5;
+    
+    for(int i = 3; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--methods") == 0) method_list = argv[i + 1];
+        else if(strcmp(argv[i], "--k") == 0) k = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--repeat") == 0) repeat = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--json") == 0) json_path = argv[i + 1];
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(k <= 0 || repeat <= 0) {
+        printf("Error: k and repeat must be > 0\n");
+        return -1;
+    }
+    
+    std::vector<GroundTruthQuery> truth;
+    if(read_ground_truth(truth_path, truth) != 0 || truth.empty()) {
+        printf("Error: No labeled queries in %s\n", truth_path);
+        return -1;
+    }
+    
+    std::vector<std::string> names;
+    bool explicit_list = method_list != NULL;
+    if(explicit_list) {
+        names = split_list(method_list);
+    } else {
+        for(const RetrievalMethod &m : retrieval_methods()) names.push_back(m.name);
+    }
+    
+    std::vector<MethodReport> reports;
+    for(const std::string &name : names) {
+        const RetrievalMethod *method = find_retrieval_method(name.c_str());
+        if(!method) {
+            printf("Error: Unknown method %s\n", name.c_str());
+            return -1;
+        }
+        
+        // Task 7 reads its hybrid index instead of a CSV
+        std::string csv = prefix + "_" + name + ".csv";
+        struct stat st;
+        if(stat(csv.c_str(), &st) != 0) csv = prefix + "_" + name + ".hyb";
+        if(stat(csv.c_str(), &st) != 0) {
+            if(explicit_list) printf("Warning: %s_%s.csv not found, skipping %s\n", prefix.c_str(), name.c_str(), name.c_str());
+            continue;
+        }
+        
+        FeatureDatabase db;
+        if(load_feature_database(csv.c_str(), db) != 0) {
+            printf("Warning: No features in %s, skipping %s\n", csv.c_str(), name.c_str());
+            continue;
+        }
+        
+        MethodReport report;
+        report.name = name;
+        report.images = db.names.size();
+        report.dim = db.features[0].size();
+        report.index_bytes = db.feature_bytes();
+        report.file_bytes = st.st_size;
+        if(evaluate_method(*method, db, truth, k, repeat, report) != 0) {
+            printf("Warning: No labeled query is in %s, skipping %s\n", csv.c_str(), name.c_str());
+            continue;
+        }
+        reports.push_back(report);
+    }
+    
+    if(reports.empty()) {
+        printf("Error: Nothing to evaluate (no %s_<method>.csv files)\n", prefix.c_str());
+        return -1;
+    }
+    
+    printf("\n%-14s %7s %5s %7s %9s %9s %10s %10s %11s\n", "method", "images", "dim", "queries",
+           ("P@" + std::to_string(k)).c_str(), "mAP", "mean ms", "p99 ms", "index KB");
+    for(const MethodReport &r : reports) {
+        printf("%-14s %7d %5d %7d %9.4f %9.4f %10.3f %10.3f %11.1f\n", r.name.c_str(), r.images, r.dim,
+               r.queries, r.precision, r.map, r.mean_ms, r.p99_ms, r.index_bytes / 1024.0);
+    }
+    
+    if(json_path) {
+        if(write_json(json_path, reports, k) != 0) return -1;
+        printf("\nWrote %s\n", json_path);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Pack every image of a directory into one container file for the matchers and builders
+*/
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <sys/stat.h>
+#include "image_pack.h"
+#include "image_source.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 3) {
+        printf("Usage: %s <image_directory> <pack_file>\n", argv[0]);
+        printf("Example: ./cbir_pack src/olympus olympus.pack\n");
+        printf("Then pass olympus.pack wherever a program takes the image directory\n");
+        return -1;
+    }
+    
+    char *directory = argv[1];
+    char *pack_file = argv[2];
+    
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    if(source.packed) {
+        printf("Error: %s is already a pack file\n", directory);
+        return -1;
+    }
+    
+    // Store images in name order
+    std::vector<std::string> names = source.names;
+    std::sort(names.begin(), names.end());
+    std::vector<std::string> paths;
+    for(const std::string &name : names) {
+        paths.push_back(std::string(directory) + "/" + name);
+    }
+    
+    int count = write_image_pack(pack_file, names, paths);
+    if(count < 0) {
+        return -1;
+    }
+    
+    struct stat st;
+    long long bytes = stat(pack_file, &st) == 0 ? (long long)st.st_size : 0;
+    printf("Packed %d images from %s into %s (%.1f MB)\n", count, directory, pack_file, bytes / (1024.0 * 1024.0));
+    
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Partition a CSV feature store into N shard files by filename hash or by range
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "csv_util.h"
+#include "feature_writer.h"
+#include "shard.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <features_csv> <num_shards> <output_prefix> [hash|range]\n", argv[0]);
+        printf("  writes <output_prefix>.0.csv ... <output_prefix>.<N-1>.csv\n");
+        printf("Example: ./cbir_shard olympus_rgb.csv 4 olympus_rgb hash\n");
+        return -1;
+    }
+    
+    char *features_csv = argv[1];
+    int num_shards = atoi(argv[2]);
+    const char *prefix = argv[3];
+    const char *mode = (argc >= 5) ? argv[4] : "hash";
+    
+    bool by_hash = strcmp(mode, "hash") == 0;
+    if(!by_hash && strcmp(mode, "range") != 0) {
+        printf("Error: mode must be 'hash' or 'range'\n");
+        return -1;
+    }
+    if(num_shards <= 0) {
+        printf("Error: num_shards must be > 0\n");
+        return -1;
+    }
+    
+    std::vector<char *> filenames;
+    std::vector<std::vector<float>> data;
+    if(read_image_data_csv(features_csv, filenames, data) != 0 || data.empty()) {
+        printf("Error: No features in %s\n", features_csv);
+        return -1;
+    }
+    
+    // Create (or truncate) every shard file first, so a shard no row hashes to
+    // is still an empty file rather than missing or left over from an earlier split
+    std::vector<int> counts(num_shards, 0);
+    std::vector<FeatureWriter> writers(num_shards);
+    for(int s = 0; s < num_shards; s++) {
+        char shard_file[512];
+        snprintf(shard_file, sizeof(shard_file), "%s.%d.csv", prefix, s);
+        if(writers[s].open(shard_file, FEATURE_WRITER_CSV, 1 << 20) != 0) {
+            return -1;
+        }
+    }
+    
+    // Route every row
+    for(size_t i = 0; i < data.size(); i++) {
+        int shard = by_hash ? shard_of_name(filenames[i], num_shards) : shard_of_row(i, data.size(), num_shards);
+        writers[shard].write(filenames[i], data[i]);
+        counts[shard]++;
+        
+        delete[] filenames[i];
+    }
+    for(int s = 0; s < num_shards; s++) {
+        if(writers[s].close() < 0) {
+            return -1;
+        }
+    }
+    
+    printf("Split %lu rows into %d shards (%s):\n", data.size(), num_shards, mode);
+    for(int s = 0; s < num_shards; s++) {
+        printf("  %s.%d.csv: %d rows\n", prefix, s, counts[s]);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the per-cell histogram index (storage, integral tables, region queries)
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include "cell_index.h"
+
+// File header: magic, grid rows, grid cols, bins
+static const char CELL_INDEX_MAGIC[4] = {'C', 'I', 'D', 'X'};
+
+/*
+  Append one image record: name length, name, per-cell counts
+ */
+int append_cell_index(const char *filename, const char *image_filename, int grid_rows, int grid_cols, int bins,
+                      const std::vector<int> &counts, int reset_file) {
+  if((int)counts.size() != grid_rows * grid_cols * bins) {
+    printf("Cell counts do not match a %dx%d grid of %d bins\n", grid_rows, grid_cols, bins);
+    return(-1);
+  }
+
+  FILE *fp = fopen(filename, reset_file ? "wb" : "ab");
+  if(!fp) {
+    printf("Unable to open output file %s\n", filename);
+    return(-1);
+  }
+
+  if(reset_file) {
+    int header[3] = {grid_rows, grid_cols, bins};
+    fwrite(CELL_INDEX_MAGIC, sizeof(char), 4, fp);
+    fwrite(header, sizeof(int), 3, fp);
+  }
+
+  int name_len = strlen(image_filename);
+  fwrite(&name_len, sizeof(int), 1, fp);
+  fwrite(image_filename, sizeof(char), name_len, fp);
+
+  std::vector<unsigned int> packed(counts.begin(), counts.end());
+  fwrite(packed.data(), sizeof(unsigned int), packed.size(), fp);
+
+  fclose(fp);
+
+  return(0);
+}
+
+/*
+  Read the index and convert each image's cell counts into an integral table
+  I(r, c) = counts of all cells above and to the left of grid corner (r, c)
+ */
+int read_cell_index(const char *filename, CellIndex &index) {
+  FILE *fp = fopen(filename, "rb");
+  if(!fp) {
+    printf("Unable to open cell index %s\n", filename);
+    return(-1);
+  }
+
+  char magic[4];
+  int header[3];
+  if(fread(magic, sizeof(char), 4, fp) != 4 || memcmp(magic, CELL_INDEX_MAGIC, 4) != 0 ||
+     fread(header, sizeof(int), 3, fp) != 3) {
+    printf("%s is not a cell index\n", filename);
+    fclose(fp);
+    return(-1);
+  }
+
+  index.grid_rows = header[0];
+  index.grid_cols = header[1];
+  index.bins = header[2];
+  index.filenames.clear();
+  index.tables.clear();
+
+  int rows = index.grid_rows;
+  int cols = index.grid_cols;
+  int bins = index.bins;
+  size_t cell_values = (size_t)rows * cols * bins;
+  size_t table_size = index.table_size();
+  std::vector<unsigned int> counts(cell_values);
+
+  printf("Reading %s\n", filename);
+  for(;;) {
+    int name_len = 0;
+    if(fread(&name_len, sizeof(int), 1, fp) != 1) {
+      break;
+    }
+
+    std::string name(name_len, '\0');
+    if(fread(&name[0], sizeof(char), name_len, fp) != (size_t)name_len ||
+       fread(counts.data(), sizeof(unsigned int), cell_values, fp) != cell_values) {
+      printf("Truncated record in %s\n", filename);
+      break;
+    }
+
+    // Integral table: first row and first column are zero
+    size_t base = index.tables.size();
+    index.tables.resize(base + table_size, 0);
+    unsigned int *table = &index.tables[base];
+
+    for(int r = 0; r < rows; r++) {
+      for(int c = 0; c < cols; c++) {
+        const unsigned int *cell = &counts[((size_t)r * cols + c) * bins];
+        unsigned int *out = &table[((size_t)(r + 1) * (cols + 1) + (c + 1)) * bins];
+        const unsigned int *up = &table[((size_t)r * (cols + 1) + (c + 1)) * bins];
+        const unsigned int *left = &table[((size_t)(r + 1) * (cols + 1) + c) * bins];
+        const unsigned int *diag = &table[((size_t)r * (cols + 1) + c) * bins];
+        for(int b = 0; b < bins; b++) {
+          out[b] = cell[b] + up[b] + left[b] - diag[b];
+        }
+      }
+    }
+
+    index.filenames.push_back(name);
+  }
+  fclose(fp);
+  printf("Loaded %lu images (%dx%d cells, %d bins)\n", index.filenames.size(), rows, cols, bins);
+
+  return(0);
+}
+
+/*
+  Linear search for an image name
+ */
+int cell_index_find(const CellIndex &index, const char *image_filename) {
+  for(size_t i = 0; i < index.filenames.size(); i++) {
+    if(index.filenames[i] == image_filename) {
+      return((int)i);
+    }
+  }
+  return(-1);
+}
+
+/*
+  Region counts from the four integral table corners
+ */
+long long cell_region_counts(const CellIndex &index, int image, const CellRegion &region, std::vector<unsigned int> &hist) {
+  int cols = index.grid_cols;
+  int bins = index.bins;
+  const unsigned int *table = &index.tables[(size_t)image * index.table_size()];
+
+  const unsigned int *a = &table[((size_t)region.y * (cols + 1) + region.x) * bins];
+  const unsigned int *b = &table[((size_t)region.y * (cols + 1) + region.x + region.w) * bins];
+  const unsigned int *c = &table[((size_t)(region.y + region.h) * (cols + 1) + region.x) * bins];
+  const unsigned int *d = &table[((size_t)(region.y + region.h) * (cols + 1) + region.x + region.w) * bins];
+
+  hist.resize(bins);
+  long long total = 0;
+  for(int i = 0; i < bins; i++) {
+    hist[i] = d[i] - b[i] - c[i] + a[i];
+    total += hist[i];
+  }
+
+  return(total);
+}
+
+/*
+  Histogram intersection against the region of one image
+  The region is assembled and normalized on the fly, so every query,
+  regional or whole-image, reads exactly 4 x bins counts per image
+ */
+float cell_region_distance(const CellIndex &index, int image, const CellRegion &region, const std::vector<float> &query) {
+  int cols = index.grid_cols;
+  int bins = index.bins;
+  const unsigned int *table = &index.tables[(size_t)image * index.table_size()];
+
+  const unsigned int *a = &table[((size_t)region.y * (cols + 1) + region.x) * bins];
+  const unsigned int *b = &table[((size_t)region.y * (cols + 1) + region.x + region.w) * bins];
+  const unsigned int *c = &table[((size_t)(region.y + region.h) * (cols + 1) + region.x) * bins];
+  const unsigned int *d = &table[((size_t)(region.y + region.h) * (cols + 1) + region.x + region.w) * bins];
+
+  // Region pixel count: every pixel lands in exactly one bin
+  unsigned int total = 0;
+  for(int i = 0; i < bins; i++) {
+    total += d[i] - b[i] - c[i] + a[i];
+  }
+  if(total == 0) {
+    return(1.0f);
+  }
+
+  float scale = 1.0f / (float)total;
+  float intersection = 0.0f;
+  for(int i = 0; i < bins; i++) {
+    float value = (float)(d[i] - b[i] - c[i] + a[i]) * scale;
+    intersection += std::min(query[i], value);
+  }
+
+  return(1.0f - intersection);
+}
@@ -0,0 +1,71 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the per-cell histogram index used for region-of-interest queries
+*/
+
+#ifndef CELL_INDEX_H
+#define CELL_INDEX_H
+
+#include <vector>
+#include <string>
+
+/*
+  In-memory cell index
+  On disk every image stores grid_rows x grid_cols per-cell histogram counts.
+  In memory each image keeps an integral table of (grid_rows + 1) x (grid_cols + 1) x bins
+  counts, so the histogram of any cell-aligned region costs 4 lookups per bin,
+  the same as reading one whole-image histogram.
+*/
+struct CellIndex {
+    int grid_rows = 0;
+    int grid_cols = 0;
+    int bins = 0;                          // 512 for RGB, 128 for HSV
+    std::vector<std::string> filenames;
+    std::vector<unsigned int> tables;      // one integral table per image, back to back
+
+    size_t table_size() const {
+        return (size_t)(grid_rows + 1) * (grid_cols + 1) * bins;
+    }
+};
+
+/*
+  Cell-aligned region: columns [x, x + w) and rows [y, y + h) in cell units
+*/
+struct CellRegion {
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+/*
+  Append one image's per-cell counts (grid_rows * grid_cols * bins, cell-major) to the index file.
+  If reset_file is true, the file is truncated and a new header is written first.
+*/
+int append_cell_index(const char *filename, const char *image_filename, int grid_rows, int grid_cols, int bins,
+                      const std::vector<int> &counts, int reset_file = 0);
+
+/*
+  Read an index file and build the integral table of every image
+*/
+int read_cell_index(const char *filename, CellIndex &index);
+
+/*
+  Find the position of an image in the index, -1 if it is not there
+*/
+int cell_index_find(const CellIndex &index, const char *image_filename);
+
+/*
+  Assemble the histogram counts of a region of one indexed image (no pixel access)
+  Returns the number of pixels in the region
+*/
+long long cell_region_counts(const CellIndex &index, int image, const CellRegion &region, std::vector<unsigned int> &hist);
+
+/*
+  Histogram intersection distance between a normalized query histogram and the
+  same region of one indexed image, computed straight from the integral table
+*/
+float cell_region_distance(const CellIndex &index, int image, const CellRegion &region, const std::vector<float> &query);
+
+#endif
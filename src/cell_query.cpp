@@ -0,0 +1,138 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Region-of-interest query-by-example against a per-cell histogram index
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "features.h"
+#include "cell_index.h"
+
+// Structure to hold image filename and its distance to target
+struct ImageMatch {
+    std::string filename;
+    float distance;
+    
+    // For sorting
+    bool operator<(const ImageMatch &other) const {
+        return distance < other.distance;
+    }
+};
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <index_file> <target_image> <num_matches> [--roi x,y,w,h]\n", argv[0]);
+        printf("  target_image is an indexed image name, or a path to an image file\n");
+        printf("  --roi selects a region in cell units (default: whole image)\n");
+        printf("Example: ./cell_query olympus_rgb.cidx pic.0274.jpg 5 --roi 0,0,8,4\n");
+        return -1;
+    }
+    
+    char *index_file = argv[1];
+    char *target_filename = argv[2];
+    int num_matches = atoi(argv[3]);
+    
+    // Load index
+    CellIndex index;
+    if(read_cell_index(index_file, index) != 0 || index.filenames.empty()) {
+        printf("Error: Cannot load index %s\n", index_file);
+        return -1;
+    }
+    
+    // Region of interest in cell units
+    CellRegion region = {0, 0, index.grid_cols, index.grid_rows};
+    for(int i = 4; i < argc; i++) {
+        if(strcmp(argv[i], "--roi") == 0 && i + 1 < argc) {
+            if(sscanf(argv[++i], "%d,%d,%d,%d", &region.x, &region.y, &region.w, &region.h) != 4) {
+                printf("Error: --roi expects x,y,w,h\n");
+                return -1;
+            }
+        }
+    }
+    if(region.x < 0 || region.y < 0 || region.w <= 0 || region.h <= 0 ||
+       region.x + region.w > index.grid_cols || region.y + region.h > index.grid_rows) {
+        printf("Error: ROI must lie inside the %dx%d cell grid\n", index.grid_cols, index.grid_rows);
+        return -1;
+    }
+    
+    // Target region histogram: from the index when possible, otherwise from the image file
+    std::vector<unsigned int> target_counts;
+    long long target_pixels = 0;
+    int target_idx = cell_index_find(index, target_filename);
+    if(target_idx >= 0) {
+        target_pixels = cell_region_counts(index, target_idx, region, target_counts);
+    } else {
+        cv::Mat target = cv::imread(target_filename);
+        if(target.empty()) {
+            printf("Error: %s is neither indexed nor a readable image\n", target_filename);
+            return -1;
+        }
+        
+        std::vector<int> counts, cell_pixels;
+        if(index.bins == 128) {
+            cell_histogram_counts_hsv(target, index.grid_rows, index.grid_cols, counts, cell_pixels);
+        } else {
+            cell_histogram_counts(target, index.grid_rows, index.grid_cols, counts, cell_pixels);
+        }
+        
+        // Sum the target's cells inside the region
+        target_counts.assign(index.bins, 0);
+        for(int r = region.y; r < region.y + region.h; r++) {
+            for(int c = region.x; c < region.x + region.w; c++) {
+                const int *cell = &counts[(r * index.grid_cols + c) * index.bins];
+                for(int b = 0; b < index.bins; b++) {
+                    target_counts[b] += cell[b];
+                }
+                target_pixels += cell_pixels[r * index.grid_cols + c];
+            }
+        }
+    }
+    
+    if(target_pixels == 0) {
+        printf("Error: Target region is empty\n");
+        return -1;
+    }
+    
+    std::vector<float> target_hist(index.bins);
+    for(int b = 0; b < index.bins; b++) {
+        target_hist[b] = (float)target_counts[b] / (float)target_pixels;
+    }
+    
+    printf("Target image: %s\n", target_filename);
+    printf("Region: cells x=%d y=%d w=%d h=%d of %dx%d (%d bins)\n",
+           region.x, region.y, region.w, region.h, index.grid_cols, index.grid_rows, index.bins);
+    
+    // Compare the same region of every indexed image, no pixel access
+    double start = (double)cv::getTickCount();
+    std::vector<ImageMatch> matches;
+    matches.reserve(index.filenames.size());
+    for(size_t i = 0; i < index.filenames.size(); i++) {
+        if((int)i == target_idx) {
+            continue;
+        }
+        
+        ImageMatch match;
+        match.filename = index.filenames[i];
+        match.distance = cell_region_distance(index, (int)i, region, target_hist);
+        matches.push_back(match);
+    }
+    
+    // Only the top N need to be ordered
+    int k = std::min(num_matches, (int)matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + k, matches.end());
+    double elapsed_ms = ((double)cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+    
+    // Print top N matches
+    printf("\nTop %d matches:\n", k);
+    for(int i = 0; i < k; i++) {
+        printf("%d. %s (distance: %.6f)\n", i+1, matches[i].filename.c_str(), matches[i].distance);
+    }
+    printf("\nQuery time: %.3f ms over %lu images\n", elapsed_ms, matches.size());
+    
+    return 0;
+}
@@ -5,6 +5,7 @@
 */
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <vector>
 #include "csv_util.h"
@@ -168,4 +169,83 @@ int read_image_data_csv(char *filename, std::vector<char *> &filenames, std::vec
   }
 
   return(0);
-}
\ No newline at end of file
+}
+
+/*
+  Append one sparse line: filename,num_bins,bin:weight,bin:weight,...
+ */
+int append_sparse_data_csv(char *filename, char *image_filename, std::vector<int> &bins, std::vector<float> &weights,
+                           int num_bins, int reset_file) {
+  FILE *fp;
+
+  fp = fopen(filename, reset_file ? "w" : "a");
+  if(!fp) {
+    printf("Unable to open output file %s\n", filename);
+    return(-1);
+  }
+
+  fprintf(fp, "%s,%d", image_filename, num_bins);
+  for(size_t i=0; i<bins.size(); i++) {
+    fprintf(fp, ",%d:%.4f", bins[i], weights[i]);
+  }
+  fprintf(fp, "\n");
+
+  fclose(fp);
+
+  return(0);
+}
+
+/*
+  Read a sparse feature store
+ */
+int read_sparse_data_csv(char *filename, std::vector<char *> &filenames, std::vector<std::vector<int>> &bins,
+                         std::vector<std::vector<float>> &weights, int &num_bins) {
+  FILE *fp;
+  char img_file[256];
+  char token[256];
+
+  fp = fopen(filename, "r");
+  if(!fp) {
+    printf("Unable to open sparse feature file\n");
+    return(-1);
+  }
+
+  num_bins = 0;
+  printf("Reading %s\n", filename);
+  for(;;) {
+    std::vector<int> bvec;
+    std::vector<float> wvec;
+
+    if(getstring(fp, img_file)) {
+      break;
+    }
+
+    // dense length, then bin:weight pairs until the end of the line
+    int eol = getstring(fp, token);
+    int dense_len = atoi(token);
+    if(dense_len > num_bins) {
+      num_bins = dense_len;
+    }
+
+    while(!eol) {
+      int bin;
+      float weight;
+      eol = getstring(fp, token);
+      if(sscanf(token, "%d:%f", &bin, &weight) == 2) {
+        bvec.push_back(bin);
+        wvec.push_back(weight);
+      }
+    }
+
+    bins.push_back(bvec);
+    weights.push_back(wvec);
+
+    char *fname = new char[strlen(img_file)+1];
+    strcpy(fname, img_file);
+    filenames.push_back(fname);
+  }
+  fclose(fp);
+  printf("Finished reading sparse CSV file\n");
+
+  return(0);
+}
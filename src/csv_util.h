@@ -25,4 +25,19 @@ int append_image_data_csv(char *filename, char *image_filename, std::vector<floa
 */
 int read_image_data_csv(char *filename, std::vector<char *> &filenames, std::vector<std::vector<float>> &data, int echo_file = 0);
 
+/*
+  Sparse feature store: each line is the image filename, the dense length
+  (number of bins), then only the nonzero bins as bin:weight pairs.
+  Appends one line; reset_file = 1 truncates the file first.
+*/
+int append_sparse_data_csv(char *filename, char *image_filename, std::vector<int> &bins, std::vector<float> &weights,
+                           int num_bins, int reset_file = 0);
+
+/*
+  Reads a sparse feature store written by append_sparse_data_csv.
+  num_bins receives the largest dense length in the file.
+*/
+int read_sparse_data_csv(char *filename, std::vector<char *> &filenames, std::vector<std::vector<int>> &bins,
+                         std::vector<std::vector<float>> &weights, int &num_bins);
+
 #endif
\ No newline at end of file
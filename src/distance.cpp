@@ -47,19 +47,29 @@ float histogram_intersection_distance(const std::vector<float> &hist1, const std
 }
 
 /*
-  Calculate combined color + texture distance
+  Calculate cosine distance between two raw embeddings
+  One serial sum per term, in the order block_cosine_distances adds them
+*/
+float cosine_distance(const std::vector<float> &feat1, const std::vector<float> &feat2) {
+    float dot = 0.0f, norm1 = 0.0f, norm2 = 0.0f;
+    for(size_t i = 0; i < feat1.size() && i < feat2.size(); i++) {
+        dot += feat1[i] * feat2[i];
+        norm1 += feat1[i] * feat1[i];
+        norm2 += feat2[i] * feat2[i];
+    }
+    return cosine_distance_from_sums(dot, norm1, norm2);
+}
+
+/*
+  Color and texture distances of two color + texture features
   First 512 bins are color (RGB histogram)
   Last 16 bins are texture (gradient magnitude histogram)
-  Equal weighting: 0.5 * color_distance + 0.5 * texture_distance
 */
-float color_texture_distance(const std::vector<float> &feat1, const std::vector<float> &feat2) {
-    if(feat1.size() != feat2.size()) {
-        return -1.0f;
-    }
-    
+int color_texture_components(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                             float &color_distance, float &texture_distance) {
     // Expected size: 512 (color) + 16 (texture) = 528
-    if(feat1.size() != 528) {
-        return -1.0f;
+    if(feat1.size() != 528 || feat2.size() != 528) {
+        return -1;
     }
     
     // Calculate color histogram intersection (first 512 bins)
@@ -67,15 +77,114 @@ float color_texture_distance(const std::vector<float> &feat1, const std::vector<
     for(int i = 0; i < 512; i++) {
         color_intersection += std::min(feat1[i], feat2[i]);
     }
-    float color_distance = 1.0f - color_intersection;
+    color_distance = 1.0f - color_intersection;
     
     // Calculate texture histogram intersection (last 16 bins)
     float texture_intersection = 0.0f;
     for(int i = 512; i < 528; i++) {
         texture_intersection += std::min(feat1[i], feat2[i]);
     }
-    float texture_distance = 1.0f - texture_intersection;
+    texture_distance = 1.0f - texture_intersection;
+    
+    return 0;
+}
+
+/*
+  Calculate combined color + texture distance
+  Weighted sum of the two components (0.5 / 0.5 by default)
+*/
+float color_texture_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                             float color_weight, float texture_weight) {
+    float color_distance, texture_distance;
+    if(color_texture_components(feat1, feat2, color_distance, texture_distance) != 0) {
+        return -1.0f;
+    }
+    
+    return color_weight * color_distance + texture_weight * texture_distance;
+}
+
+/*
+  Color and texture distances of two color + Laws features
+  First 512 values are color histogram
+  Last 9 values are Laws texture energy
+*/
+int color_laws_components(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                          float &color_distance, float &texture_distance) {
+    if(feat1.size() != 521 || feat2.size() != 521) {
+        return -1;
+    }
+    
+    // Color histogram intersection (first 512 bins)
+    float color_intersection = 0.0f;
+    for(int i = 0; i < 512; i++) {
+        color_intersection += std::min(feat1[i], feat2[i]);
+    }
+    color_distance = 1.0f - color_intersection;
+    
+    // Laws texture: use Euclidean distance (last 9 values)
+    texture_distance = 0.0f;
+    for(int i = 512; i < 521; i++) {
+        float diff = feat1[i] - feat2[i];
+        texture_distance += diff * diff;
+    }
+    texture_distance = std::sqrt(texture_distance);
     
-    // Equal weighting
-    return 0.5f * color_distance + 0.5f * texture_distance;
-}
\ No newline at end of file
+    // Normalize texture distance to [0,1] range (max possible is sqrt(9) = 3)
+    texture_distance /= 3.0f;
+    
+    return 0;
+}
+
+/*
+  Calculate combined color + Laws texture distance
+  Weighted sum of the two components (0.5 / 0.5 by default)
+*/
+float color_laws_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                          float color_weight, float texture_weight) {
+    float color_distance, texture_distance;
+    if(color_laws_components(feat1, feat2, color_distance, texture_distance) != 0) {
+        return -1.0f;
+    }
+    
+    return color_weight * color_distance + texture_weight * texture_distance;
+}
+
+/*
+  Calculate weighted multi-region histogram intersection distance
+  Generalizes the top/bottom multi-histogram distance to any number of regions
+  (e.g. every cell of a spatial pyramid) with per-region weights
+*/
+float multi_region_intersection_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                                         int bins_per_region, const std::vector<float> &region_weights) {
+    if(feat1.size() != feat2.size() || bins_per_region <= 0) {
+        return -1.0f;
+    }
+    
+    int num_regions = feat1.size() / bins_per_region;
+    if(!region_weights.empty() && (int)region_weights.size() != num_regions) {
+        return -1.0f;
+    }
+    
+    float total_distance = 0.0f;
+    float total_weight = 0.0f;
+    
+    for(int r = 0; r < num_regions; r++) {
+        int start_idx = r * bins_per_region;
+        
+        // Histogram intersection for this region
+        float intersection = 0.0f;
+        for(int i = 0; i < bins_per_region; i++) {
+            intersection += std::min(feat1[start_idx + i], feat2[start_idx + i]);
+        }
+        
+        float weight = region_weights.empty() ? 1.0f : region_weights[r];
+        total_distance += weight * (1.0f - intersection);
+        total_weight += weight;
+    }
+    
+    if(total_weight <= 0.0f) {
+        return -1.0f;
+    }
+    
+    return total_distance / total_weight;
+}
@@ -8,6 +8,21 @@
 #define DISTANCE_H
 
 #include <vector>
+#include <cmath>
+#include <algorithm>
+
+/*
+  Finish a cosine distance from a dot product and the two squared norms:
+  1 - dot / (|a| |b|), clamped to [0, 2] (rounding can push the similarity
+  just past 1), and 2 if either vector is zero
+  Every cosine distance (retrieval engine, batched kernels, embedding store,
+  hybrid index) ends here, so they agree on the same sums
+*/
+static inline float cosine_distance_from_sums(float dot, float sq_norm_a, float sq_norm_b) {
+    if(sq_norm_a == 0.0f || sq_norm_b == 0.0f) return 2.0f;
+    float distance = 1.0f - dot / (std::sqrt(sq_norm_a) * std::sqrt(sq_norm_b));
+    return std::min(std::max(distance, 0.0f), 2.0f);
+}
 
 /*
   Calculate Sum of Squared Differences (SSD) between two feature vectors
@@ -21,11 +36,50 @@ float ssd_distance(const std::vector<float> &feat1, const std::vector<float> &fe
 float histogram_intersection_distance(const std::vector<float> &hist1, const std::vector<float> &hist2);
 
 /*
-  Calculate combined color + texture distance
+  Calculate cosine distance between two raw (unnormalized) embeddings
+  Returns 1 - cosine similarity, 2 if either is all zeros
+*/
+float cosine_distance(const std::vector<float> &feat1, const std::vector<float> &feat2);
+
+/*
+  Color and texture parts of the color + texture distance
   First 512 bins are color (use histogram intersection)
   Last 16 bins are texture (use histogram intersection)
-  Equal weighting: 0.5 * color_distance + 0.5 * texture_distance
+  Returns 0, or -1 if the features are not 528 values
+*/
+int color_texture_components(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                             float &color_distance, float &texture_distance);
+
+/*
+  Calculate combined color + texture distance
+  Default equal weighting: 0.5 * color_distance + 0.5 * texture_distance
+*/
+float color_texture_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                             float color_weight = 0.5f, float texture_weight = 0.5f);
+
+/*
+  Color and texture parts of the color + Laws distance
+  First 512 values are the color histogram (histogram intersection)
+  Last 9 values are Laws energies (Euclidean, divided by its maximum of 3)
+  Returns 0, or -1 if the features are not 521 values
+*/
+int color_laws_components(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                          float &color_distance, float &texture_distance);
+
+/*
+  Calculate combined color + Laws texture distance
+  Default equal weighting: 0.5 color + 0.5 texture
+*/
+float color_laws_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                          float color_weight = 0.5f, float texture_weight = 0.5f);
+
+/*
+  Calculate weighted multi-region histogram intersection distance
+  Features are concatenated histograms of bins_per_region bins each
+  region_weights holds one weight per region (empty = equal weighting)
+  Returns sum(w_r * (1 - intersection_r)) / sum(w_r)
 */
-float color_texture_distance(const std::vector<float> &feat1, const std::vector<float> &feat2);
+float multi_region_intersection_distance(const std::vector<float> &feat1, const std::vector<float> &feat2,
+                                         int bins_per_region, const std::vector<float> &region_weights);
 
 #endif
\ No newline at end of file
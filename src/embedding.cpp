@@ -0,0 +1,81 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of batched CNN embedding extraction (blob packing, normalization, forward pass)
+*/
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include <cstdio>
+#include <vector>
+#include "embedding.h"
+
+/*
+  Load the network and run it on the OpenCV CPU backend
+*/
+int load_embedding_model(const char *model_path, const char *config_path, EmbeddingModel &model) {
+    try {
+        model.net = cv::dnn::readNet(model_path, config_path ? config_path : "");
+    } catch(const cv::Exception &e) {
+        printf("Error: Cannot load model %s (%s)\n", model_path, e.what());
+        return -1;
+    }
+    
+    if(model.net.empty()) {
+        printf("Error: Cannot load model %s\n", model_path);
+        return -1;
+    }
+    
+    model.net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    model.net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    
+    return 0;
+}
+
+/*
+  Pack a batch into one NCHW blob and forward it
+  blobFromImages resizes, swaps BGR -> RGB, subtracts the ImageNet mean and scales
+  to [0, 1]; the per-channel std division is applied to the blob planes afterwards
+*/
+int embed_batch(EmbeddingModel &model, const std::vector<cv::Mat> &images, std::vector<std::vector<float>> &embeddings) {
+    embeddings.clear();
+    if(images.empty()) {
+        return 0;
+    }
+    
+    // ImageNet statistics (RGB order)
+    const cv::Scalar mean(123.675, 116.28, 103.53);
+    const float inv_std[3] = {1.0f / 0.229f, 1.0f / 0.224f, 1.0f / 0.225f};
+    
+    cv::Mat blob = cv::dnn::blobFromImages(images, 1.0 / 255.0, cv::Size(model.input_size, model.input_size),
+                                           mean, true, false, CV_32F);
+    
+    int batch = images.size();
+    int plane = model.input_size * model.input_size;
+    for(int n = 0; n < batch; n++) {
+        for(int c = 0; c < 3; c++) {
+            float *p = blob.ptr<float>(n, c);
+            for(int i = 0; i < plane; i++) {
+                p[i] *= inv_std[c];
+            }
+        }
+    }
+    
+    cv::Mat out;
+    try {
+        model.net.setInput(blob);
+        out = model.output_layer.empty() ? model.net.forward() : model.net.forward(model.output_layer);
+    } catch(const cv::Exception &e) {
+        printf("Error: Forward pass failed (%s)\n", e.what());
+        return -1;
+    }
+    
+    // N x D (x 1 x 1): flatten everything after the batch axis
+    cv::Mat rows(batch, (int)(out.total() / batch), CV_32F, out.ptr<float>());
+    for(int n = 0; n < batch; n++) {
+        const float *r = rows.ptr<float>(n);
+        embeddings.push_back(std::vector<float>(r, r + rows.cols));
+    }
+    
+    return 0;
+}
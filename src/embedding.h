@@ -0,0 +1,37 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for in-process CNN embedding extraction with OpenCV's dnn module
+*/
+
+#ifndef EMBEDDING_H
+#define EMBEDDING_H
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include <vector>
+#include <string>
+
+/*
+  A loaded embedding network and its preprocessing settings
+  Defaults match ImageNet-trained ResNet18: 224x224 RGB, ImageNet mean/std
+*/
+struct EmbeddingModel {
+    cv::dnn::Net net;
+    int input_size = 224;
+    std::string output_layer;      // empty = the network's default output
+};
+
+/*
+  Load an ONNX model, or a Caffe model with its prototxt as config
+  Returns 0 on success, -1 if the model cannot be read
+*/
+int load_embedding_model(const char *model_path, const char *config_path, EmbeddingModel &model);
+
+/*
+  Run one batch: the images are packed into a single NCHW blob and forwarded together
+  Each output row is flattened into one embedding vector
+*/
+int embed_batch(EmbeddingModel &model, const std::vector<cv::Mat> &images, std::vector<std::vector<float>> &embeddings);
+
+#endif
@@ -0,0 +1,207 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the contiguous embedding store (CSV loading, name hash, GEMV scoring)
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <fstream>
+#include "embedding_store.h"
+
+/*
+  FNV-1a hash of a filename
+*/
+static unsigned int hash_name(const char *s) {
+    unsigned int h = 2166136261u;
+    for(; *s != '\0'; s++) {
+        h ^= (unsigned char)*s;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/*
+  Slot holding name, or the empty slot where it belongs (linear probing)
+*/
+static int find_slot(const EmbeddingStore &store, const char *name) {
+    int mask = store.slots.size() - 1;
+    int s = hash_name(name) & mask;
+    while(store.slots[s] >= 0 && store.names[store.slots[s]] != name) {
+        s = (s + 1) & mask;
+    }
+    return s;
+}
+
+/*
+  Read the CSV into a temporary list, then copy it into one aligned matrix
+*/
+int load_embedding_store(const char *csv_path, int dim, EmbeddingStore &store, bool keep_raw) {
+    std::ifstream in(csv_path);
+    if(!in) {
+        printf("Error: cannot open CSV file: %s\n", csv_path);
+        return -1;
+    }
+    
+    std::vector<std::string> names;
+    std::vector<float> values;
+    
+    // each line is filename + dim floats, of any length
+    std::string line;
+    while(std::getline(in, line)) {
+        char *fname = strtok(&line[0], ",");
+        if(fname == NULL) continue;
+        
+        size_t start = values.size();
+        char *token = NULL;
+        while((token = strtok(NULL, ",")) != NULL) {
+            values.push_back((float)atof(token));
+        }
+        
+        // only keep rows with the right length
+        if(values.size() - start == (size_t)dim) {
+            names.push_back(fname);
+        } else {
+            values.resize(start);
+        }
+    }
+    
+    return build_embedding_store(names, values, dim, store, keep_raw);
+}
+
+/*
+  Copy names.size() rows of dim values into one aligned, normalized matrix
+*/
+int build_embedding_store(const std::vector<std::string> &names, const std::vector<float> &values, int dim,
+                          EmbeddingStore &store, bool keep_raw) {
+    if(names.empty() || dim <= 0 || values.size() != names.size() * dim) {
+        return -1;
+    }
+    
+    // Hash table at most half full
+    size_t table_size = 16;
+    while(table_size < names.size() * 2) table_size *= 2;
+    
+    store.dim = dim;
+    store.stride = (dim + 15) / 16 * 16;
+    store.names.clear();
+    store.norms.clear();
+    store.slots.assign(table_size, -1);
+    free(store.rows);
+    free(store.raw);
+    store.raw = NULL;
+    store.rows = (float *)aligned_alloc(64, names.size() * store.stride * sizeof(float));
+    if(store.rows == NULL) {
+        return -1;
+    }
+    if(keep_raw) {
+        store.raw = (float *)aligned_alloc(64, names.size() * store.stride * sizeof(float));
+        if(store.raw == NULL) {
+            return -1;
+        }
+    }
+    
+    int count = 0;
+    for(size_t i = 0; i < names.size(); i++) {
+        // A repeated filename overwrites its earlier row
+        int slot = find_slot(store, names[i].c_str());
+        int r = store.slots[slot];
+        if(r < 0) {
+            r = count++;
+            store.slots[slot] = r;
+            store.names.push_back(names[i]);
+            store.norms.push_back(0.0f);
+        }
+        
+        const float *src = &values[i * dim];
+        float *dst = store.rows + (size_t)r * store.stride;
+        
+        float norm = 0.0f;
+        for(int j = 0; j < dim; j++) norm += src[j] * src[j];
+        norm = sqrt(norm);
+        
+        float scale = norm > 0.0f ? 1.0f / norm : 0.0f;
+        for(int j = 0; j < dim; j++) dst[j] = src[j] * scale;
+        for(int j = dim; j < store.stride; j++) dst[j] = 0.0f;
+        store.norms[r] = norm;
+        
+        if(store.raw) {
+            float *raw = store.raw + (size_t)r * store.stride;
+            for(int j = 0; j < dim; j++) raw[j] = src[j];
+            for(int j = dim; j < store.stride; j++) raw[j] = 0.0f;
+        }
+    }
+    store.count = count;
+    
+    return 0;
+}
+
+/*
+  Hash lookup of a filename
+*/
+int embedding_store_find(const EmbeddingStore &store, const char *name) {
+    if(store.slots.empty()) {
+        return -1;
+    }
+    return store.slots[find_slot(store, name)];
+}
+
+/*
+  Cosine distance between two rows
+*/
+float embedding_cosine_distance(const EmbeddingStore &store, int q, int i) {
+    float cos_sim = embedding_dot(store.row(q), store.row(i), store.stride);
+    return cosine_distance_from_sums(cos_sim, store.norms[q] > 0.0f ? 1.0f : 0.0f, store.norms[i] > 0.0f ? 1.0f : 0.0f);
+}
+
+/*
+  Cosine distance to every row
+*/
+void embedding_cosine_distances(const EmbeddingStore &store, int q, std::vector<float> &distances) {
+    distances.resize(store.count);
+    for(int i = 0; i < store.count; i++) {
+        distances[i] = embedding_cosine_distance(store, q, i);
+    }
+}
+
+/*
+  Sum of squared differences of two padded rows, eight partial sums like embedding_dot
+*/
+static float ssd_row(const float *a, const float *b, int stride) {
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for(int j = 0; j < stride; j += 8) {
+        for(int k = 0; k < 8; k++) {
+            float d = a[j + k] - b[j + k];
+            acc[k] += d * d;
+        }
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+/*
+  Exact SSD to every row over the unnormalized rows
+*/
+void embedding_ssd_distances(const EmbeddingStore &store, int q, std::vector<float> &distances) {
+    distances.resize(store.count);
+    if(store.raw) {
+        const float *query = store.raw + (size_t)q * store.stride;
+        for(int i = 0; i < store.count; i++) {
+            distances[i] = ssd_row(query, store.raw + (size_t)i * store.stride, store.stride);
+        }
+        return;
+    }
+    
+    // No raw rows: scale each normalized row back up by its norm
+    std::vector<float> query(store.stride), other(store.stride);
+    const float *qn = store.row(q);
+    for(int j = 0; j < store.stride; j++) query[j] = qn[j] * store.norms[q];
+    for(int i = 0; i < store.count; i++) {
+        const float *xn = store.row(i);
+        for(int j = 0; j < store.stride; j++) other[j] = xn[j] * store.norms[i];
+        distances[i] = ssd_row(query.data(), other.data(), store.stride);
+    }
+}
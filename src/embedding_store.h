@@ -0,0 +1,97 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the contiguous, pre-normalized embedding store shared by Task 5 and Task 7
+*/
+
+#ifndef EMBEDDING_STORE_H
+#define EMBEDDING_STORE_H
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "distance.h"
+
+/*
+  N x dim embedding matrix in one 64-byte aligned block
+  Rows are L2-normalized (zero rows stay zero) and padded with zeros to a
+  multiple of 16 floats; the original norm of each row is cached.
+  The unnormalized rows are kept alongside, in the same layout, only when
+  the store is loaded for SSD.
+  Filenames map to rows through an open-addressing hash table.
+*/
+struct EmbeddingStore {
+    int dim = 0;
+    int stride = 0;                    // floats per row, dim rounded up to 16
+    int count = 0;
+    float *rows = NULL;                // count x stride, aligned
+    float *raw = NULL;                 // count x stride original rows, NULL unless kept
+    std::vector<float> norms;          // ||row|| before normalization
+    std::vector<std::string> names;
+    std::vector<int> slots;            // hash table of row indices, -1 = empty
+
+    EmbeddingStore() {}
+    EmbeddingStore(const EmbeddingStore &) = delete;
+    EmbeddingStore &operator=(const EmbeddingStore &) = delete;
+    ~EmbeddingStore() {
+        free(rows);
+        free(raw);
+    }
+
+    const float *row(int i) const { return rows + (size_t)i * stride; }
+};
+
+/*
+  Dot product of two padded rows (stride a multiple of 8)
+  Eight independent partial sums let the compiler keep them in one SIMD register
+*/
+static inline float embedding_dot(const float *a, const float *b, int stride) {
+    float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for(int j = 0; j < stride; j += 8) {
+        for(int k = 0; k < 8; k++) {
+            acc[k] += a[j + k] * b[j + k];
+        }
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+/*
+  Load a CSV of filename + dim floats (the ResNet18 format); rows of any
+  other length are skipped. A repeated filename keeps its last row.
+  keep_raw also keeps the unnormalized rows (twice the memory) for SSD.
+  Returns 0 on success, -1 if the file cannot be read or has no valid rows.
+*/
+int load_embedding_store(const char *csv_path, int dim, EmbeddingStore &store, bool keep_raw = false);
+
+/*
+  Store of rows already in memory: names.size() rows of dim values, row-major
+  Returns 0 on success, -1 if there are no rows or values has the wrong length
+*/
+int build_embedding_store(const std::vector<std::string> &names, const std::vector<float> &values, int dim,
+                          EmbeddingStore &store, bool keep_raw = false);
+
+/*
+  Row of a filename, -1 if it is not in the store
+*/
+int embedding_store_find(const EmbeddingStore &store, const char *name);
+
+/*
+  Cosine distance from row q to every row: one streaming GEMV over the
+  normalized matrix (1 - dot). Rows with zero norm get distance 2.
+*/
+void embedding_cosine_distances(const EmbeddingStore &store, int q, std::vector<float> &distances);
+
+/*
+  Cosine distance from row q to row i, the value embedding_cosine_distances gives
+  (cosine_distance_from_sums over the normalized rows, whose squared norms are 1)
+*/
+float embedding_cosine_distance(const EmbeddingStore &store, int q, int i);
+
+/*
+  SSD from row q to every row, summed as (a - b)^2 over the unnormalized
+  rows so near-identical embeddings do not cancel to noise. Without raw
+  rows (keep_raw) they are rebuilt from the normalized rows and norms.
+*/
+void embedding_ssd_distances(const EmbeddingStore &store, int q, std::vector<float> &distances);
+
+#endif
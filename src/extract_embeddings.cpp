@@ -0,0 +1,164 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Extract CNN embeddings for an image directory with batched cv::dnn inference and write the Task 5 CSV
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "feature_writer.h"
+#include "embedding.h"
+#include "image_source.h"
+
+/*
+  Parse a comma separated list of batch sizes such as "1,8,32"
+*/
+static std::vector<int> parse_sizes(const char *spec) {
+    std::vector<int> sizes;
+    const char *p = spec;
+    while(*p != '\0') {
+        int v = atoi(p);
+        if(v > 0) sizes.push_back(v);
+        const char *comma = strchr(p, ',');
+        if(comma == NULL) break;
+        p = comma + 1;
+    }
+    return sizes;
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <model_file> <image_directory|pack> <output_csv> [options]\n", argv[0]);
+        printf("  --config file     Caffe prototxt (for .caffemodel weights)\n");
+        printf("  --layer name      output layer to read (default: network output)\n");
+        printf("  --size S          input resolution (default 224)\n");
+        printf("  --batch B         images per forward pass (default 16)\n");
+        printf("  --threads T       OpenCV worker threads (default: OpenCV's choice)\n");
+        printf("  --bench 1,8,32    report images/s for each batch size instead of writing the CSV\n");
+        printf("Example: ./extract_embeddings resnet18_pool.onnx src/olympus src/ResNet18_olym.csv --batch 32\n");
+        return -1;
+    }
+    
+    char *model_file = argv[1];
+    char *directory = argv[2];
+    char *output_csv = argv[3];
+    const char *config_file = NULL;
+    const char *bench_sizes = NULL;
+    int batch = 16;
+    int threads = -1;
+    
+    EmbeddingModel model;
+    for(int i = 4; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--config") == 0) config_file = argv[i + 1];
+        else if(strcmp(argv[i], "--layer") == 0) model.output_layer = argv[i + 1];
+        else if(strcmp(argv[i], "--size") == 0) model.input_size = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--batch") == 0) batch = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--threads") == 0) threads = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--bench") == 0) bench_sizes = argv[i + 1];
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    if(batch <= 0 || model.input_size <= 0) {
+        printf("Error: batch and size must be > 0\n");
+        return -1;
+    }
+    if(threads > 0) {
+        cv::setNumThreads(threads);
+    }
+    
+    if(load_embedding_model(model_file, config_file, model) != 0) {
+        return -1;
+    }
+    
+    // Open the image directory or pack file; visit it in name order so the CSV order is stable
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    std::vector<int> order(source.count());
+    for(int i = 0; i < source.count(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return source.names[a] < source.names[b]; });
+    
+    printf("Model: %s (%dx%d input, %d threads)\n", model_file, model.input_size, model.input_size, cv::getNumThreads());
+    printf("Images: %d in %s\n", source.count(), directory);
+    
+    // Throughput mode: decode a sample once, then time inference alone per batch size
+    if(bench_sizes != NULL) {
+        std::vector<int> sizes = parse_sizes(bench_sizes);
+        int sample = std::min(source.count(), 256);
+        std::vector<cv::Mat> images;
+        for(int i = 0; i < sample; i++) {
+            cv::Mat img = read_source_image(source, order[i]);
+            if(!img.empty()) images.push_back(img);
+        }
+        
+        printf("\n%8s %12s %12s\n", "batch", "images/s", "ms/image");
+        for(int b : sizes) {
+            std::vector<std::vector<float>> embeddings;
+            
+            // Warm-up pass so layer allocation is not timed
+            std::vector<cv::Mat> warm(images.begin(), images.begin() + std::min(b, (int)images.size()));
+            embed_batch(model, warm, embeddings);
+            
+            auto start = std::chrono::steady_clock::now();
+            for(size_t i = 0; i < images.size(); i += b) {
+                std::vector<cv::Mat> chunk(images.begin() + i, images.begin() + std::min(i + b, images.size()));
+                if(embed_batch(model, chunk, embeddings) != 0) return -1;
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("%8d %12.1f %12.3f\n", b, images.size() / secs, 1000.0 * secs / images.size());
+        }
+        return 0;
+    }
+    
+    // Extraction mode: decode a batch (files read ahead in the background), forward it, append one CSV row per image
+    FeatureWriter writer;
+    if(writer.open(output_csv) != 0) {
+        return -1;
+    }
+    int written = 0;
+    auto start = std::chrono::steady_clock::now();
+    ImageReadAhead reader;
+    start_source_read_ahead(source, order, 2 * batch, 4, reader);
+    bool more = true;
+    while(more) {
+        std::vector<cv::Mat> images;
+        std::vector<std::string> batch_names;
+        int id;
+        cv::Mat img;
+        while((int)images.size() < batch && (more = next_source_image(reader, id, img))) {
+            if(img.empty()) continue;
+            images.push_back(img);
+            batch_names.push_back(source.names[id]);
+        }
+        if(images.empty()) break;
+        
+        std::vector<std::vector<float>> embeddings;
+        if(embed_batch(model, images, embeddings) != 0) {
+            return -1;
+        }
+        
+        for(size_t j = 0; j < embeddings.size(); j++) {
+            writer.write(batch_names[j], embeddings[j]);
+            written++;
+        }
+    }
+    if(writer.close() < 0) {
+        return -1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    printf("Wrote %d embeddings to %s (%.1f images/s including decode)\n", written, output_csv, written / secs);
+    
+    return 0;
+}
@@ -0,0 +1,384 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the binary feature store, CSV conversion and the double-buffered streaming scan
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include "feature_store.h"
+#include "block_kernels.h"
+
+static const char STORE_MAGIC[4] = {'F', 'S', 'T', 'R'};
+static const size_t STORE_HEADER_SIZE = 28;
+
+uint64_t FeatureStoreInfo::stored_rows() const {
+    if(layout == FEATURE_STORE_BLOCKED) {
+        return (count + FEATURE_BLOCK - 1) / FEATURE_BLOCK * FEATURE_BLOCK;
+    }
+    return count;
+}
+
+bool is_feature_store(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if(!fp) return false;
+    char magic[4];
+    bool match = fread(magic, sizeof(char), 4, fp) == 4 && memcmp(magic, STORE_MAGIC, 4) == 0;
+    fclose(fp);
+    return match;
+}
+
+/*
+  Split one CSV line into the filename and its values
+*/
+static bool parse_csv_row(char *line, std::string &name, std::vector<float> &values) {
+    char *comma = strchr(line, ',');
+    if(!comma) return false;
+    name.assign(line, comma - line);
+    
+    values.clear();
+    char *p = comma + 1;
+    while(*p && *p != '\n' && *p != '\r') {
+        char *end;
+        float v = strtof(p, &end);
+        if(end == p) return false;
+        values.push_back(v);
+        p = end;
+        if(*p == ',') p++;
+    }
+    return !values.empty();
+}
+
+int64_t convert_csv_to_feature_store(const char *csv_path, const char *store_path, int layout) {
+    FILE *in = fopen(csv_path, "r");
+    if(!in) {
+        printf("Unable to open feature file %s\n", csv_path);
+        return -1;
+    }
+    FILE *out = fopen(store_path, "wb");
+    if(!out) {
+        printf("Unable to open output file %s\n", store_path);
+        fclose(in);
+        return -1;
+    }
+    
+    // Names are spooled to a side file and appended after the rows
+    std::string spool_path = std::string(store_path) + ".names";
+    FILE *spool = fopen(spool_path.c_str(), "w+b");
+    if(!spool) {
+        printf("Unable to open temporary file %s\n", spool_path.c_str());
+        fclose(in);
+        fclose(out);
+        return -1;
+    }
+    
+    std::vector<unsigned char> header(FEATURE_STORE_DATA_OFFSET, 0);
+    fwrite(header.data(), 1, header.size(), out);
+    
+    char *line = NULL;
+    size_t capacity = 0;
+    std::string name;
+    std::vector<float> values;
+    int dim = 0;
+    uint64_t count = 0;
+    uint64_t skipped = 0;
+    
+    // Blocked stores collect 16 rows and write them transposed
+    bool blocked = layout == FEATURE_STORE_BLOCKED;
+    std::vector<float> pending, block;
+    size_t pending_rows = 0;
+    auto flush_block = [&]() {
+        transpose_to_blocks(pending.data(), pending_rows, dim, block.data());
+        fwrite(block.data(), sizeof(float), block.size(), out);
+        pending_rows = 0;
+    };
+    
+    while(getline(&line, &capacity, in) > 0) {
+        if(!parse_csv_row(line, name, values)) continue;
+        if(dim == 0) {
+            dim = values.size();
+            pending.resize((size_t)FEATURE_BLOCK * dim);
+            block.resize((size_t)FEATURE_BLOCK * dim);
+        }
+        if((int)values.size() != dim) {
+            skipped++;
+            continue;
+        }
+        
+        if(blocked) {
+            std::copy(values.begin(), values.end(), pending.begin() + pending_rows * dim);
+            if(++pending_rows == FEATURE_BLOCK) flush_block();
+        } else {
+            fwrite(values.data(), sizeof(float), dim, out);
+        }
+        uint32_t name_len = name.size();
+        fwrite(&name_len, sizeof(uint32_t), 1, spool);
+        fwrite(name.data(), sizeof(char), name_len, spool);
+        count++;
+    }
+    free(line);
+    fclose(in);
+    if(blocked && pending_rows > 0) flush_block();
+    
+    // Append the names
+    FeatureStoreInfo info;
+    info.dim = dim;
+    info.count = count;
+    info.layout = blocked ? FEATURE_STORE_BLOCKED : FEATURE_STORE_ROWS;
+    info.names_offset = FEATURE_STORE_DATA_OFFSET + info.stored_rows() * info.row_bytes();
+    std::vector<char> buffer(1 << 20);
+    rewind(spool);
+    size_t n;
+    while((n = fread(buffer.data(), 1, buffer.size(), spool)) > 0) {
+        fwrite(buffer.data(), 1, n, out);
+    }
+    fclose(spool);
+    remove(spool_path.c_str());
+    
+    bool ok = write_feature_store_header(out, info) == 0;
+    fclose(out);
+    if(!ok || count == 0) {
+        printf("Error: failed writing %s\n", store_path);
+        return -1;
+    }
+    if(skipped > 0) {
+        printf("Warning: skipped %lu rows that are not %d values\n", (unsigned long)skipped, dim);
+    }
+    return count;
+}
+
+int write_feature_store_header(FILE *out, const FeatureStoreInfo &info) {
+    unsigned char header[STORE_HEADER_SIZE];
+    uint32_t dim32 = info.dim;
+    uint32_t layout32 = info.layout;
+    memcpy(header, STORE_MAGIC, 4);
+    memcpy(header + 4, &dim32, sizeof(uint32_t));
+    memcpy(header + 8, &info.count, sizeof(uint64_t));
+    memcpy(header + 16, &info.names_offset, sizeof(uint64_t));
+    memcpy(header + 24, &layout32, sizeof(uint32_t));
+    if(fseek(out, 0, SEEK_SET) != 0) return -1;
+    fwrite(header, 1, STORE_HEADER_SIZE, out);
+    return ferror(out) == 0 ? 0 : -1;
+}
+
+int read_feature_store_info(const char *store_path, FeatureStoreInfo &info) {
+    FILE *fp = fopen(store_path, "rb");
+    if(!fp) {
+        printf("Unable to open feature store %s\n", store_path);
+        return -1;
+    }
+    unsigned char header[STORE_HEADER_SIZE];
+    bool ok = fread(header, 1, STORE_HEADER_SIZE, fp) == STORE_HEADER_SIZE &&
+              memcmp(header, STORE_MAGIC, 4) == 0;
+    fclose(fp);
+    if(!ok) {
+        printf("Error: %s is not a feature store\n", store_path);
+        return -1;
+    }
+    
+    uint32_t dim, layout;
+    memcpy(&dim, header + 4, sizeof(uint32_t));
+    memcpy(&info.count, header + 8, sizeof(uint64_t));
+    memcpy(&info.names_offset, header + 16, sizeof(uint64_t));
+    memcpy(&layout, header + 24, sizeof(uint32_t));
+    info.dim = dim;
+    info.layout = layout == FEATURE_STORE_BLOCKED ? FEATURE_STORE_BLOCKED : FEATURE_STORE_ROWS;
+    
+    // Scans divide by the row size and seek past the data, so a corrupt header must stop here
+    if(dim == 0 || dim > (uint32_t)INT_MAX / sizeof(float)) {
+        printf("Error: %s has an invalid dimension %u\n", store_path, dim);
+        return -1;
+    }
+    uint64_t data_rows = info.names_offset < FEATURE_STORE_DATA_OFFSET ? 0 :
+                         (info.names_offset - FEATURE_STORE_DATA_OFFSET) / info.row_bytes();
+    if(info.names_offset < FEATURE_STORE_DATA_OFFSET || info.count > data_rows || info.stored_rows() > data_rows) {
+        printf("Error: %s has %llu rows but its names start at byte %llu, inside the data\n", store_path,
+               (unsigned long long)info.count, (unsigned long long)info.names_offset);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+  Walk the names section in row order, calling visit(row, name) until it returns false
+*/
+template <typename Visit>
+static int for_each_name(const char *store_path, const FeatureStoreInfo &info, Visit visit) {
+    FILE *fp = fopen(store_path, "rb");
+    if(!fp) {
+        printf("Unable to open feature store %s\n", store_path);
+        return -1;
+    }
+    fseeko(fp, info.names_offset, SEEK_SET);
+    
+    std::string name;
+    for(uint64_t row = 0; row < info.count; row++) {
+        uint32_t name_len;
+        if(fread(&name_len, sizeof(uint32_t), 1, fp) != 1) break;
+        name.resize(name_len);
+        if(name_len > 0 && fread(&name[0], 1, name_len, fp) != name_len) break;
+        if(!visit(row, name)) break;
+    }
+    fclose(fp);
+    return 0;
+}
+
+int64_t feature_store_find(const char *store_path, const FeatureStoreInfo &info, const char *name) {
+    int64_t found = -1;
+    for_each_name(store_path, info, [&](uint64_t row, const std::string &n) {
+        if(n == name) {
+            found = row;
+            return false;
+        }
+        return true;
+    });
+    return found;
+}
+
+int feature_store_row(const char *store_path, const FeatureStoreInfo &info, uint64_t row, std::vector<float> &vec) {
+    if(row >= info.count) return -1;
+    int fd = open(store_path, O_RDONLY);
+    if(fd < 0) return -1;
+    vec.resize(info.dim);
+    bool ok;
+    if(info.layout == FEATURE_STORE_BLOCKED) {
+        // Read the row's whole block and pick out its lane
+        std::vector<float> block((size_t)FEATURE_BLOCK * info.dim);
+        size_t length = block.size() * sizeof(float);
+        off_t offset = FEATURE_STORE_DATA_OFFSET + (row / FEATURE_BLOCK) * length;
+        ok = pread(fd, block.data(), length, offset) == (ssize_t)length;
+        if(ok) gather_block_row(block.data(), info.dim, row % FEATURE_BLOCK, vec.data());
+    } else {
+        off_t offset = FEATURE_STORE_DATA_OFFSET + row * info.row_bytes();
+        ok = pread(fd, vec.data(), info.row_bytes(), offset) == (ssize_t)info.row_bytes();
+    }
+    close(fd);
+    return ok ? 0 : -1;
+}
+
+int feature_store_names(const char *store_path, const FeatureStoreInfo &info, const std::vector<uint64_t> &rows,
+                        std::vector<std::string> &names) {
+    names.assign(rows.size(), std::string());
+    if(rows.empty()) return 0;
+    
+    // Visit the wanted rows in ascending order during one pass
+    std::vector<size_t> order(rows.size());
+    for(size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return rows[a] < rows[b]; });
+    
+    size_t next = 0;
+    return for_each_name(store_path, info, [&](uint64_t row, const std::string &n) {
+        while(next < order.size() && rows[order[next]] == row) {
+            names[order[next]] = n;
+            next++;
+        }
+        return next < order.size();
+    });
+}
+
+/*
+  Read num_rows rows starting at first_row, looping over short reads
+*/
+static bool read_rows(int fd, const FeatureStoreInfo &info, uint64_t first_row, size_t num_rows, float *dst) {
+    size_t length = num_rows * info.row_bytes();
+    off_t offset = FEATURE_STORE_DATA_OFFSET + first_row * info.row_bytes();
+    size_t done = 0;
+    while(done < length) {
+        ssize_t n = pread(fd, (char *)dst + done, length - done, offset + done);
+        if(n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+int load_feature_store(const char *store_path, const FeatureStoreInfo &info, std::vector<float> &data) {
+    int fd = open(store_path, O_RDONLY);
+    if(fd < 0) {
+        printf("Unable to open feature store %s\n", store_path);
+        return -1;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    data.resize(info.stored_rows() * info.dim);
+    bool ok = read_rows(fd, info, 0, info.stored_rows(), data.data());
+    close(fd);
+    if(!ok) {
+        printf("Error: Short read from feature store %s\n", store_path);
+        return -1;
+    }
+    return 0;
+}
+
+int stream_scan(const char *store_path, const FeatureStoreInfo &info, size_t mem_budget,
+                const ChunkScorer &score, StreamScanStats &stats) {
+    stats = StreamScanStats();
+    auto start = std::chrono::steady_clock::now();
+    
+    int fd = open(store_path, O_RDONLY);
+    if(fd < 0) {
+        printf("Unable to open feature store %s\n", store_path);
+        return -1;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    // Two chunk buffers within the budget, at least one row (or block) each
+    size_t unit = info.layout == FEATURE_STORE_BLOCKED ? FEATURE_BLOCK : 1;
+    uint64_t stored = info.stored_rows();
+    size_t chunk_rows = std::max((size_t)1, mem_budget / 2 / info.row_bytes() / unit) * unit;
+    chunk_rows = std::min(chunk_rows, (size_t)std::max(stored, (uint64_t)unit));
+    std::vector<float> buffers[2];
+    buffers[0].resize(chunk_rows * info.dim);
+    buffers[1].resize(chunk_rows * info.dim);
+    stats.chunk_rows = chunk_rows;
+    
+    // Whole blocks are read; the scorer is told how many images are real
+    uint64_t num_chunks = (stored + chunk_rows - 1) / chunk_rows;
+    auto chunk_size = [&](uint64_t c) {
+        return (size_t)std::min((uint64_t)chunk_rows, stored - c * chunk_rows);
+    };
+    
+    bool ok = num_chunks == 0 || read_rows(fd, info, 0, chunk_size(0), buffers[0].data());
+    for(uint64_t c = 0; c < num_chunks && ok; c++) {
+        // Read chunk c + 1 into the other buffer while chunk c is scored
+        bool next_ok = true;
+        std::thread reader;
+        if(c + 1 < num_chunks) {
+            reader = std::thread([&, c]() {
+                next_ok = read_rows(fd, info, (c + 1) * chunk_rows, chunk_size(c + 1), buffers[(c + 1) % 2].data());
+            });
+        }
+        
+        size_t rows = chunk_size(c);
+        size_t images = (size_t)std::min((uint64_t)rows, info.count - c * chunk_rows);
+        score(c * chunk_rows, buffers[c % 2].data(), images);
+        stats.rows += images;
+        stats.bytes += rows * info.row_bytes();
+        
+        // Scored pages will not be needed again
+        posix_fadvise(fd, FEATURE_STORE_DATA_OFFSET + c * chunk_rows * info.row_bytes(),
+                      rows * info.row_bytes(), POSIX_FADV_DONTNEED);
+        
+        if(reader.joinable()) {
+            auto wait_start = std::chrono::steady_clock::now();
+            reader.join();
+            stats.read_wait_secs += std::chrono::duration<double>(std::chrono::steady_clock::now() - wait_start).count();
+        }
+        ok = next_ok;
+    }
+    close(fd);
+    
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(!ok) {
+        printf("Error: failed reading %s\n", store_path);
+        return -1;
+    }
+    return 0;
+}
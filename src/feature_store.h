@@ -0,0 +1,123 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the binary feature store and its out-of-core streaming scan
+*/
+
+#ifndef FEATURE_STORE_H
+#define FEATURE_STORE_H
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+
+/*
+  Binary feature store
+  Layout: "FSTR", u32 dim, u64 count, u64 names offset, u32 layout, zero
+  padding to FEATURE_STORE_DATA_OFFSET, the vectors, then the names in row
+  order (u32 length, bytes each). Vectors sit at fixed offsets so any range can
+  be read without parsing, and names are only touched to label results.
+  Vectors are either count x dim row-major floats, or blocks of FEATURE_BLOCK
+  images stored dimension-major (see block_kernels.h), the last block padded.
+  A block of 16 images takes the same bytes as 16 rows, so row r always starts
+  its block at byte (r / 16) * 16 * dim * 4 of the data.
+*/
+#define FEATURE_STORE_DATA_OFFSET 4096
+
+enum FeatureStoreLayout {
+    FEATURE_STORE_ROWS = 0,
+    FEATURE_STORE_BLOCKED = 1
+};
+
+struct FeatureStoreInfo {
+    int dim = 0;
+    uint64_t count = 0;
+    uint64_t names_offset = 0;
+    int layout = FEATURE_STORE_ROWS;
+
+    size_t row_bytes() const { return (size_t)dim * sizeof(float); }
+    // Vectors held on disk, including block padding
+    uint64_t stored_rows() const;
+};
+
+/*
+  True if the file starts with the feature store magic
+*/
+bool is_feature_store(const char *path);
+
+/*
+  Convert a build_features CSV into a feature store one line at a time
+  (memory stays flat however large the CSV is). The first row sets the
+  dimension; rows of any other length are skipped.
+  Returns the number of rows written, -1 on error
+*/
+int64_t convert_csv_to_feature_store(const char *csv_path, const char *store_path,
+                                     int layout = FEATURE_STORE_ROWS);
+
+/*
+  Write the header for info at the start of an open store file (writers
+  reserve FEATURE_STORE_DATA_OFFSET bytes first, then fill it in last)
+  Returns 0 on success, -1 on error
+*/
+int write_feature_store_header(FILE *out, const FeatureStoreInfo &info);
+
+/*
+  Read the header of a feature store
+  Returns 0 on success, -1 on error or an inconsistent header (zero dimension,
+  or a names section that starts inside the vectors)
+*/
+int read_feature_store_info(const char *store_path, FeatureStoreInfo &info);
+
+/*
+  Row of an image name, -1 if absent (one sequential pass over the names)
+*/
+int64_t feature_store_find(const char *store_path, const FeatureStoreInfo &info, const char *name);
+
+/*
+  Read one row into vec
+  Returns 0 on success, -1 on error
+*/
+int feature_store_row(const char *store_path, const FeatureStoreInfo &info, uint64_t row, std::vector<float> &vec);
+
+/*
+  Names of the given rows, in the same order (one sequential pass over the names)
+*/
+int feature_store_names(const char *store_path, const FeatureStoreInfo &info, const std::vector<uint64_t> &rows,
+                        std::vector<std::string> &names);
+
+/*
+  Read every stored vector into data (stored_rows() x dim floats, in the
+  store's layout), for scans that run from memory
+  Returns 0 on success, -1 on error
+*/
+int load_feature_store(const char *store_path, const FeatureStoreInfo &info, std::vector<float> &data);
+
+struct StreamScanStats {
+    uint64_t rows = 0;
+    uint64_t bytes = 0;
+    size_t chunk_rows = 0;
+    double read_wait_secs = 0.0;   // time scoring sat waiting for the next chunk
+    double secs = 0.0;
+};
+
+/*
+  Called with consecutive chunks: the row number of the first row, a pointer
+  to the chunk's vectors and the number of images in the chunk. The vectors
+  are num_rows x dim floats, or for a blocked store ceil(num_rows / 16) blocks
+  (chunks then always start on a block boundary).
+*/
+typedef std::function<void(uint64_t first_row, const float *rows, size_t num_rows)> ChunkScorer;
+
+/*
+  Stream every row of the store through score in fixed-size chunks
+  Two chunk buffers share mem_budget bytes: one is read with pread while the
+  other is scored. Chunks are dropped from the page cache once scored, so the
+  scan's memory stays flat whatever the store size.
+  Returns 0 on success, -1 on a read error
+*/
+int stream_scan(const char *store_path, const FeatureStoreInfo &info, size_t mem_budget,
+                const ChunkScorer &score, StreamScanStats &stats);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the buffered feature writer: fixed-point formatting, ordered rows, CSV or feature store output
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <vector>
+#include <string>
+#include "feature_writer.h"
+#include "feature_store.h"
+
+// Longest "%.4f" of a float: sign, 39 integer digits, point, 4 decimals (plus the comma)
+static const size_t MAX_CSV_VALUE_CHARS = 48;
+
+// Below this magnitude v * 10000 fits the 53-bit double mantissa exactly
+static const double FAST_FORMAT_LIMIT = 9.0e11;
+
+/*
+  "%.4f" of one value. A float has a 24-bit mantissa, so v * 10000 is exact
+  in a double and rounding it to an integer (ties to even, as printf does)
+  gives the printed digits; only huge values and inf/nan go to to_chars.
+*/
+static inline char *format_value(char *p, char *end, float v) {
+    double scaled = (double)v * 10000.0;
+    if(!(std::fabs(scaled) < FAST_FORMAT_LIMIT * 10000.0)) {
+        return std::to_chars(p, end, v, std::chars_format::fixed, 4).ptr;
+    }
+    long long units = std::llrint(std::fabs(scaled));
+    if(std::signbit(v)) *p++ = '-';
+    if(units < 100000) *p++ = '0' + units / 10000;      // histogram bins: a single integer digit
+    else p = std::to_chars(p, end, units / 10000).ptr;
+    int frac = units % 10000;
+    p[0] = '.';
+    p[1] = '0' + frac / 1000;
+    p[2] = '0' + frac / 100 % 10;
+    p[3] = '0' + frac / 10 % 10;
+    p[4] = '0' + frac % 10;
+    return p + 5;
+}
+
+void format_feature_csv_row(const std::string &name, const std::vector<float> &values, std::string &line) {
+    line.resize(name.size() + values.size() * MAX_CSV_VALUE_CHARS + 1);
+    char *p = &line[0];
+    char *end = p + line.size();
+    memcpy(p, name.data(), name.size());
+    p += name.size();
+    for(float v : values) {
+        *p++ = ',';
+        p = format_value(p, end, v);
+    }
+    *p++ = '\n';
+    line.resize(p - line.data());
+}
+
+FeatureWriter::FeatureWriter() {
+}
+
+FeatureWriter::~FeatureWriter() {
+    if(out) close();
+}
+
+int FeatureWriter::open(const char *path, int format, size_t buffer_bytes) {
+    if(out) close();
+    out = fopen(path, "wb");
+    if(!out) {
+        printf("Unable to open output file %s\n", path);
+        return -1;
+    }
+    this->path = path;
+    this->format = format;
+    dim = 0;
+    failed = false;
+    buffer.assign(buffer_bytes > 0 ? buffer_bytes : FEATURE_WRITER_BUFFER, 0);
+    buffer_used = 0;
+    row_count = 0;
+    skipped_count = 0;
+    byte_count = 0;
+    next_seq = 0;
+    write_seq = 0;
+    pending.clear();
+    
+    if(format == FEATURE_WRITER_STORE) {
+        // Names are spooled to a side file and appended after the rows
+        names_path = std::string(path) + ".names";
+        names = fopen(names_path.c_str(), "w+b");
+        if(!names) {
+            printf("Unable to open temporary file %s\n", names_path.c_str());
+            fclose(out);
+            out = NULL;
+            return -1;
+        }
+        
+        // Header space, filled in by close()
+        std::vector<char> header(FEATURE_STORE_DATA_OFFSET, 0);
+        append(header.data(), header.size());
+    }
+    return 0;
+}
+
+void FeatureWriter::append(const char *data, size_t length) {
+    byte_count += length;
+    if(buffer_used + length > buffer.size()) {
+        flush();
+        if(length >= buffer.size()) {
+            if(fwrite(data, 1, length, out) != length) failed = true;
+            return;
+        }
+    }
+    memcpy(buffer.data() + buffer_used, data, length);
+    buffer_used += length;
+}
+
+bool FeatureWriter::flush() {
+    if(buffer_used > 0 && fwrite(buffer.data(), 1, buffer_used, out) != buffer_used) {
+        failed = true;
+    }
+    buffer_used = 0;
+    return !failed;
+}
+
+/*
+  Write one row that is next in sequence (mutex held)
+*/
+void FeatureWriter::emit(Row &row) {
+    if(row.skip) {
+        skipped_count++;
+        return;
+    }
+    
+    if(format == FEATURE_WRITER_STORE) {
+        int row_dim = row.data.size() / sizeof(float);
+        if(dim == 0) dim = row_dim;
+        if(row_dim == 0 || row_dim != dim) {
+            skipped_count++;
+            return;
+        }
+        uint32_t name_len = row.name.size();
+        fwrite(&name_len, sizeof(uint32_t), 1, names);
+        fwrite(row.name.data(), sizeof(char), name_len, names);
+    }
+    append(row.data.data(), row.data.size());
+    row_count++;
+}
+
+int FeatureWriter::finish(Row &row, uint64_t seq) {
+    std::unique_lock<std::mutex> lock(mutex);
+    
+    // Keep the reorder window bounded: wait while the oldest missing row is far behind
+    ready.wait(lock, [&]() { return seq < next_seq + FEATURE_WRITER_MAX_PENDING || failed; });
+    if(seq != next_seq) {
+        pending.emplace(seq, std::move(row));
+        return failed ? -1 : 0;
+    }
+    
+    emit(row);
+    next_seq++;
+    for(auto it = pending.begin(); it != pending.end() && it->first == next_seq; it = pending.erase(it)) {
+        emit(it->second);
+        next_seq++;
+    }
+    ready.notify_all();
+    return failed ? -1 : 0;
+}
+
+int FeatureWriter::submit(uint64_t seq, const std::string &name, const std::vector<float> &values) {
+    Row row;
+    if(format == FEATURE_WRITER_CSV) {
+        format_feature_csv_row(name, values, row.data);
+    } else {
+        row.data.assign((const char *)values.data(), values.size() * sizeof(float));
+        row.name = name;
+    }
+    return finish(row, seq);
+}
+
+void FeatureWriter::skip(uint64_t seq) {
+    Row row;
+    row.skip = true;
+    finish(row, seq);
+}
+
+int FeatureWriter::write(const std::string &name, const std::vector<float> &values) {
+    return submit(write_seq++, name, values);
+}
+
+int64_t FeatureWriter::close() {
+    if(!out) return -1;
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    bool ok = true;
+    if(!pending.empty()) {
+        printf("Error: %lu rows of %s are waiting for row %lu, which was never submitted\n",
+               (unsigned long)pending.size(), path.c_str(), (unsigned long)next_seq);
+        pending.clear();
+        ok = false;
+    }
+    ok = flush() && ok;
+    
+    if(format == FEATURE_WRITER_STORE) {
+        FeatureStoreInfo info;
+        info.dim = dim;
+        info.count = row_count;
+        info.layout = FEATURE_STORE_ROWS;
+        info.names_offset = FEATURE_STORE_DATA_OFFSET + info.stored_rows() * info.row_bytes();
+        
+        // Append the spooled names through the same buffer
+        rewind(names);
+        size_t n;
+        while((n = fread(buffer.data(), 1, buffer.size(), names)) > 0) {
+            byte_count += n;
+            if(fwrite(buffer.data(), 1, n, out) != n) ok = false;
+        }
+        ok = ok && ferror(names) == 0;
+        fclose(names);
+        names = NULL;
+        remove(names_path.c_str());
+        ok = ok && write_feature_store_header(out, info) == 0;
+    }
+    
+    ok = ok && ferror(out) == 0;
+    if(fclose(out) != 0) ok = false;
+    out = NULL;
+    if(!ok) {
+        printf("Error: failed writing %s\n", path.c_str());
+        return -1;
+    }
+    return row_count;
+}
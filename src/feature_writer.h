@@ -0,0 +1,117 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the buffered feature writer (CSV or binary feature store, ordered multi-threaded rows)
+*/
+
+#ifndef FEATURE_WRITER_H
+#define FEATURE_WRITER_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+
+enum FeatureWriterFormat {
+    FEATURE_WRITER_CSV = 0,      // same lines as append_image_data_csv (name,%.4f,...)
+    FEATURE_WRITER_STORE = 1     // binary feature store, row-major (see feature_store.h)
+};
+
+// Output buffered before each fwrite
+#define FEATURE_WRITER_BUFFER (4 << 20)
+
+// Rows that may wait for an earlier row before submit() blocks
+#define FEATURE_WRITER_MAX_PENDING 4096
+
+/*
+  Feature file writer
+  Keeps one file open, formats rows with a fixed-point formatter (each value
+  rounded to 1/10000 with llrint and printed as integer digits; only huge
+  values and inf/nan go through floating-point std::to_chars) with no locale
+  or printf parsing, and hands the device large writes. Rows carry a sequence number:
+  extraction threads submit() them in any order and they reach the file in
+  sequence order, so the output is the same whatever the thread count.
+  Formatting happens on the submitting thread, outside the lock.
+*/
+class FeatureWriter {
+public:
+    FeatureWriter();
+    ~FeatureWriter();
+
+    /*
+      Create (truncate) the output file
+      Returns 0 on success, -1 on error
+    */
+    int open(const char *path, int format = FEATURE_WRITER_CSV, size_t buffer_bytes = FEATURE_WRITER_BUFFER);
+
+    /*
+      Row number seq, from any thread. Every seq from 0 up must be submitted
+      or skipped exactly once. In store mode the first row sets the dimension
+      and rows of any other length are dropped (counted in skipped()).
+      Returns 0 on success, -1 after a write error
+    */
+    int submit(uint64_t seq, const std::string &name, const std::vector<float> &values);
+
+    /*
+      Give up row number seq (e.g. the image failed to decode) so later rows are not held back
+    */
+    void skip(uint64_t seq);
+
+    /*
+      Next row in call order, for a single producer (do not mix with submit)
+    */
+    int write(const std::string &name, const std::vector<float> &values);
+
+    /*
+      Flush, append the names and header of a feature store, and close
+      Returns the number of rows written, -1 on error
+    */
+    int64_t close();
+
+    uint64_t rows() const { return row_count; }
+    uint64_t skipped() const { return skipped_count; }
+    uint64_t bytes() const { return byte_count; }
+
+private:
+    struct Row {
+        std::string data;     // CSV line, or the raw floats in store mode
+        std::string name;     // store mode only
+        bool skip = false;
+    };
+
+    FILE *out = NULL;
+    FILE *names = NULL;       // store mode: names spooled until close()
+    std::string path;
+    std::string names_path;
+    int format = FEATURE_WRITER_CSV;
+    int dim = 0;
+    bool failed = false;
+
+    std::vector<char> buffer;
+    size_t buffer_used = 0;
+    uint64_t row_count = 0;
+    uint64_t skipped_count = 0;
+    uint64_t byte_count = 0;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    uint64_t next_seq = 0;                    // next row to reach the file
+    std::atomic<uint64_t> write_seq{0};       // next row number handed out by write()
+    std::map<uint64_t, Row> pending;          // rows that arrived ahead of next_seq
+
+    void emit(Row &row);
+    void append(const char *data, size_t length);
+    bool flush();
+    int finish(Row &row, uint64_t seq);
+};
+
+/*
+  Format one CSV row (name, then ",%.4f" per value, newline) onto line
+*/
+void format_feature_csv_row(const std::string &name, const std::vector<float> &values, std::string &line);
+
+#endif
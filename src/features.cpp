@@ -7,6 +7,67 @@
 #include <opencv2/opencv.hpp>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Pixel count from which one image is split into row stripes across threads
+static long long parallel_min_pixels = 2000000;
+
+void set_parallel_extraction_pixels(long long pixels) {
+    parallel_min_pixels = pixels;
+}
+
+long long parallel_extraction_pixels() {
+    return parallel_min_pixels;
+}
+
+/*
+  Number of row stripes to extract an image in: 1 below the pixel threshold,
+  otherwise one per OpenCV thread, keeping at least 16 rows per stripe
+*/
+static int extraction_stripes(const cv::Mat &src) {
+    if(parallel_min_pixels <= 0 || (long long)src.rows * src.cols < parallel_min_pixels) {
+        return 1;
+    }
+    return std::max(1, std::min(cv::getNumThreads(), src.rows / 16));
+}
+
+/*
+  Run fn(stripe, first_row, end_row) for every row stripe, in parallel when there is more than one
+  Stripe s covers rows [s * rows / stripes, (s + 1) * rows / stripes)
+*/
+template <typename StripeFn>
+static void for_each_row_stripe(int rows, int stripes, StripeFn fn) {
+    if(stripes <= 1) {
+        fn(0, 0, rows);
+        return;
+    }
+    cv::parallel_for_(cv::Range(0, stripes), [&](const cv::Range &range) {
+        for(int s = range.start; s < range.end; s++) {
+            fn(s, (int)((long long)s * rows / stripes), (int)((long long)(s + 1) * rows / stripes));
+        }
+    }, stripes);
+}
+
+/*
+  Sum of |filter responses| over rows [y0, y1) of a float image
+  filter maps an image block to its response; it is run on the stripe plus halo rows on each side,
+  with borders isolated to the block, so the stripe rows match filtering the whole image
+*/
+template <typename FilterFn>
+static double stripe_abs_response(const cv::Mat &img, int y0, int y1, int halo, FilterFn filter) {
+    int a = std::max(0, y0 - halo);
+    int b = std::min(img.rows, y1 + halo);
+    cv::Mat response = filter(img.rowRange(a, b));
+    return cv::sum(cv::abs(response.rowRange(y0 - a, y1 - a)))[0];
+}
 
 /*
   Extract 7x7 baseline feature from center of image
@@ -54,30 +115,43 @@ int histogram_feature(cv::Mat &src, std::vector<float> &feature) {
     feature.clear();
     
     // Initialize histogram with 512 bins (8x8x8), all zeros
+    // Large images are counted in row stripes, each into its own histogram
     int bins_per_channel = 8;
     int total_bins = bins_per_channel * bins_per_channel * bins_per_channel;
-    std::vector<int> histogram(total_bins, 0);
+    int stripes = extraction_stripes(src);
+    std::vector<int> stripe_hist(stripes * total_bins, 0);
     
     // Count pixels in each bin
-    int total_pixels = 0;
-    for(int i = 0; i < src.rows; i++) {
-        for(int j = 0; j < src.cols; j++) {
-            cv::Vec3b pixel = src.at<cv::Vec3b>(i, j);
-            
-            // Map pixel values [0-255] to bin indices [0-7]
-            int b_bin = pixel[0] / 32;  // Blue:  0-255 -> 0-7
-            int g_bin = pixel[1] / 32;  // Green: 0-255 -> 0-7
-            int r_bin = pixel[2] / 32;  // Red:   0-255 -> 0-7
-            
-            // Compute 1D index from 3D bins
-            int bin_index = r_bin * bins_per_channel * bins_per_channel + 
-                           g_bin * bins_per_channel + 
-                           b_bin;
-            
-            histogram[bin_index]++;
-            total_pixels++;
+    for_each_row_stripe(src.rows, stripes, [&](int stripe, int first_row, int end_row) {
+        int *hist = &stripe_hist[stripe * total_bins];
+        for(int i = first_row; i < end_row; i++) {
+            const cv::Vec3b *row = src.ptr<cv::Vec3b>(i);
+            for(int j = 0; j < src.cols; j++) {
+                const cv::Vec3b &pixel = row[j];
+                
+                // Map pixel values [0-255] to bin indices [0-7]
+                int b_bin = pixel[0] / 32;  // Blue:  0-255 -> 0-7
+                int g_bin = pixel[1] / 32;  // Green: 0-255 -> 0-7
+                int r_bin = pixel[2] / 32;  // Red:   0-255 -> 0-7
+                
+                // Compute 1D index from 3D bins
+                int bin_index = r_bin * bins_per_channel * bins_per_channel + 
+                               g_bin * bins_per_channel + 
+                               b_bin;
+                
+                hist[bin_index]++;
+            }
+        }
+    });
+    
+    // Reduce the stripe histograms
+    std::vector<int> histogram(stripe_hist.begin(), stripe_hist.begin() + total_bins);
+    for(int s = 1; s < stripes; s++) {
+        for(int i = 0; i < total_bins; i++) {
+            histogram[i] += stripe_hist[s * total_bins + i];
         }
     }
+    int total_pixels = src.rows * src.cols;
     
     // Normalize histogram by total pixel count
     for(int i = 0; i < total_bins; i++) {
@@ -96,46 +170,15 @@ int histogram_feature_hsv(cv::Mat &src, std::vector<float> &feature) {
     // Clear feature vector
     feature.clear();
     
-    // Convert BGR to HSV
-    cv::Mat hsv;
-    cv::cvtColor(src, hsv, cv::COLOR_BGR2HSV);
-    
-    // Initialize histogram with 128 bins (8x4x4), all zeros
-    int h_bins = 8;   // Hue: 0-179 -> 8 bins
-    int s_bins = 4;   // Saturation: 0-255 -> 4 bins
-    int v_bins = 4;   // Value: 0-255 -> 4 bins
-    int total_bins = h_bins * s_bins * v_bins;
-    std::vector<int> histogram(total_bins, 0);
-    
-    // Count pixels in each bin
-    int total_pixels = 0;
-    for(int i = 0; i < hsv.rows; i++) {
-        for(int j = 0; j < hsv.cols; j++) {
-            cv::Vec3b pixel = hsv.at<cv::Vec3b>(i, j);
-            
-            // Map HSV values to bin indices
-            // OpenCV: H is 0-179, S is 0-255, V is 0-255
-            int h_bin = pixel[0] / 23;  // Hue: 0-179 -> 0-7 (179/23 ≈ 7.8)
-            int s_bin = pixel[1] / 64;  // Saturation: 0-255 -> 0-3
-            int v_bin = pixel[2] / 64;  // Value: 0-255 -> 0-3
-            
-            // Clamp to valid range (just in case)
-            if(h_bin >= h_bins) h_bin = h_bins - 1;
-            if(s_bin >= s_bins) s_bin = s_bins - 1;
-            if(v_bin >= v_bins) v_bin = v_bins - 1;
-            
-            // Compute 1D index from 3D bins
-            int bin_index = h_bin * s_bins * v_bins + 
-                           s_bin * v_bins + 
-                           v_bin;
-            
-            histogram[bin_index]++;
-            total_pixels++;
-        }
+    // Count pixels in each of the 128 bins (8x4x4) straight from BGR
+    int histogram[128];
+    if(hsv_histogram_counts(src, hue_bin_23, histogram) != 0) {
+        return -1;
     }
     
     // Normalize histogram by total pixel count
-    for(int i = 0; i < total_bins; i++) {
+    int total_pixels = src.rows * src.cols;
+    for(int i = 0; i < 128; i++) {
         feature.push_back((float)histogram[i] / (float)total_pixels);
     }
     
@@ -183,70 +226,501 @@ void compute_histogram_roi(cv::Mat &src, std::vector<float> &histogram) {
   Concatenates both histograms (2 x 512 = 1024 features)
 */
 int multi_histogram_feature(cv::Mat &src, std::vector<float> &feature) {
-    // Clear feature vector
-    feature.clear();
+    // Top half + bottom half is a 2x1 pyramid level (split at rows / 2)
+    std::vector<PyramidGrid> grids = {{2, 1}};
+    return spatial_pyramid_feature(src, grids, feature);
+}
+
+/*
+  Shared cell-histogram loop: visits each pixel once and adds it to its own cell
+  bin_of maps a pointer to one 3-channel pixel to its histogram bin
+*/
+template <typename BinFn>
+static int accumulate_cell_counts(const cv::Mat &img, int grid_rows, int grid_cols, int total_bins, BinFn bin_of,
+                                  std::vector<int> &counts, std::vector<int> &cell_pixels) {
+    if(grid_rows <= 0 || grid_cols <= 0) {
+        counts.clear();
+        cell_pixels.clear();
+        return -1;
+    }
     
-    int mid_row = src.rows / 2;
+    int num_cells = grid_rows * grid_cols;
+    counts.assign(num_cells * total_bins, 0);
+    cell_pixels.assign(num_cells, 0);
     
-    // Extract top half
-    cv::Mat top_half = src(cv::Rect(0, 0, src.cols, mid_row));
-    compute_histogram_roi(top_half, feature);
+    // Precompute the cell column offset of every image column
+    // Column j belongs to cell c when c * cols / grid_cols <= j < (c + 1) * cols / grid_cols
+    std::vector<int> col_offset(img.cols);
+    for(int c = 0; c < grid_cols; c++) {
+        int start = (int)((long long)c * img.cols / grid_cols);
+        int end = (int)((long long)(c + 1) * img.cols / grid_cols);
+        for(int j = start; j < end; j++) {
+            col_offset[j] = c * total_bins;
+        }
+    }
     
-    // Extract bottom half
-    cv::Mat bottom_half = src(cv::Rect(0, mid_row, src.cols, src.rows - mid_row));
-    compute_histogram_roi(bottom_half, feature);
+    // Grid row offset of every image row, then pixel count of each cell
+    std::vector<int> row_offset(img.rows);
+    for(int r = 0; r < grid_rows; r++) {
+        int row_start = (int)((long long)r * img.rows / grid_rows);
+        int row_end = (int)((long long)(r + 1) * img.rows / grid_rows);
+        for(int i = row_start; i < row_end; i++) {
+            row_offset[i] = r * grid_cols * total_bins;
+        }
+        
+        for(int c = 0; c < grid_cols; c++) {
+            int col_start = (int)((long long)c * img.cols / grid_cols);
+            int col_end = (int)((long long)(c + 1) * img.cols / grid_cols);
+            cell_pixels[r * grid_cols + c] = (row_end - row_start) * (col_end - col_start);
+        }
+    }
+    
+    // Stripe 0 counts straight into counts, the others into their own copies
+    int stripes = extraction_stripes(img);
+    size_t size = counts.size();
+    std::vector<int> stripe_counts((stripes - 1) * size, 0);
+    
+    for_each_row_stripe(img.rows, stripes, [&](int stripe, int first_row, int end_row) {
+        int *cells = stripe == 0 ? &counts[0] : &stripe_counts[(stripe - 1) * size];
+        for(int i = first_row; i < end_row; i++) {
+            const uchar *row = img.ptr<uchar>(i);
+            int *row_cells = cells + row_offset[i];
+            for(int j = 0; j < img.cols; j++) {
+                row_cells[col_offset[j] + bin_of(row + 3 * j)]++;
+            }
+        }
+    });
+    
+    for(int s = 1; s < stripes; s++) {
+        const int *cells = &stripe_counts[(s - 1) * size];
+        for(size_t k = 0; k < size; k++) {
+            counts[k] += cells[k];
+        }
+    }
     
     return 0;
 }
 
 /*
-  Compute gradient magnitude histogram using Sobel filters
-  Uses 16 bins for gradient magnitude (0-255)
-  Returns normalized histogram
+  Count 3D RGB histograms for every cell of a grid_rows x grid_cols grid
+  Each pixel is visited once and added to its own cell's 512-bin histogram
 */
-int gradient_magnitude_histogram(cv::Mat &src, std::vector<float> &feature) {
-    // Clear feature vector
+int cell_histogram_counts(cv::Mat &src, int grid_rows, int grid_cols,
+                          std::vector<int> &counts, std::vector<int> &cell_pixels) {
+    return accumulate_cell_counts(src, grid_rows, grid_cols, 512,
+        [](const uchar *px) {
+            // Map pixel values [0-255] to bin indices [0-7], index = r * 64 + g * 8 + b
+            return (px[2] >> 5) * 64 + (px[1] >> 5) * 8 + (px[0] >> 5);
+        },
+        counts, cell_pixels);
+}
+
+/*
+  Division tables of OpenCV's 8-bit BGR2HSV conversion (hsv_shift = 12, hue range 180)
+  sdiv[v] = round(255 * 4096 / v), hdiv[d] = round(180 * 4096 / (6 * d)), both 0 at index 0
+*/
+struct HSVDivTables {
+    int sdiv[256];
+    int hdiv[256];
+    
+    HSVDivTables() {
+        sdiv[0] = 0;
+        hdiv[0] = 0;
+        for(int i = 1; i < 256; i++) {
+            sdiv[i] = cvRound((255 << 12) / (1.0 * i));
+            hdiv[i] = cvRound((180 << 12) / (6.0 * i));
+        }
+    }
+};
+
+static const HSVDivTables hsv_div;
+
+/*
+  HSV histogram bin of one BGR pixel without building the HSV image
+  Computes the same integer H, S and V as cv::cvtColor(COLOR_BGR2HSV); S and V are only needed
+  to 2 bits, so S is shifted straight to its bin. hue_bins maps H (0-179) to 0-7
+*/
+static inline int bgr_hsv_bin(const uchar *px, const uchar *hue_bins) {
+    int b = px[0], g = px[1], r = px[2];
+    int v = std::max(b, std::max(g, r));
+    int diff = v - std::min(b, std::min(g, r));
+    
+    int h;
+    if(v == r) h = g - b;
+    else if(v == g) h = b - r + 2 * diff;
+    else h = r - g + 4 * diff;
+    h = (h * hsv_div.hdiv[diff] + (1 << 11)) >> 12;
+    if(h < 0) h += 180;
+    
+    int s_bin = (diff * hsv_div.sdiv[v] + (1 << 11)) >> 18;
+    return hue_bins[h] * 16 + s_bin * 4 + (v >> 6);
+}
+
+/*
+  Hue bins of histogram_feature_hsv: 0-179 -> 0-7 (179/23 = 7.8, clamped)
+*/
+int hue_bin_23(int hue) {
+    return std::min(hue / 23, 7);
+}
+
+/*
+  Count an 8x4x4 HSV histogram directly from BGR rows
+*/
+int hsv_histogram_counts(const cv::Mat &src, int (*hue_bin)(int), int *counts) {
+    if(src.empty() || src.type() != CV_8UC3) return -1;
+    
+    uchar hue_bins[180];
+    for(int h = 0; h < 180; h++) {
+        hue_bins[h] = (uchar)hue_bin(h);
+    }
+    
+    int stripes = extraction_stripes(src);
+    std::vector<int> stripe_counts(stripes * 128, 0);
+    for_each_row_stripe(src.rows, stripes, [&](int stripe, int first_row, int end_row) {
+        int *hist = &stripe_counts[stripe * 128];
+        for(int i = first_row; i < end_row; i++) {
+            const uchar *row = src.ptr<uchar>(i);
+            for(int j = 0; j < src.cols; j++) {
+                hist[bgr_hsv_bin(row + 3 * j, hue_bins)]++;
+            }
+        }
+    });
+    
+    std::fill(counts, counts + 128, 0);
+    for(int s = 0; s < stripes; s++) {
+        for(int i = 0; i < 128; i++) {
+            counts[i] += stripe_counts[s * 128 + i];
+        }
+    }
+    
+    return 0;
+}
+
+/*
+  Count HSV histograms (8x4x4 = 128 bins) for every cell of a grid_rows x grid_cols grid
+  Uses the same bin mapping as histogram_feature_hsv
+*/
+int cell_histogram_counts_hsv(cv::Mat &src, int grid_rows, int grid_cols,
+                              std::vector<int> &counts, std::vector<int> &cell_pixels) {
+    uchar hue_bins[180];
+    for(int h = 0; h < 180; h++) {
+        hue_bins[h] = (uchar)hue_bin_23(h);
+    }
+    
+    return accumulate_cell_counts(src, grid_rows, grid_cols, 128,
+        [&hue_bins](const uchar *px) {
+            return bgr_hsv_bin(px, hue_bins);
+        },
+        counts, cell_pixels);
+}
+
+/*
+  Greatest common divisor, used to find the finest grid shared by all pyramid levels
+*/
+static int gcd_int(int a, int b) {
+    while(b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*
+  Compute spatial pyramid RGB histogram feature
+  The finest grid is the least common multiple of every level's rows and cols,
+  so each coarse cell is an exact block of fine cells:
+  fine boundary (i * k) * rows / (k * R) equals coarse boundary i * rows / R
+  When that grid would pass PYRAMID_MAX_SHARED_CELLS cells or the image size
+  (e.g. coprime levels "5x5,6x6,7x7" give 210x210), each level is counted on
+  its own instead, with the same cell boundaries and so the same feature
+*/
+int spatial_pyramid_feature(cv::Mat &src, const std::vector<PyramidGrid> &grids, std::vector<float> &feature) {
     feature.clear();
     
-    // Convert to grayscale
+    if(grids.empty()) {
+        return -1;
+    }
+    
+    // Finest grid shared by all levels, while it stays small
+    int fine_rows = 1;
+    int fine_cols = 1;
+    bool shared = true;
+    for(const PyramidGrid &g : grids) {
+        if(g.rows <= 0 || g.cols <= 0 || (long long)g.rows * g.cols > PYRAMID_MAX_LEVEL_CELLS) {
+            return -1;
+        }
+        if(shared) {
+            // Both factors are at most PYRAMID_MAX_LEVEL_CELLS here, so the product fits an int
+            fine_rows = fine_rows / gcd_int(fine_rows, g.rows) * g.rows;
+            fine_cols = fine_cols / gcd_int(fine_cols, g.cols) * g.cols;
+            shared = (long long)fine_rows * fine_cols <= PYRAMID_MAX_SHARED_CELLS &&
+                     fine_rows <= src.rows && fine_cols <= src.cols;
+        }
+    }
+    
+    // Single pass over the pixels
+    int total_bins = 512;
+    std::vector<int> counts, cell_pixels;
+    if(shared && cell_histogram_counts(src, fine_rows, fine_cols, counts, cell_pixels) != 0) {
+        return -1;
+    }
+    
+    // Derive every level by summing blocks of fine cells
+    std::vector<int> hist(total_bins);
+    for(const PyramidGrid &g : grids) {
+        int grid_cols = fine_cols;
+        int block_rows = fine_rows / g.rows;
+        int block_cols = fine_cols / g.cols;
+        if(!shared) {
+            // No shared grid: one pass per level, each cell its own block
+            if(cell_histogram_counts(src, g.rows, g.cols, counts, cell_pixels) != 0) {
+                return -1;
+            }
+            grid_cols = g.cols;
+            block_rows = 1;
+            block_cols = 1;
+        }
+        
+        for(int r = 0; r < g.rows; r++) {
+            for(int c = 0; c < g.cols; c++) {
+                std::fill(hist.begin(), hist.end(), 0);
+                int total_pixels = 0;
+                
+                for(int fr = r * block_rows; fr < (r + 1) * block_rows; fr++) {
+                    for(int fc = c * block_cols; fc < (c + 1) * block_cols; fc++) {
+                        int cell = fr * grid_cols + fc;
+                        const int *cell_hist = &counts[cell * total_bins];
+                        for(int b = 0; b < total_bins; b++) {
+                            hist[b] += cell_hist[b];
+                        }
+                        total_pixels += cell_pixels[cell];
+                    }
+                }
+                
+                // Normalize this region (empty regions stay all zero)
+                for(int b = 0; b < total_bins; b++) {
+                    feature.push_back(total_pixels > 0 ? (float)hist[b] / (float)total_pixels : 0.0f);
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/*
+  Parse a pyramid layout such as "1x1,2x2,4x4"
+*/
+int parse_pyramid_grids(const char *spec, std::vector<PyramidGrid> &grids) {
+    grids.clear();
+    
+    const char *p = spec;
+    while(*p != '\0') {
+        int rows = 0, cols = 0, used = 0;
+        if(sscanf(p, "%dx%d%n", &rows, &cols, &used) != 2 || rows <= 0 || cols <= 0 ||
+           (long long)rows * cols > PYRAMID_MAX_LEVEL_CELLS) {
+            return -1;
+        }
+        grids.push_back({rows, cols});
+        
+        p += used;
+        if(*p == ',') {
+            p++;
+        } else if(*p != '\0') {
+            return -1;
+        }
+    }
+    
+    return grids.empty() ? -1 : 0;
+}
+
+/*
+  Region weights for a spatial pyramid feature
+  Each level totals 1.0, split evenly over its cells
+*/
+void spatial_pyramid_weights(const std::vector<PyramidGrid> &grids, std::vector<float> &weights) {
+    weights.clear();
+    for(const PyramidGrid &g : grids) {
+        int cells = g.rows * g.cols;
+        for(int i = 0; i < cells; i++) {
+            weights.push_back(1.0f / (float)cells);
+        }
+    }
+}
+
+/*
+  Reflect an index past either end of [0, n) the way cv::BORDER_REFLECT_101 does (Sobel's default)
+*/
+static inline int reflect_101(int i, int n) {
+    if(n == 1) return 0;
+    if(i < 0) return -i;
+    if(i >= n) return 2 * n - 2 - i;
+    return i;
+}
+
+/*
+  Integer 3x3 Sobel dx and dy of one gray row, given the rows above and below it
+  vs and vd need cols + 2 entries: the vertical smoothing (above + 2 * row + below) and
+  difference (below - above) of every column, with one reflected column on each side
+  Results are exactly those of cv::Sobel(gray, CV_16S / CV_32F, ..., 3)
+*/
+static void sobel_row(const uchar *above, const uchar *row, const uchar *below, int cols,
+                      short *vs, short *vd, short *dx, short *dy) {
+    int x = 0;
+    
+    // Vertical pass
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for(; x + 8 <= cols; x += 8) {
+        __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(above + x)), zero);
+        __m128i r = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(row + x)), zero);
+        __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(below + x)), zero);
+        _mm_storeu_si128((__m128i *)(vs + 1 + x), _mm_add_epi16(_mm_add_epi16(a, b), _mm_add_epi16(r, r)));
+        _mm_storeu_si128((__m128i *)(vd + 1 + x), _mm_sub_epi16(b, a));
+    }
+#elif defined(__ARM_NEON)
+    for(; x + 8 <= cols; x += 8) {
+        int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(above + x)));
+        int16x8_t r = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row + x)));
+        int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(below + x)));
+        vst1q_s16(vs + 1 + x, vaddq_s16(vaddq_s16(a, b), vshlq_n_s16(r, 1)));
+        vst1q_s16(vd + 1 + x, vsubq_s16(b, a));
+    }
+#endif
+    for(; x < cols; x++) {
+        vs[1 + x] = (short)(above[x] + 2 * row[x] + below[x]);
+        vd[1 + x] = (short)(below[x] - above[x]);
+    }
+    vs[0] = vs[1 + reflect_101(-1, cols)];
+    vd[0] = vd[1 + reflect_101(-1, cols)];
+    vs[cols + 1] = vs[1 + reflect_101(cols, cols)];
+    vd[cols + 1] = vd[1 + reflect_101(cols, cols)];
+    
+    // Horizontal pass: dx = [-1 0 1] on the smoothing, dy = [1 2 1] on the difference
+    x = 0;
+#if defined(__SSE2__)
+    for(; x + 8 <= cols; x += 8) {
+        __m128i s0 = _mm_loadu_si128((const __m128i *)(vs + x));
+        __m128i s2 = _mm_loadu_si128((const __m128i *)(vs + x + 2));
+        __m128i d0 = _mm_loadu_si128((const __m128i *)(vd + x));
+        __m128i d1 = _mm_loadu_si128((const __m128i *)(vd + x + 1));
+        __m128i d2 = _mm_loadu_si128((const __m128i *)(vd + x + 2));
+        _mm_storeu_si128((__m128i *)(dx + x), _mm_sub_epi16(s2, s0));
+        _mm_storeu_si128((__m128i *)(dy + x), _mm_add_epi16(_mm_add_epi16(d0, d2), _mm_add_epi16(d1, d1)));
+    }
+#elif defined(__ARM_NEON)
+    for(; x + 8 <= cols; x += 8) {
+        int16x8_t d1 = vld1q_s16(vd + x + 1);
+        vst1q_s16(dx + x, vsubq_s16(vld1q_s16(vs + x + 2), vld1q_s16(vs + x)));
+        vst1q_s16(dy + x, vaddq_s16(vaddq_s16(vld1q_s16(vd + x), vld1q_s16(vd + x + 2)), vshlq_n_s16(d1, 1)));
+    }
+#endif
+    for(; x < cols; x++) {
+        dx[x] = (short)(vs[x + 2] - vs[x]);
+        dy[x] = (short)(vd[x] + 2 * vd[x + 1] + vd[x + 2]);
+    }
+}
+
+/*
+  Sobel magnitude and direction histograms of an image in one row-streaming pass
+  Only three gray rows and a few short row buffers are live at a time; no gradient images are built
+*/
+int gradient_histogram_counts(const cv::Mat &src, int *magnitude_counts, int *direction_counts) {
+    if(src.empty()) return -1;
+    
     cv::Mat gray;
     if(src.channels() == 3) {
         cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
     } else {
-        gray = src.clone();
+        gray = src;
     }
     
-    // Compute Sobel gradients
-    cv::Mat grad_x, grad_y;
-    cv::Sobel(gray, grad_x, CV_16S, 1, 0, 3);  // dx
-    cv::Sobel(gray, grad_y, CV_16S, 0, 1, 3);  // dy
-    
-    // Compute gradient magnitude
-    cv::Mat abs_grad_x, abs_grad_y;
-    cv::convertScaleAbs(grad_x, abs_grad_x);
-    cv::convertScaleAbs(grad_y, abs_grad_y);
+    int rows = gray.rows;
+    int cols = gray.cols;
+    bool want_magnitude = magnitude_counts != NULL;
+    bool want_direction = direction_counts != NULL;
     
-    cv::Mat magnitude;
-    cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, magnitude);
+    // Row stripes read their halo rows straight from the gray image, so every stripe
+    // sees exactly the gradients of a whole-image pass
+    const int bins = GRADIENT_MAGNITUDE_BINS + GRADIENT_DIRECTION_BINS;
+    int stripes = extraction_stripes(gray);
+    std::vector<int> stripe_counts(stripes * bins, 0);
     
-    // Build histogram with 16 bins
-    int num_bins = 16;
-    std::vector<int> histogram(num_bins, 0);
-    
-    int total_pixels = 0;
-    for(int i = 0; i < magnitude.rows; i++) {
-        for(int j = 0; j < magnitude.cols; j++) {
-            int mag_value = magnitude.at<uchar>(i, j);
-            int bin_index = mag_value / 16;  // 0-255 -> 0-15
-            if(bin_index >= num_bins) bin_index = num_bins - 1;
+    for_each_row_stripe(rows, stripes, [&](int stripe, int first_row, int end_row) {
+        int *mag_hist = &stripe_counts[stripe * bins];
+        int *dir_hist = mag_hist + GRADIENT_MAGNITUDE_BINS;
+        
+        std::vector<short> buffer(4 * (cols + 2));
+        short *vs = &buffer[0];
+        short *vd = vs + (cols + 2);
+        short *dx = vd + (cols + 2);
+        short *dy = dx + (cols + 2);
+        
+        for(int y = first_row; y < end_row; y++) {
+            sobel_row(gray.ptr<uchar>(reflect_101(y - 1, rows)), gray.ptr<uchar>(y),
+                      gray.ptr<uchar>(reflect_101(y + 1, rows)), cols, vs, vd, dx, dy);
             
-            histogram[bin_index]++;
-            total_pixels++;
+            for(int x = 0; x < cols; x++) {
+                int gx = dx[x];
+                int gy = dy[x];
+                int ax = gx < 0 ? -gx : gx;
+                int ay = gy < 0 ? -gy : gy;
+                
+                if(want_magnitude) {
+                    // convertScaleAbs saturates to 255; addWeighted(0.5, 0.5) rounds halves to even
+                    int s = std::min(ax, 255) + std::min(ay, 255);
+                    int h = s >> 1;
+                    int mag = h + (s & h & 1);
+                    mag_hist[mag >> 4]++;
+                }
+                
+                if(want_direction && ax + ay >= 20) {
+                    // Octant of atan2(dy, dx) in [0, 2pi) from the signs and |dy| vs |dx|;
+                    // the upper half includes angle 0, the lower half angle pi
+                    int bin;
+                    if(gy > 0 || (gy == 0 && gx > 0)) {
+                        bin = gx > 0 ? (ay < ax ? 0 : 1) : (ay > ax ? 2 : 3);
+                    } else {
+                        bin = gx < 0 ? (ay < ax ? 4 : 5) : (ay > ax ? 6 : 7);
+                    }
+                    dir_hist[bin]++;
+                }
+            }
         }
+    });
+    
+    // Reduce the stripe histograms
+    for(int i = 0; i < GRADIENT_MAGNITUDE_BINS && want_magnitude; i++) {
+        magnitude_counts[i] = 0;
+        for(int s = 0; s < stripes; s++) magnitude_counts[i] += stripe_counts[s * bins + i];
+    }
+    for(int i = 0; i < GRADIENT_DIRECTION_BINS && want_direction; i++) {
+        direction_counts[i] = 0;
+        for(int s = 0; s < stripes; s++) direction_counts[i] += stripe_counts[s * bins + GRADIENT_MAGNITUDE_BINS + i];
+    }
+    
+    return 0;
+}
+
+/*
+  Compute gradient magnitude histogram using Sobel filters
+  Uses 16 bins for gradient magnitude (0-255)
+  Returns normalized histogram
+*/
+int gradient_magnitude_histogram(cv::Mat &src, std::vector<float> &feature) {
+    // Clear feature vector
+    feature.clear();
+    
+    // Bin (|dx| + |dy|) / 2 of the 3x3 Sobel gradients
+    int histogram[GRADIENT_MAGNITUDE_BINS];
+    if(gradient_histogram_counts(src, histogram, NULL) != 0) {
+        return -1;
     }
     
     // Normalize
-    for(int i = 0; i < num_bins; i++) {
+    int total_pixels = src.rows * src.cols;
+    for(int i = 0; i < GRADIENT_MAGNITUDE_BINS; i++) {
         feature.push_back((float)histogram[i] / (float)total_pixels);
     }
     
@@ -349,23 +823,35 @@ int laws_texture_feature(cv::Mat &src, std::vector<float> &feature) {
     std::vector<cv::Mat> kernels_v = {L5.t(), E5.t(), S5.t()};  // Transpose for vertical
     
     // Apply all 9 filter combinations using separable filters
-    for(int i = 0; i < 3; i++) {
-        for(int j = 0; j < 3; j++) {
-            cv::Mat temp, result;
-            
-            // Apply horizontal filter
-            cv::filter2D(gray_float, temp, CV_32F, kernels_h[j]);
-            
-            // Apply vertical filter
-            cv::filter2D(temp, result, CV_32F, kernels_v[i]);
-            
-            // Compute energy (mean absolute value)
-            cv::Mat abs_result;
-            abs_result = cv::abs(result);
-            cv::Scalar mean_energy = cv::mean(abs_result);
-            
-            feature.push_back(mean_energy[0]);
+    // Large images are filtered in row stripes with 2 halo rows for the 5-tap vertical pass
+    int stripes = extraction_stripes(gray_float);
+    std::vector<double> energy(stripes * 9, 0.0);
+    
+    for_each_row_stripe(gray_float.rows, stripes, [&](int stripe, int first_row, int end_row) {
+        for(int i = 0; i < 3; i++) {
+            for(int j = 0; j < 3; j++) {
+                energy[stripe * 9 + i * 3 + j] = stripe_abs_response(gray_float, first_row, end_row, 2,
+                    [&](const cv::Mat &block) {
+                        cv::Mat temp, result;
+                        
+                        // Apply horizontal filter
+                        cv::filter2D(block, temp, CV_32F, kernels_h[j], cv::Point(-1, -1), 0,
+                                     cv::BORDER_DEFAULT | cv::BORDER_ISOLATED);
+                        
+                        // Apply vertical filter
+                        cv::filter2D(temp, result, CV_32F, kernels_v[i]);
+                        return result;
+                    });
+            }
         }
+    });
+    
+    // Compute energy (mean absolute value) over the whole image
+    double total_pixels = (double)gray_float.rows * gray_float.cols;
+    for(int k = 0; k < 9; k++) {
+        double sum = 0.0;
+        for(int s = 0; s < stripes; s++) sum += energy[s * 9 + k];
+        feature.push_back((float)(sum / total_pixels));
     }
     
     // Normalize features by dividing by the sum
@@ -435,11 +921,11 @@ std::vector<float> computeGaborFeatures(const cv::Mat& src) {
     // 4 orientations
     std::vector<double> thetas = {0, CV_PI/4, CV_PI/2, 3*CV_PI/4};
     
-    // Compute Gabor responses for each scale and orientation
+    // Get Gabor kernel for each scale and orientation
+    std::vector<cv::Mat> kernels;
     for (double lambda : lambdas) {
         for (double theta : thetas) {
-            // Get Gabor kernel
-            cv::Mat kernel = cv::getGaborKernel(
+            kernels.push_back(cv::getGaborKernel(
                 cv::Size(ksize, ksize), 
                 sigma, 
                 theta, 
@@ -447,18 +933,35 @@ std::vector<float> computeGaborFeatures(const cv::Mat& src) {
                 gamma, 
                 0,           // psi (phase offset)
                 CV_32F
-            );
-            
-            // Apply filter
-            cv::Mat filtered;
-            cv::filter2D(gray, filtered, CV_32F, kernel);
-            
-            // Compute mean absolute response as feature
-            cv::Scalar meanVal = cv::mean(cv::abs(filtered));
-            features.push_back(meanVal[0]);
+            ));
         }
     }
     
+    // Apply filters; large images go in row stripes with ksize / 2 halo rows
+    int numKernels = (int)kernels.size();
+    int stripes = extraction_stripes(gray);
+    std::vector<double> response(stripes * numKernels, 0.0);
+    
+    for_each_row_stripe(gray.rows, stripes, [&](int stripe, int firstRow, int endRow) {
+        for (int k = 0; k < numKernels; k++) {
+            response[stripe * numKernels + k] = stripe_abs_response(gray, firstRow, endRow, ksize / 2,
+                [&](const cv::Mat &block) {
+                    cv::Mat filtered;
+                    cv::filter2D(block, filtered, CV_32F, kernels[k], cv::Point(-1, -1), 0,
+                                 cv::BORDER_DEFAULT | cv::BORDER_ISOLATED);
+                    return filtered;
+                });
+        }
+    });
+    
+    // Compute mean absolute response as feature
+    double totalPixels = (double)gray.rows * gray.cols;
+    for (int k = 0; k < numKernels; k++) {
+        double sum = 0.0;
+        for (int s = 0; s < stripes; s++) sum += response[s * numKernels + k];
+        features.push_back((float)(sum / totalPixels));
+    }
+    
     return features;  // 12-dimensional vector
 }
 
@@ -482,31 +985,60 @@ std::vector<float> computeColorGaborFeatures(const cv::Mat& src) {
 }
 
 /**
- * Distance metric for Color+Gabor features
+ * Color and Gabor parts of the Color+Gabor distance
  * Uses histogram intersection for color, normalized L2 for Gabor
  */
-float colorGaborDistance(const std::vector<float>& f1, const std::vector<float>& f2) {
-    // Split features
-    std::vector<float> color1(f1.begin(), f1.begin() + 512);
-    std::vector<float> color2(f2.begin(), f2.begin() + 512);
-    std::vector<float> gabor1(f1.begin() + 512, f1.end());
-    std::vector<float> gabor2(f2.begin() + 512, f2.end());
-    
-    // Color distance: histogram intersection
+void colorGaborComponents(const std::vector<float>& f1, const std::vector<float>& f2,
+                          float& colorDist, float& gaborDist) {
+    // Color distance: histogram intersection over the first 512 values
     float intersection = 0.0;
     for (size_t i = 0; i < 512; i++) {
-        intersection += std::min(color1[i], color2[i]);
+        intersection += std::min(f1[i], f2[i]);
     }
-    float colorDist = 1.0 - intersection;
+    colorDist = 1.0 - intersection;
     
-    // Gabor distance: normalized Euclidean
-    float gaborDist = 0.0;
-    for (size_t i = 0; i < gabor1.size(); i++) {
-        float diff = gabor1[i] - gabor2[i];
+    // Gabor distance: normalized Euclidean over the rest
+    gaborDist = 0.0;
+    for (size_t i = 512; i < f1.size(); i++) {
+        float diff = f1[i] - f2[i];
         gaborDist += diff * diff;
     }
     gaborDist = std::sqrt(gaborDist) / std::sqrt(12.0);  // Normalize by dimension
+}
+
+/**
+ * Distance metric for Color+Gabor features
+ * Weighted combination of the two parts (equal weights by default)
+ */
+float colorGaborDistance(const std::vector<float>& f1, const std::vector<float>& f2,
+                         float colorWeight, float gaborWeight) {
+    float colorDist, gaborDist;
+    colorGaborComponents(f1, f2, colorDist, gaborDist);
+    return colorWeight * colorDist + gaborWeight * gaborDist;
+}
+
+/*
+  Extract the feature of a named method
+  Dispatches to the extractor each matching program uses
+*/
+int extract_feature(const char *method, cv::Mat &src, std::vector<float> &feature) {
+    std::string name(method);
     
-    // Weighted combination (equal weights)
-    return 0.5 * colorDist + 0.5 * gaborDist;
-}
\ No newline at end of file
+    if(name == "baseline") return baseline_feature(src, feature);
+    if(name == "rgb") return histogram_feature(src, feature);
+    if(name == "hsv") return histogram_feature_hsv(src, feature);
+    if(name == "multi") return multi_histogram_feature(src, feature);
+    if(name == "color_texture") return color_texture_feature(src, feature);
+    if(name == "laws") return color_laws_texture_feature(src, feature);
+    if(name == "pyramid") {
+        std::vector<PyramidGrid> grids = {{1, 1}, {2, 2}, {4, 4}};
+        return spatial_pyramid_feature(src, grids, feature);
+    }
+    if(name == "gabor") {
+        feature = computeColorGaborFeatures(src);
+        return 0;
+    }
+    
+    feature.clear();
+    return -1;
+}
@@ -30,6 +30,19 @@ int histogram_feature(cv::Mat &src, std::vector<float> &feature);
 */
 int histogram_feature_hsv(cv::Mat &src, std::vector<float> &feature);
 
+/*
+  Count an 8x4x4 HSV histogram (128 bins, index = h * 16 + s * 4 + v) straight from BGR pixels
+  H, S and V are the values cv::cvtColor(COLOR_BGR2HSV) would give, but no HSV image is built
+  hue_bin maps an OpenCV hue (0-179) to 0-7; S and V use value / 64
+  Returns -1 unless src is a non-empty 8-bit 3-channel image
+*/
+int hsv_histogram_counts(const cv::Mat &src, int (*hue_bin)(int), int *counts);
+
+/*
+  Hue bins of histogram_feature_hsv: hue / 23, clamped to 7
+*/
+int hue_bin_23(int hue);
+
 /*
   Compute multi-resolution histogram feature
   Computes histogram for top half and bottom half of image
@@ -37,6 +50,66 @@ int histogram_feature_hsv(cv::Mat &src, std::vector<float> &feature);
 */
 int multi_histogram_feature(cv::Mat &src, std::vector<float> &feature);
 
+/*
+  One grid level of a spatial pyramid (e.g. 1x1, 2x2, 4x4 or any rows x cols)
+*/
+struct PyramidGrid {
+    int rows;
+    int cols;
+};
+
+// Most cells in one pyramid level, and in the grid shared by all levels
+#define PYRAMID_MAX_LEVEL_CELLS 1024
+#define PYRAMID_MAX_SHARED_CELLS 1024
+
+/*
+  Count 3D RGB histograms (8x8x8 = 512 bins) for every cell of a grid_rows x grid_cols grid
+  Each pixel is binned exactly once; counts holds (grid_rows * grid_cols) x 512 values, cell-major
+  Cell r covers image rows [r * rows / grid_rows, (r + 1) * rows / grid_rows), same for columns
+  cell_pixels receives the number of pixels in each cell
+*/
+int cell_histogram_counts(cv::Mat &src, int grid_rows, int grid_cols,
+                          std::vector<int> &counts, std::vector<int> &cell_pixels);
+
+/*
+  Count HSV histograms (8x4x4 = 128 bins) for every cell of a grid_rows x grid_cols grid
+  Same bin mapping as histogram_feature_hsv; same layout as cell_histogram_counts
+*/
+int cell_histogram_counts_hsv(cv::Mat &src, int grid_rows, int grid_cols,
+                              std::vector<int> &counts, std::vector<int> &cell_pixels);
+
+/*
+  Compute spatial pyramid RGB histogram feature
+  Bins every pixel once into the finest common grid and derives each level by summing cells
+  (one pass per level when that grid would be finer than PYRAMID_MAX_SHARED_CELLS or the image)
+  Output: for each grid in order, one normalized 512-bin histogram per cell (row-major)
+  Returns -1 for a level over PYRAMID_MAX_LEVEL_CELLS cells
+*/
+int spatial_pyramid_feature(cv::Mat &src, const std::vector<PyramidGrid> &grids, std::vector<float> &feature);
+
+/*
+  Parse a pyramid layout such as "1x1,2x2,4x4" into a list of grids
+  Returns 0 on success, -1 on a malformed layout or a level over PYRAMID_MAX_LEVEL_CELLS cells
+*/
+int parse_pyramid_grids(const char *spec, std::vector<PyramidGrid> &grids);
+
+/*
+  Region weights for a spatial pyramid feature
+  Every level gets the same total weight, split evenly across its cells
+*/
+void spatial_pyramid_weights(const std::vector<PyramidGrid> &grids, std::vector<float> &weights);
+
+#define GRADIENT_MAGNITUDE_BINS 16
+#define GRADIENT_DIRECTION_BINS 8
+
+/*
+  Count both 3x3 Sobel gradient histograms in one pass over the gray image
+  magnitude_counts: 16 bins of (|dx| + |dy|) / 2, as gradient_magnitude_histogram bins it
+  direction_counts: 8 bins of atan2(dy, dx) over pixels with |dx| + |dy| >= 20 (Task 7 edge feature)
+  Either output may be NULL; counts are raw pixel counts
+*/
+int gradient_histogram_counts(const cv::Mat &src, int *magnitude_counts, int *direction_counts);
+
 /*
   Compute gradient magnitude histogram using Sobel filters
   Uses 16 bins for gradient magnitude
@@ -67,5 +140,23 @@ int color_laws_texture_feature(cv::Mat &src, std::vector<float> &feature);
 // Gabor texture features (Extension 2)
 std::vector<float> computeGaborFeatures(const cv::Mat& src);
 std::vector<float> computeColorGaborFeatures(const cv::Mat& src);
-float colorGaborDistance(const std::vector<float>& f1, const std::vector<float>& f2);
+void colorGaborComponents(const std::vector<float>& f1, const std::vector<float>& f2,
+                          float& colorDist, float& gaborDist);
+float colorGaborDistance(const std::vector<float>& f1, const std::vector<float>& f2,
+                         float colorWeight = 0.5f, float gaborWeight = 0.5f);
+
+/*
+  Intra-image parallelism: images with at least this many pixels are extracted in row stripes
+  on OpenCV's thread pool (cv::parallel_for_), each stripe with its own histograms or energy sums
+  Default 2000000 (a 640x512 image stays on one core); 0 or less disables striping
+*/
+void set_parallel_extraction_pixels(long long pixels);
+long long parallel_extraction_pixels();
+
+/*
+  Extract the feature of a named method, for tools that build feature files
+  Methods: baseline, rgb, hsv, multi, pyramid (1x1,2x2,4x4), color_texture, laws, gabor
+  Returns -1 for an unknown method
+*/
+int extract_feature(const char *method, cv::Mat &src, std::vector<float> &feature);
 #endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Interactive relevance feedback: mark results relevant or irrelevant and re-rank from cached distances
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <unistd.h>
+#include <opencv2/opencv.hpp>
+#include "features.h"
+#include "retrieval_engine.h"
+#include "feedback_session.h"
+
+static void print_help() {
+    printf("Commands:\n");
+    printf("  + 2 5 pic.0100.jpg   mark results (by rank in the last list) or images (by name) relevant\n");
+    printf("  - 7                  mark irrelevant\n");
+    printf("  mode combine|move    weighted distances to the examples, or a moved query point (Rocchio)\n");
+    printf("  weights Q P N        query, relevant and irrelevant weights (default 1 0.75 0.15)\n");
+    printf("  top N                results to show\n");
+    printf("  clear                drop all marks (cached distances are kept)\n");
+    printf("  quit\n");
+}
+
+static void print_round(const FeatureDatabase &db, const FeedbackSession &session,
+                        const std::vector<std::pair<float, int>> &ranked, const FeedbackRoundStats &stats, int round) {
+    printf("\nRound %d: %lu relevant, %lu irrelevant\n", round, session.relevant().size(), session.irrelevant().size());
+    for(size_t i = 0; i < ranked.size(); i++) {
+        printf("%2lu. %s (score: %.4f)\n", i + 1, db.names[ranked[i].second].c_str(), ranked[i].first);
+    }
+    printf("New distance passes: %d (%.3f ms); re-ranked %lu images from %d cached vectors in %.3f ms\n",
+           stats.new_vectors, stats.distance_ms, db.names.size(), stats.combined_vectors, stats.combine_ms);
+    printf("Cache: %lu distance vectors, %.1f KB; a fresh run would need %lu distance passes\n",
+           session.cached_vectors(), session.cached_bytes() / 1024.0,
+           1 + session.relevant().size() + session.irrelevant().size());
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 4) {
+        printf("Usage: %s <features_csv> <target> <method> [N] [--mode combine|move] [--weights Q,P,N]\n", argv[0]);
+        printf("  target: a name in the feature file, or an image file (features extracted with method)\n");
+        printf("  method: baseline, rgb, hsv, multi, pyramid, color_texture, laws, gabor, dnn\n");
+        printf("  Feedback commands are read from stdin, one per line ('help' lists them)\n");
+        printf("Example: ./feedback_query olympus_rgb.csv pic.0164.jpg rgb 10\n");
+        printf("         printf '+ 1 3\\n- 2\\n' | ./feedback_query olympus_rgb.csv pic.0164.jpg rgb 10\n");
+        return -1;
+    }
+    
+    const char *features_csv = argv[1];
+    const char *target = argv[2];
+    const char *method_name = argv[3];
+    int top = 10;
+    FeedbackMode mode = FEEDBACK_COMBINE;
+    FeedbackWeights weights;
+    for(int i = 4; i < argc; i++) {
+        if(i + 1 < argc && strcmp(argv[i], "--mode") == 0) {
+            i++;
+            if(strcmp(argv[i], "combine") != 0 && strcmp(argv[i], "move") != 0) {
+                printf("Error: mode must be 'combine' or 'move'\n");
+                return -1;
+            }
+            mode = strcmp(argv[i], "move") == 0 ? FEEDBACK_MOVE : FEEDBACK_COMBINE;
+        } else if(i + 1 < argc && strcmp(argv[i], "--weights") == 0) {
+            i++;
+            if(sscanf(argv[i], "%f,%f,%f", &weights.query, &weights.positive, &weights.negative) != 3) {
+                printf("Error: --weights takes Q,P,N\n");
+                return -1;
+            }
+        } else if(argv[i][0] != '-') {
+            top = atoi(argv[i]);
+        } else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    const RetrievalMethod *method = find_retrieval_method(method_name);
+    if(!method) {
+        printf("Error: Unknown method %s\n", method_name);
+        return -1;
+    }
+    FeatureDatabase db;
+    if(load_feature_database(features_csv, db) != 0) {
+        return -1;
+    }
+    
+    // Query: a row of the feature file, or the features of an image file (its row, if any, is left out)
+    std::vector<float> query;
+    int query_row = -1;
+    std::string base = target;
+    if(base.find_last_of('/') != std::string::npos) base = base.substr(base.find_last_of('/') + 1);
+    auto found = db.rows.find(base);
+    if(found != db.rows.end()) query_row = found->second;
+    cv::Mat img = cv::imread(target);
+    if(img.empty() || extract_feature(method_name, img, query) != 0) {
+        if(query_row < 0) {
+            printf("Error: %s is neither a readable image nor a name in %s\n", target, features_csv);
+            return -1;
+        }
+        query = db.features[query_row];
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    FeedbackSession session(db, *method);
+    if(session.set_query(query, query_row) != 0) {
+        return -1;
+    }
+    double setup_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Session: %s, %s, %lu images (query distances in %.3f ms)\n", features_csv, method_name,
+           db.names.size(), setup_ms);
+    
+    std::vector<std::pair<float, int>> ranked;
+    FeedbackRoundStats stats;
+    int round = 0;
+    if(session.rank(mode, weights, top, ranked, stats) != 0) {
+        return -1;
+    }
+    print_round(db, session, ranked, stats, round);
+    
+    bool interactive = isatty(STDIN_FILENO);
+    char line[4096];
+    for(;;) {
+        if(interactive) {
+            printf("feedback> ");
+            fflush(stdout);
+        }
+        if(!fgets(line, sizeof(line), stdin)) break;
+        
+        std::istringstream in(line);
+        std::string command;
+        if(!(in >> command)) continue;
+        
+        if(command == "quit" || command == "q") {
+            break;
+        } else if(command == "help") {
+            print_help();
+            continue;
+        } else if(command == "+" || command == "-") {
+            // Ranks refer to the list printed last
+            std::string item;
+            while(in >> item) {
+                int row = -1;
+                int rank = atoi(item.c_str());
+                auto named = db.rows.find(item);
+                if(named != db.rows.end()) row = named->second;
+                else if(rank >= 1 && rank <= (int)ranked.size()) row = ranked[rank - 1].second;
+                if(row < 0 || session.mark(row, command == "+") != 0) {
+                    printf("Ignoring %s: not a listed rank or an image name (or it is the query)\n", item.c_str());
+                }
+            }
+        } else if(command == "mode") {
+            std::string m;
+            in >> m;
+            if(m != "combine" && m != "move") {
+                printf("Usage: mode combine|move\n");
+                continue;
+            }
+            mode = m == "move" ? FEEDBACK_MOVE : FEEDBACK_COMBINE;
+        } else if(command == "weights") {
+            FeedbackWeights w;
+            if(!(in >> w.query >> w.positive >> w.negative)) {
+                printf("Usage: weights Q P N\n");
+                continue;
+            }
+            weights = w;
+        } else if(command == "top") {
+            int n;
+            if(in >> n && n > 0) top = n;
+        } else if(command == "clear") {
+            session.clear_feedback();
+        } else {
+            printf("Unknown command %s ('help' lists them)\n", command.c_str());
+            continue;
+        }
+        
+        round++;
+        if(session.rank(mode, weights, top, ranked, stats) != 0) {
+            continue;
+        }
+        print_round(db, session, ranked, stats, round);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of relevance-feedback sessions: cached distance vectors, combined and moved-query re-ranking
+*/
+
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "feedback_session.h"
+#include "distance.h"
+
+// Images per tile of the combining pass (the output tile stays in L1)
+#define COMBINE_TILE 2048
+
+void combine_distance_vectors(const std::vector<const float *> &vectors, const std::vector<float> &weights,
+                              size_t count, float *out) {
+    for(size_t start = 0; start < count; start += COMBINE_TILE) {
+        size_t end = std::min(count, start + COMBINE_TILE);
+        std::fill(out + start, out + end, 0.0f);
+        for(size_t j = 0; j < vectors.size(); j++) {
+            const float *d = vectors[j];
+            float w = weights[j];
+            for(size_t i = start; i < end; i++) {
+                out[i] += w * d[i];
+            }
+        }
+    }
+}
+
+FeedbackSession::FeedbackSession(const FeatureDatabase &db, const RetrievalMethod &method)
+    : db(db), method(method), count(db.features.size()), dim(0) {
+    if(count > 0) dim = db.features[0].size();
+    
+    // Blocked copy for the batched kernel, when every row has the same length
+    bool uniform = dim > 0;
+    for(size_t i = 0; uniform && i < count; i++) uniform = (int)db.features[i].size() == dim;
+    if(method.block_distance && uniform) {
+        std::vector<float> rows(count * dim);
+        for(size_t i = 0; i < count; i++) {
+            std::copy(db.features[i].begin(), db.features[i].end(), rows.begin() + i * dim);
+        }
+        size_t num_blocks = (count + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+        blocks.resize(num_blocks * FEATURE_BLOCK * dim);
+        transpose_to_blocks(rows.data(), count, dim, blocks.data());
+    }
+}
+
+/*
+  Distances from one point to every image: one pass over the features
+*/
+void FeedbackSession::distances_from(const float *point, std::vector<float> &distances) const {
+    if(!blocks.empty()) {
+        size_t num_blocks = (count + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+        distances.resize(num_blocks * FEATURE_BLOCK);
+        method.block_distance(blocks.data(), num_blocks, dim, point, distances.data());
+        distances.resize(count);
+        return;
+    }
+    std::vector<float> p(point, point + dim);
+    distances.resize(count);
+    for(size_t i = 0; i < count; i++) {
+        distances[i] = method.distance(p, db.features[i]);
+    }
+}
+
+const std::vector<float> &FeedbackSession::example_distances(int row, FeedbackRoundStats &stats) {
+    auto it = cache.find(row);
+    if(it != cache.end()) return it->second;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<float> &distances = cache[row];
+    distances_from(db.features[row].data(), distances);
+    stats.distance_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.new_vectors++;
+    return distances;
+}
+
+int FeedbackSession::set_query(const std::vector<float> &query, int row) {
+    if((int)query.size() != dim) {
+        printf("Error: query has %lu values, the features have %d\n", query.size(), dim);
+        return -1;
+    }
+    this->query = query;
+    query_row = row;
+    clear_feedback();
+    distances_from(this->query.data(), query_distances);
+    return 0;
+}
+
+int FeedbackSession::mark(int row, bool relevant) {
+    if(row < 0 || row >= (int)count || row == query_row) return -1;
+    positives.erase(std::remove(positives.begin(), positives.end(), row), positives.end());
+    negatives.erase(std::remove(negatives.begin(), negatives.end(), row), negatives.end());
+    (relevant ? positives : negatives).push_back(row);
+    return 0;
+}
+
+void FeedbackSession::clear_feedback() {
+    positives.clear();
+    negatives.clear();
+}
+
+int FeedbackSession::rank(FeedbackMode mode, const FeedbackWeights &weights, int depth,
+                          std::vector<std::pair<float, int>> &ranked, FeedbackRoundStats &stats) {
+    stats = FeedbackRoundStats();
+    
+    // Distance vectors of the query and of every example, computing only the new ones
+    std::vector<const float *> vectors = {query_distances.data()};
+    std::vector<int> rows = {query_row};
+    std::vector<float> w = {weights.query};
+    for(int row : positives) {
+        vectors.push_back(example_distances(row, stats).data());
+        rows.push_back(row);
+        w.push_back(weights.positive / positives.size());
+    }
+    for(int row : negatives) {
+        vectors.push_back(example_distances(row, stats).data());
+        rows.push_back(row);
+        w.push_back(-weights.negative / negatives.size());
+    }
+    
+    std::vector<float> scores(count);
+    float offset = 0.0f;
+    if(mode == FEEDBACK_MOVE) {
+        // Weights of the moved point sum to 1
+        float total = 0.0f;
+        for(float x : w) total += x;
+        if(std::fabs(total) < 1e-6f) {
+            printf("Error: query + positive - negative weights must not be 0\n");
+            return -1;
+        }
+        for(float &x : w) x /= total;
+        
+        if(method.distance != ssd_distance) {
+            std::vector<float> point(dim, 0.0f);
+            for(size_t j = 0; j < rows.size(); j++) {
+                const float *e = rows[j] < 0 ? query.data() : db.features[rows[j]].data();
+                for(int k = 0; k < dim; k++) point[k] += w[j] * e[k];
+            }
+            auto start = std::chrono::steady_clock::now();
+            distances_from(point.data(), scores);
+            stats.distance_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            stats.new_vectors++;
+            vectors.clear();
+        } else {
+            // Squared distances: the moved point's distance is the weighted sum
+            // minus half the weighted pairwise distances between the examples
+            for(size_t j = 0; j < rows.size(); j++) {
+                for(size_t k = j + 1; k < rows.size(); k++) {
+                    offset -= w[j] * w[k] * vectors[j][rows[k]];
+                }
+            }
+        }
+    }
+    
+    if(!vectors.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        combine_distance_vectors(vectors, w, count, scores.data());
+        if(offset != 0.0f) {
+            for(float &s : scores) s += offset;
+        }
+        stats.combine_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats.combined_vectors = vectors.size();
+    }
+    
+    // Leave out the query and the judged examples
+    std::vector<char> skip(count, 0);
+    for(int row : rows) {
+        if(row >= 0) skip[row] = 1;
+    }
+    ranked.clear();
+    ranked.reserve(count);
+    for(size_t i = 0; i < count; i++) {
+        if(!skip[i]) ranked.push_back({scores[i], (int)i});
+    }
+    size_t keep = (depth <= 0) ? ranked.size() : std::min((size_t)depth, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end());
+    ranked.resize(keep);
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for relevance-feedback sessions that re-rank from cached distance vectors
+*/
+
+#ifndef FEEDBACK_SESSION_H
+#define FEEDBACK_SESSION_H
+
+#include <vector>
+#include <map>
+#include <utility>
+#include "retrieval_engine.h"
+
+enum FeedbackMode {
+    FEEDBACK_COMBINE = 0,   // weighted distances to the query, the relevant and the irrelevant examples
+    FEEDBACK_MOVE = 1       // Rocchio: distance to a query point moved toward relevant, away from irrelevant
+};
+
+/*
+  Rocchio weights: query, mean of the relevant examples, mean of the irrelevant ones
+  combine: score = query * d(q) + positive * mean d(p) - negative * mean d(n)
+  move:    q' = (query * q + positive * mean p - negative * mean n) / (query + positive - negative)
+*/
+struct FeedbackWeights {
+    float query = 1.0f;
+    float positive = 0.75f;
+    float negative = 0.15f;
+};
+
+struct FeedbackRoundStats {
+    int new_vectors = 0;        // distance passes over the features this round
+    int combined_vectors = 0;   // cached vectors summed by the re-ranking pass
+    double distance_ms = 0.0;
+    double combine_ms = 0.0;
+};
+
+/*
+  One query refined over several rounds of feedback
+  The distances from the query and from every example ever marked to all
+  images are kept (one float per image each), so a round only computes the
+  vectors of newly marked examples and then sums cached vectors in one pass.
+  Moving the query point needs no new pass for ssd (baseline): with weights
+  summing to 1, ||sum w_j e_j - x||^2 = sum w_j ||e_j - x||^2 - 1/2 sum_jk w_j w_k ||e_j - e_k||^2.
+  Other methods compute the moved point's distances in one pass.
+*/
+class FeedbackSession {
+public:
+    FeedbackSession(const FeatureDatabase &db, const RetrievalMethod &method);
+
+    /*
+      Start over from a query vector; row is its database row (left out of
+      the results), or -1 for an outside image. Cached vectors are kept.
+    */
+    int set_query(const std::vector<float> &query, int row = -1);
+
+    /*
+      Mark a row relevant or irrelevant (replaces an earlier mark of the row)
+      Returns -1 for an invalid row or the query row
+    */
+    int mark(int row, bool relevant);
+    void clear_feedback();
+
+    /*
+      Ranked (distance, row) pairs, best first, leaving out the query row and
+      every marked example; keeps the closest depth (all if depth <= 0)
+      Returns -1 if the move weights cancel out
+    */
+    int rank(FeedbackMode mode, const FeedbackWeights &weights, int depth,
+             std::vector<std::pair<float, int>> &ranked, FeedbackRoundStats &stats);
+
+    const std::vector<int> &relevant() const { return positives; }
+    const std::vector<int> &irrelevant() const { return negatives; }
+    size_t cached_vectors() const { return cache.size() + 1; }
+    size_t cached_bytes() const { return cached_vectors() * count * sizeof(float); }
+
+private:
+    const FeatureDatabase &db;
+    const RetrievalMethod &method;
+    size_t count;
+    int dim;
+    std::vector<float> blocks;                 // blocked copy of the features if the method has a block kernel
+    std::vector<float> query;
+    int query_row = -1;
+    std::vector<float> query_distances;
+    std::map<int, std::vector<float>> cache;   // example row -> distances to every image
+    std::vector<int> positives;
+    std::vector<int> negatives;
+
+    void distances_from(const float *point, std::vector<float> &distances) const;
+    const std::vector<float> &example_distances(int row, FeedbackRoundStats &stats);
+};
+
+/*
+  out[i] = sum_j weights[j] * vectors[j][i], one pass over out in cache-sized tiles
+*/
+void combine_distance_vectors(const std::vector<const float *> &vectors, const std::vector<float> &weights,
+                              size_t count, float *out);
+
+#endif
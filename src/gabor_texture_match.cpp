@@ -11,13 +11,20 @@
 #include <filesystem>
 #include "features.h"
 #include "distance.h"
+#include "image_source.h"
 
 namespace fs = std::filesystem;
 
+// Database images are the .jpg and .jpeg files of the directory
+static bool is_jpeg_file(const char *filename) {
+    std::string ext = fs::path(filename).extension().string();
+    return ext == ".jpg" || ext == ".jpeg";
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 4) {
         std::cout << "Usage: " << argv[0] 
-                  << " <target_image> <database_dir> <N>" << std::endl;
+                  << " <target_image> <database_dir|pack> <N>" << std::endl;
         std::cout << "Example: ./gabor_texture_match src/olympus/pic.0535.jpg src/olympus 5" << std::endl;
         return -1;
     }
@@ -42,21 +49,23 @@ int main(int argc, char* argv[]) {
     // Store results: (filename, distance)
     std::vector<std::pair<std::string, float>> results;
     
-    // Process all images in database
+    // Process all images in database (directory or pack file)
+    ImageSource source;
+    if (open_image_source(dbDir.c_str(), source, is_jpeg_file) != 0) {
+        return -1;
+    }
+    
     int count = 0;
-    for (const auto& entry : fs::directory_iterator(dbDir)) {
-        if (entry.path().extension() == ".jpg" || 
-            entry.path().extension() == ".jpeg") {
-            
-            std::string imgPath = entry.path().string();
-            cv::Mat img = cv::imread(imgPath);
-            
-            if (!img.empty()) {
-                std::vector<float> imgFeats = computeColorGaborFeatures(img);
-                float dist = colorGaborDistance(targetFeats, imgFeats);
-                results.push_back({imgPath, dist});
-                count++;
-            }
+    for (int i = 0; i < source.count(); i++) {
+        cv::Mat img = read_source_image(source, i);
+        
+        if (!img.empty()) {
+            std::vector<float> imgFeats = computeColorGaborFeatures(img);
+            float dist = colorGaborDistance(targetFeats, imgFeats);
+            // Full path for a directory, as before; pack images only have a name
+            std::string imgPath = source.packed ? source.names[i] : (fs::path(dbDir) / source.names[i]).string();
+            results.push_back({imgPath, dist});
+            count++;
         }
     }
     
@@ -0,0 +1,66 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the ground-truth reader and ranking quality metrics
+*/
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include "ground_truth.h"
+
+int read_ground_truth(const char *path, std::vector<GroundTruthQuery> &queries) {
+    std::ifstream in(path);
+    if(!in) {
+        printf("Unable to open ground truth file %s\n", path);
+        return -1;
+    }
+    
+    queries.clear();
+    std::string line;
+    while(std::getline(in, line)) {
+        std::istringstream words(line);
+        GroundTruthQuery entry;
+        if(!(words >> entry.query) || entry.query[0] == '#') continue;
+        
+        std::string name;
+        while(words >> name) entry.relevant.push_back(name);
+        queries.push_back(entry);
+    }
+    
+    return 0;
+}
+
+static bool contains(const std::vector<int> &ids, int id) {
+    return std::find(ids.begin(), ids.end(), id) != ids.end();
+}
+
+float precision_at_k(const std::vector<int> &ranked, const std::vector<int> &relevant, int k) {
+    if(k <= 0) return 0.0f;
+    
+    int hits = 0;
+    int n = std::min(k, (int)ranked.size());
+    for(int i = 0; i < n; i++) {
+        if(contains(relevant, ranked[i])) hits++;
+    }
+    return (float)hits / k;
+}
+
+float average_precision(const std::vector<int> &ranked, const std::vector<int> &relevant, int k) {
+    int n = k > 0 ? std::min(k, (int)ranked.size()) : ranked.size();
+    int denom = k > 0 ? std::min(k, (int)relevant.size()) : relevant.size();
+    if(denom == 0) return 0.0f;
+    
+    int hits = 0;
+    float sum = 0.0f;
+    for(int i = 0; i < n; i++) {
+        if(contains(relevant, ranked[i])) {
+            hits++;
+            sum += (float)hits / (i + 1);
+        }
+    }
+    return sum / denom;
+}
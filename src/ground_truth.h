@@ -0,0 +1,39 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for labeled query sets and ranking quality metrics (precision@k, average precision)
+*/
+
+#ifndef GROUND_TRUTH_H
+#define GROUND_TRUTH_H
+
+#include <vector>
+#include <string>
+
+/*
+  One labeled query: the query image and the images judged relevant to it
+*/
+struct GroundTruthQuery {
+    std::string query;
+    std::vector<std::string> relevant;
+};
+
+/*
+  Read a ground-truth file: one query per line, "query rel1 rel2 ..."
+  (whitespace separated filenames; blank lines and lines starting with # are skipped)
+  Returns 0 on success, -1 if the file cannot be opened
+*/
+int read_ground_truth(const char *path, std::vector<GroundTruthQuery> &queries);
+
+/*
+  Fraction of the first k ranked ids that are relevant
+*/
+float precision_at_k(const std::vector<int> &ranked, const std::vector<int> &relevant, int k);
+
+/*
+  Average precision over the first k ranked ids (all of them if k <= 0):
+  mean of precision@i at each relevant hit, divided by min(|relevant|, k)
+*/
+float average_precision(const std::vector<int> &ranked, const std::vector<int> &relevant, int k);
+
+#endif
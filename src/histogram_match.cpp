@@ -9,10 +9,10 @@
 #include <cstring>
 #include <vector>
 #include <algorithm>
-#include <dirent.h>
 #include "features.h"
 #include "distance.h"
 #include "csv_util.h"
+#include "image_source.h"
 
 // Structure to hold image filename and its distance to target
 struct ImageMatch {
@@ -28,7 +28,7 @@ struct ImageMatch {
 int main(int argc, char *argv[]) {
     // Check arguments
     if(argc < 4) {
-        printf("Usage: %s <target_image> <image_directory> <num_matches>\n", argv[0]);
+        printf("Usage: %s <target_image> <image_directory|pack> <num_matches>\n", argv[0]);
         printf("Example: ./histogram_match data/olympus/pic.0164.jpg data/olympus 5\n");
         return -1;
     }
@@ -51,52 +51,36 @@ int main(int argc, char *argv[]) {
     printf("Target image: %s\n", target_filename);
     printf("Feature vector size: %lu\n", target_features.size());
     
-    // Open directory
-    DIR *dirp = opendir(directory);
-    if(dirp == NULL) {
-        printf("Cannot open directory %s\n", directory);
+    // Open the image directory or pack file
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
         return -1;
     }
     
     // Store all matches
     std::vector<ImageMatch> matches;
     
-    // Loop through all images in directory
-    struct dirent *dp;
-    while((dp = readdir(dirp)) != NULL) {
-        // Check if it's an image file
-        if(strstr(dp->d_name, ".jpg") || 
-           strstr(dp->d_name, ".png") || 
-           strstr(dp->d_name, ".JPG") ||
-           strstr(dp->d_name, ".PNG")) {
-            
-            // Build full path
-            char filepath[256];
-            strcpy(filepath, directory);
-            strcat(filepath, "/");
-            strcat(filepath, dp->d_name);
-            
-            // Read image
-            cv::Mat img = cv::imread(filepath);
-            if(img.empty()) {
-                continue;
-            }
-            
-            // Extract histogram features
-            std::vector<float> features;
-            histogram_feature(img, features);
-            
-            // Calculate histogram intersection distance
-            float distance = histogram_intersection_distance(target_features, features);
-            
-            // Store match
-            ImageMatch match;
-            match.filename = std::string(dp->d_name);
-            match.distance = distance;
-            matches.push_back(match);
+    // Loop through all images in the source
+    for(int i = 0; i < source.count(); i++) {
+        // Read image
+        cv::Mat img = read_source_image(source, i);
+        if(img.empty()) {
+            continue;
         }
+        
+        // Extract histogram features
+        std::vector<float> features;
+        histogram_feature(img, features);
+        
+        // Calculate histogram intersection distance
+        float distance = histogram_intersection_distance(target_features, features);
+        
+        // Store match
+        ImageMatch match;
+        match.filename = source.names[i];
+        match.distance = distance;
+        matches.push_back(match);
     }
-    closedir(dirp);
     
     // Sort matches by distance
     std::sort(matches.begin(), matches.end());
@@ -0,0 +1,161 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the Task 7 hybrid index file and single-pass weighted scoring
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "distance.h"
+#include "embedding_store.h"
+#include "hybrid_index.h"
+
+// File header: magic, then count, dnn dim, hsv dim, edge dim, stride
+static const char HYBRID_MAGIC[4] = {'H', 'Y', 'B', 'X'};
+
+void hybrid_pack_record(const float *unit_dnn, float dnn_norm, const std::vector<float> &hsv,
+                        const std::vector<float> &edge, float *record) {
+    std::fill(record, record + HYBRID_STRIDE, 0.0f);
+    std::copy(unit_dnn, unit_dnn + HYBRID_DNN_DIM, record);
+    std::copy(hsv.begin(), hsv.begin() + HYBRID_HSV_DIM, record + HYBRID_HSV_OFFSET);
+    std::copy(edge.begin(), edge.begin() + HYBRID_EDGE_DIM, record + HYBRID_EDGE_OFFSET);
+    record[HYBRID_NORM_OFFSET] = dnn_norm;
+}
+
+int write_hybrid_index(const char *path, const std::vector<std::string> &names, const std::vector<float> &records) {
+    if(records.size() != names.size() * HYBRID_STRIDE) {
+        printf("Error: %lu names but %lu record floats\n", names.size(), records.size());
+        return -1;
+    }
+    
+    FILE *fp = fopen(path, "wb");
+    if(!fp) {
+        printf("Unable to open output file %s\n", path);
+        return -1;
+    }
+    
+    int header[5] = {(int)names.size(), HYBRID_DNN_DIM, HYBRID_HSV_DIM, HYBRID_EDGE_DIM, HYBRID_STRIDE};
+    fwrite(HYBRID_MAGIC, sizeof(char), 4, fp);
+    fwrite(header, sizeof(int), 5, fp);
+    for(const std::string &name : names) {
+        int len = name.size();
+        fwrite(&len, sizeof(int), 1, fp);
+        fwrite(name.data(), sizeof(char), len, fp);
+    }
+    fwrite(records.data(), sizeof(float), records.size(), fp);
+    
+    fclose(fp);
+    return 0;
+}
+
+int read_hybrid_index(const char *path, HybridIndex &index) {
+    FILE *fp = fopen(path, "rb");
+    if(!fp) {
+        printf("Unable to open index file %s\n", path);
+        return -1;
+    }
+    
+    char magic[4];
+    int header[5];
+    if(fread(magic, sizeof(char), 4, fp) != 4 || memcmp(magic, HYBRID_MAGIC, 4) != 0 ||
+       fread(header, sizeof(int), 5, fp) != 5 || header[0] < 0 ||
+       header[1] != HYBRID_DNN_DIM || header[2] != HYBRID_HSV_DIM ||
+       header[3] != HYBRID_EDGE_DIM || header[4] != HYBRID_STRIDE) {
+        printf("Error: %s is not a hybrid index with this record layout\n", path);
+        fclose(fp);
+        return -1;
+    }
+    
+    int count = header[0];
+    bool ok = true;
+    index.names.clear();
+    for(int i = 0; i < count && ok; i++) {
+        int len = 0;
+        ok = fread(&len, sizeof(int), 1, fp) == 1 && len >= 0;
+        std::string name(ok ? len : 0, '\0');
+        ok = ok && fread(&name[0], sizeof(char), len, fp) == (size_t)len;
+        index.names.push_back(name);
+    }
+    
+    size_t total = (size_t)count * HYBRID_STRIDE;
+    free(index.records);
+    index.records = (float *)aligned_alloc(64, std::max(total, (size_t)16) * sizeof(float));
+    ok = ok && fread(index.records, sizeof(float), total, fp) == total;
+    fclose(fp);
+    
+    if(!ok) {
+        printf("Error: %s is truncated\n", path);
+        index.count = 0;
+        return -1;
+    }
+    index.count = count;
+    return 0;
+}
+
+int hybrid_index_find(const HybridIndex &index, const char *name) {
+    for(int i = 0; i < index.count; i++) {
+        if(index.names[i] == name) return i;
+    }
+    return -1;
+}
+
+/*
+  Sum of min() over n bins, four partial sums to break the dependency chain
+*/
+static float overlap(const float *a, const float *b, int n) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    int i = 0;
+    for(; i + 4 <= n; i += 4) {
+        s0 += std::min(a[i], b[i]);
+        s1 += std::min(a[i + 1], b[i + 1]);
+        s2 += std::min(a[i + 2], b[i + 2]);
+        s3 += std::min(a[i + 3], b[i + 3]);
+    }
+    for(; i < n; i++) s0 += std::min(a[i], b[i]);
+    return (s0 + s1) + (s2 + s3);
+}
+
+/*
+  Cosine distance between two records, computed as the embedding store computes it
+*/
+static float dnn_distance(const float *a, const float *b) {
+    float cos_sim = embedding_dot(a, b, HYBRID_DNN_DIM);
+    return cosine_distance_from_sums(cos_sim, a[HYBRID_NORM_OFFSET] > 0.0f ? 1.0f : 0.0f,
+                                     b[HYBRID_NORM_OFFSET] > 0.0f ? 1.0f : 0.0f);
+}
+
+float hybrid_record_distance(const float *a, const float *b, float wDNN, float wHSV, float wEDGE) {
+    float dDNN = dnn_distance(a, b);
+    float dHSV = 1.0f - overlap(a + HYBRID_HSV_OFFSET, b + HYBRID_HSV_OFFSET, HYBRID_HSV_DIM);
+    float dEDGE = 1.0f - overlap(a + HYBRID_EDGE_OFFSET, b + HYBRID_EDGE_OFFSET, HYBRID_EDGE_DIM);
+    return wDNN * dDNN + wHSV * dHSV + wEDGE * dEDGE;
+}
+
+/*
+  One pass over the records; each record is read once for all three terms
+*/
+void hybrid_distances(const HybridIndex &index, int q, float wDNN, float wHSV, float wEDGE,
+                      std::vector<float> &distances) {
+    distances.resize(index.count);
+    const float *query = index.record(q);
+    
+    for(int i = 0; i < index.count; i++) {
+        distances[i] = hybrid_record_distance(query, index.record(i), wDNN, wHSV, wEDGE);
+    }
+}
+
+void hybrid_component_distances(const HybridIndex &index, int q, std::vector<float> &components) {
+    int n = index.count;
+    components.resize((size_t)3 * n);
+    const float *query = index.record(q);
+    
+    for(int i = 0; i < n; i++) {
+        const float *rec = index.record(i);
+        components[i] = dnn_distance(query, rec);
+        components[n + i] = 1.0f - overlap(query + HYBRID_HSV_OFFSET, rec + HYBRID_HSV_OFFSET, HYBRID_HSV_DIM);
+        components[2 * n + i] = 1.0f - overlap(query + HYBRID_EDGE_OFFSET, rec + HYBRID_EDGE_OFFSET, HYBRID_EDGE_DIM);
+    }
+}
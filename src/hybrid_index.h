@@ -0,0 +1,86 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the Task 7 hybrid index (DNN + HSV + edge features in one record per image)
+*/
+
+#ifndef HYBRID_INDEX_H
+#define HYBRID_INDEX_H
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+// Record layout, in floats: normalized embedding, HSV histogram, edge
+// direction histogram, embedding norm, zero padding to a multiple of 16
+#define HYBRID_DNN_DIM 512
+#define HYBRID_HSV_DIM 128
+#define HYBRID_EDGE_DIM 8
+#define HYBRID_HSV_OFFSET HYBRID_DNN_DIM
+#define HYBRID_EDGE_OFFSET (HYBRID_HSV_OFFSET + HYBRID_HSV_DIM)
+#define HYBRID_NORM_OFFSET (HYBRID_EDGE_OFFSET + HYBRID_EDGE_DIM)
+#define HYBRID_STRIDE 656
+
+/*
+  All records in one 64-byte aligned block, so a query streams through
+  memory once and never touches the images
+*/
+struct HybridIndex {
+    int count = 0;
+    float *records = NULL;             // count x HYBRID_STRIDE
+    std::vector<std::string> names;
+
+    HybridIndex() {}
+    HybridIndex(const HybridIndex &) = delete;
+    HybridIndex &operator=(const HybridIndex &) = delete;
+    ~HybridIndex() { free(records); }
+
+    const float *record(int i) const { return records + (size_t)i * HYBRID_STRIDE; }
+};
+
+/*
+  Fill one HYBRID_STRIDE record from an L2-normalized embedding (and its
+  original norm) and the two normalized histograms
+*/
+void hybrid_pack_record(const float *unit_dnn, float dnn_norm, const std::vector<float> &hsv,
+                        const std::vector<float> &edge, float *record);
+
+/*
+  Write names and packed records (names.size() x HYBRID_STRIDE floats)
+  Returns 0 on success, -1 on error
+*/
+int write_hybrid_index(const char *path, const std::vector<std::string> &names, const std::vector<float> &records);
+
+/*
+  Read an index written by write_hybrid_index
+  Returns 0 on success, -1 on error
+*/
+int read_hybrid_index(const char *path, HybridIndex &index);
+
+/*
+  Record of a filename, -1 if it is not in the index
+*/
+int hybrid_index_find(const HybridIndex &index, const char *name);
+
+/*
+  Weighted distance between two records, the value hybrid_distances gives
+*/
+float hybrid_record_distance(const float *a, const float *b, float wDNN, float wHSV, float wEDGE);
+
+/*
+  Weighted distance from record q to every record:
+  wDNN * cosine + wHSV * HSV intersection + wEDGE * edge intersection
+  Weights are applied here, so changing them needs no rebuild.
+  Zero embeddings get cosine distance 2, as in the embedding store.
+*/
+void hybrid_distances(const HybridIndex &index, int q, float wDNN, float wHSV, float wEDGE,
+                      std::vector<float> &distances);
+
+/*
+  The three unweighted distances from record q to every record, stored
+  component-major: components[c * count + i] for c = DNN, HSV, edge
+  (for tools that try many weightings against the same query)
+*/
+void hybrid_component_distances(const HybridIndex &index, int q, std::vector<float> &components);
+
+#endif
@@ -0,0 +1,155 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the packed image container writer and mmap reader
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "image_pack.h"
+
+static const char PACK_MAGIC[4] = {'C', 'P', 'A', 'K'};
+static const size_t PACK_HEADER_SIZE = 16;
+
+ImagePack::~ImagePack() {
+    if(base) munmap((void *)base, size);
+}
+
+bool is_image_pack(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if(!fp) return false;
+    char magic[4];
+    bool match = fread(magic, sizeof(char), 4, fp) == 4 && memcmp(magic, PACK_MAGIC, 4) == 0;
+    fclose(fp);
+    return match;
+}
+
+int write_image_pack(const char *pack_path, const std::vector<std::string> &names,
+                     const std::vector<std::string> &paths) {
+    FILE *fp = fopen(pack_path, "wb");
+    if(!fp) {
+        printf("Unable to open output file %s\n", pack_path);
+        return -1;
+    }
+    
+    // Header is rewritten once the table position is known
+    unsigned char header[PACK_HEADER_SIZE] = {0};
+    fwrite(header, 1, PACK_HEADER_SIZE, fp);
+    
+    std::vector<PackEntry> entries;
+    std::vector<unsigned char> buffer;
+    uint64_t offset = PACK_HEADER_SIZE;
+    for(size_t i = 0; i < paths.size(); i++) {
+        FILE *in = fopen(paths[i].c_str(), "rb");
+        if(!in) {
+            printf("Warning: cannot read %s, skipping\n", paths[i].c_str());
+            continue;
+        }
+        fseek(in, 0, SEEK_END);
+        long length = ftell(in);
+        fseek(in, 0, SEEK_SET);
+        buffer.resize(length > 0 ? length : 0);
+        bool ok = length > 0 && fread(buffer.data(), 1, length, in) == (size_t)length;
+        fclose(in);
+        if(!ok) {
+            printf("Warning: cannot read %s, skipping\n", paths[i].c_str());
+            continue;
+        }
+        
+        fwrite(buffer.data(), 1, length, fp);
+        entries.push_back({names[i], offset, (uint64_t)length});
+        offset += length;
+    }
+    
+    uint64_t table_offset = offset;
+    for(const PackEntry &e : entries) {
+        uint32_t name_len = e.name.size();
+        fwrite(&e.offset, sizeof(uint64_t), 1, fp);
+        fwrite(&e.length, sizeof(uint64_t), 1, fp);
+        fwrite(&name_len, sizeof(uint32_t), 1, fp);
+        fwrite(e.name.data(), sizeof(char), name_len, fp);
+    }
+    
+    uint32_t count = entries.size();
+    memcpy(header, PACK_MAGIC, 4);
+    memcpy(header + 4, &count, sizeof(uint32_t));
+    memcpy(header + 8, &table_offset, sizeof(uint64_t));
+    fseek(fp, 0, SEEK_SET);
+    fwrite(header, 1, PACK_HEADER_SIZE, fp);
+    
+    bool ok = ferror(fp) == 0;
+    fclose(fp);
+    if(!ok) {
+        printf("Error: failed writing %s\n", pack_path);
+        return -1;
+    }
+    return count;
+}
+
+int open_image_pack(const char *pack_path, ImagePack &pack) {
+    int fd = open(pack_path, O_RDONLY);
+    if(fd < 0) {
+        printf("Unable to open pack file %s\n", pack_path);
+        return -1;
+    }
+    
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < PACK_HEADER_SIZE) {
+        printf("Error: %s is not a pack file\n", pack_path);
+        close(fd);
+        return -1;
+    }
+    
+    size_t size = st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) {
+        printf("Error: cannot map %s\n", pack_path);
+        return -1;
+    }
+    // Images are decoded front to back
+    madvise(map, size, MADV_SEQUENTIAL);
+    
+    if(pack.base) munmap((void *)pack.base, pack.size);
+    pack.base = (const unsigned char *)map;
+    pack.size = size;
+    pack.entries.clear();
+    
+    uint32_t count;
+    uint64_t table_offset;
+    memcpy(&count, pack.base + 4, sizeof(uint32_t));
+    memcpy(&table_offset, pack.base + 8, sizeof(uint64_t));
+    if(memcmp(pack.base, PACK_MAGIC, 4) != 0 || table_offset > size) {
+        printf("Error: %s is not a pack file\n", pack_path);
+        return -1;
+    }
+    
+    // Walk the table with bounds checks
+    size_t pos = table_offset;
+    const size_t fixed = 2 * sizeof(uint64_t) + sizeof(uint32_t);
+    for(uint32_t i = 0; i < count; i++) {
+        PackEntry e;
+        uint32_t name_len;
+        if(pos + fixed > size) break;
+        memcpy(&e.offset, pack.base + pos, sizeof(uint64_t));
+        memcpy(&e.length, pack.base + pos + 8, sizeof(uint64_t));
+        memcpy(&name_len, pack.base + pos + 16, sizeof(uint32_t));
+        pos += fixed;
+        if(pos + name_len > size || e.offset + e.length > table_offset) break;
+        e.name.assign((const char *)pack.base + pos, name_len);
+        pos += name_len;
+        pack.entries.push_back(e);
+    }
+    
+    if(pack.entries.size() != count) {
+        printf("Error: %s has a damaged table\n", pack_path);
+        return -1;
+    }
+    return 0;
+}
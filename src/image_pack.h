@@ -0,0 +1,60 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the packed image container (all encoded images in one file plus a name table)
+*/
+
+#ifndef IMAGE_PACK_H
+#define IMAGE_PACK_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/*
+  Where one encoded image lives inside the pack
+*/
+struct PackEntry {
+    std::string name;
+    uint64_t offset;
+    uint64_t length;
+};
+
+/*
+  A pack file mapped read-only into memory
+  Layout: "CPAK", u32 count, u64 table offset, the encoded images back to
+  back, then the table (u64 offset, u64 length, u32 name length, name)
+*/
+struct ImagePack {
+    const unsigned char *base = NULL;
+    size_t size = 0;
+    std::vector<PackEntry> entries;
+
+    ImagePack() {}
+    ImagePack(const ImagePack &) = delete;
+    ImagePack &operator=(const ImagePack &) = delete;
+    ~ImagePack();
+
+    const unsigned char *data(int i) const { return base + entries[i].offset; }
+};
+
+/*
+  True if the file starts with the pack magic
+*/
+bool is_image_pack(const char *path);
+
+/*
+  Concatenate the files in paths into a pack, stored under names
+  Returns the number of images written, -1 on error
+*/
+int write_image_pack(const char *pack_path, const std::vector<std::string> &names,
+                     const std::vector<std::string> &paths);
+
+/*
+  mmap a pack and read its table (one open, one mmap; images are then read
+  straight from the mapping)
+  Returns 0 on success, -1 on error
+*/
+int open_image_pack(const char *pack_path, ImagePack &pack);
+
+#endif
@@ -0,0 +1,273 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of image read-ahead with io_uring or pread worker threads
+*/
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "image_readahead.h"
+
+/*
+  Open a file and size its slot buffer; false if it cannot be opened
+*/
+static bool open_for_read(const std::string &path, ReadSlot &slot) {
+    slot.fd = open(path.c_str(), O_RDONLY);
+    if(slot.fd < 0) return false;
+    
+    struct stat st;
+    if(fstat(slot.fd, &st) != 0) {
+        close(slot.fd);
+        slot.fd = -1;
+        return false;
+    }
+    slot.length = st.st_size;
+    slot.done = 0;
+    if(slot.buffer.size() < slot.length) slot.buffer.resize(slot.length);
+    return true;
+}
+
+ImageReadAhead::~ImageReadAhead() {
+    stop();
+}
+
+void ImageReadAhead::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for(std::thread &t : workers) t.join();
+    workers.clear();
+    
+#ifdef HAVE_LIBURING
+    if(uring) {
+        // Drain reads still in flight before their buffers go away
+        for(size_t s = 0; s < slots.size(); s++) {
+            if(slots[s].state == 1) uring_wait(s);
+        }
+        io_uring_queue_exit(&ring);
+        uring = false;
+    }
+#endif
+    for(ReadSlot &slot : slots) {
+        if(slot.fd >= 0) close(slot.fd);
+        slot.fd = -1;
+    }
+}
+
+void ImageReadAhead::start_files(const std::vector<std::string> &file_paths, const std::vector<int> &file_ids,
+                                 int read_depth, int threads) {
+    stop();
+    stopping = false;
+    paths = file_paths;
+    ids = file_ids;
+    pack = NULL;
+    depth = std::max(1, read_depth);
+    consumed = 0;
+    submitted = 0;
+    slots.assign(depth, ReadSlot());
+    jobs.clear();
+    
+#ifdef HAVE_LIBURING
+    uring = io_uring_queue_init(depth, &ring, 0) == 0;
+#endif
+    bool use_threads = true;
+#ifdef HAVE_LIBURING
+    use_threads = !uring;
+#endif
+    if(use_threads) {
+        for(int t = 0; t < std::max(1, threads); t++) {
+            workers.emplace_back(&ImageReadAhead::worker_loop, this);
+        }
+    }
+    
+    while(submitted < (int)ids.size() && submitted < depth) {
+        submit(submitted++);
+    }
+}
+
+void ImageReadAhead::start_pack(const ImagePack &image_pack, const std::vector<int> &entry_ids, int read_depth) {
+    stop();
+    stopping = false;
+    paths.clear();
+    ids = entry_ids;
+    pack = &image_pack;
+    depth = std::max(1, read_depth);
+    consumed = 0;
+    submitted = 0;
+    slots.clear();
+    
+    while(submitted < (int)ids.size() && submitted < depth) {
+        submit(submitted++);
+    }
+}
+
+const char *ImageReadAhead::backend() const {
+    if(pack) return "mmap";
+#ifdef HAVE_LIBURING
+    if(uring) return "io_uring";
+#endif
+    return "threads";
+}
+
+/*
+  Start reading list position p into its slot (p mod depth)
+*/
+void ImageReadAhead::submit(int position) {
+    if(pack) {
+        // Ask the kernel to page the entry in before the decoder touches it
+        const PackEntry &e = pack->entries[ids[position]];
+        uintptr_t page = sysconf(_SC_PAGESIZE);
+        uintptr_t start = (uintptr_t)(pack->base + e.offset) & ~(page - 1);
+        uintptr_t end = (uintptr_t)(pack->base + e.offset + e.length);
+        madvise((void *)start, end - start, MADV_WILLNEED);
+        return;
+    }
+    
+    int s = position % depth;
+    ReadSlot &slot = slots[s];
+    slot.item = position;
+    slot.ok = false;
+    
+#ifdef HAVE_LIBURING
+    if(uring) {
+        slot.state = 1;
+        uring_submit(s);
+        return;
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot.state = 1;
+        jobs.push_back(s);
+    }
+    work_ready.notify_one();
+}
+
+bool ImageReadAhead::next(int &id, const unsigned char *&data, size_t &length) {
+    // The slot handed out last time is free again: refill it
+    if(consumed > 0 && submitted < (int)ids.size()) {
+        submit(submitted++);
+    }
+    if(consumed >= (int)ids.size()) {
+        return false;
+    }
+    
+    int position = consumed++;
+    id = ids[position];
+    
+    if(pack) {
+        const PackEntry &e = pack->entries[id];
+        data = pack->data(id);
+        length = e.length;
+        return true;
+    }
+    
+    int s = position % depth;
+    ReadSlot &slot = slots[s];
+#ifdef HAVE_LIBURING
+    if(uring) {
+        uring_wait(s);
+    } else
+#endif
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        read_done.wait(lock, [&] { return slot.state == 2; });
+    }
+    
+    data = slot.buffer.data();
+    length = slot.ok ? slot.length : 0;
+    slot.state = 0;
+    return true;
+}
+
+/*
+  pread worker: take a slot, read its whole file, mark it ready
+*/
+void ImageReadAhead::worker_loop() {
+    while(true) {
+        int s;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if(stopping) return;
+            s = jobs.front();
+            jobs.pop_front();
+        }
+        
+        ReadSlot &slot = slots[s];
+        bool ok = open_for_read(paths[slot.item], slot);
+        while(ok && slot.done < slot.length) {
+            ssize_t n = pread(slot.fd, slot.buffer.data() + slot.done, slot.length - slot.done, slot.done);
+            if(n <= 0) ok = false;
+            else slot.done += n;
+        }
+        if(slot.fd >= 0) {
+            close(slot.fd);
+            slot.fd = -1;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ok = ok;
+            slot.state = 2;
+        }
+        read_done.notify_all();
+    }
+}
+
+#ifdef HAVE_LIBURING
+/*
+  Queue a read of the rest of the slot's file (opening it first if needed)
+*/
+void ImageReadAhead::uring_submit(int s) {
+    ReadSlot &slot = slots[s];
+    if(slot.fd < 0 && !open_for_read(paths[slot.item], slot)) {
+        slot.state = 2;
+        return;
+    }
+    if(slot.length == 0) {
+        close(slot.fd);
+        slot.fd = -1;
+        slot.state = 2;
+        return;
+    }
+    
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+    io_uring_prep_read(sqe, slot.fd, slot.buffer.data() + slot.done, slot.length - slot.done, slot.done);
+    io_uring_sqe_set_data(sqe, (void *)(intptr_t)s);
+    io_uring_submit(&ring);
+}
+
+/*
+  Reap completions until slot s is ready; short reads are resubmitted
+*/
+void ImageReadAhead::uring_wait(int s) {
+    while(slots[s].state != 2) {
+        struct io_uring_cqe *cqe;
+        if(io_uring_wait_cqe(&ring, &cqe) != 0) break;
+        int done_slot = (int)(intptr_t)io_uring_cqe_get_data(cqe);
+        int res = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+        
+        ReadSlot &slot = slots[done_slot];
+        if(res > 0) slot.done += res;
+        if(res > 0 && slot.done < slot.length) {
+            uring_submit(done_slot);
+            continue;
+        }
+        slot.ok = res >= 0 && slot.done == slot.length;
+        close(slot.fd);
+        slot.fd = -1;
+        slot.state = 2;
+    }
+}
+#endif
@@ -0,0 +1,100 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for asynchronous image read-ahead (io_uring, or a pread thread pool fallback)
+*/
+
+#ifndef IMAGE_READAHEAD_H
+#define IMAGE_READAHEAD_H
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "image_pack.h"
+
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+/*
+  One buffer of the recycled pool
+*/
+struct ReadSlot {
+    std::vector<unsigned char> buffer;
+    size_t length = 0;
+    size_t done = 0;
+    int item = -1;
+    int fd = -1;
+    int state = 0;          // 0 free, 1 reading, 2 ready
+    bool ok = false;
+};
+
+/*
+  Reads a list of encoded images ahead of the consumer, keeping up to depth
+  reads in flight. Images are handed out in list order; each buffer stays
+  valid until the following next() call, then goes back to the pool.
+  Files are read with io_uring when built with HAVE_LIBURING (and the
+  kernel allows it), otherwise by a pool of pread threads. Pack entries
+  are already mapped, so they only get madvise(WILLNEED) ahead of use.
+*/
+class ImageReadAhead {
+public:
+    ImageReadAhead() {}
+    ImageReadAhead(const ImageReadAhead &) = delete;
+    ImageReadAhead &operator=(const ImageReadAhead &) = delete;
+    ~ImageReadAhead();
+
+    /*
+      Read paths[k] for k = 0, 1, ...; next() reports ids[k]
+    */
+    void start_files(const std::vector<std::string> &paths, const std::vector<int> &ids, int depth, int threads);
+
+    /*
+      Hand out pack entries ids[k] for k = 0, 1, ...
+    */
+    void start_pack(const ImagePack &pack, const std::vector<int> &ids, int depth);
+
+    /*
+      Next image's encoded bytes (length 0 if it could not be read)
+      Returns false when the list is exhausted
+    */
+    bool next(int &id, const unsigned char *&data, size_t &length);
+
+    /*
+      "io_uring", "threads" or "mmap"
+    */
+    const char *backend() const;
+
+private:
+    std::vector<std::string> paths;
+    std::vector<int> ids;
+    const ImagePack *pack = NULL;
+    int depth = 0;
+    int consumed = 0;              // next list position to hand out
+    int submitted = 0;             // next list position to start reading
+    std::vector<ReadSlot> slots;
+
+    // pread thread pool
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable read_done;
+    std::deque<int> jobs;
+    bool stopping = false;
+
+#ifdef HAVE_LIBURING
+    struct io_uring ring;
+    bool uring = false;
+    void uring_submit(int slot);
+    void uring_wait(int slot);
+#endif
+
+    void submit(int position);
+    void worker_loop();
+    void stop();
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the directory / pack file image source
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <opencv2/opencv.hpp>
+#include "image_source.h"
+
+int open_image_source(const char *path, ImageSource &source, ImageNameFilter accept) {
+    source.names.clear();
+    source.rows.clear();
+    
+    struct stat st;
+    if(stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+        if(!is_image_pack(path) || open_image_pack(path, source.pack) != 0) {
+            printf("Error: %s is not a pack file\n", path);
+            return -1;
+        }
+        source.packed = true;
+        for(const PackEntry &e : source.pack.entries) {
+            source.rows[e.name] = source.names.size();
+            source.names.push_back(e.name);
+        }
+        return 0;
+    }
+    
+    // Open directory
+    DIR *dirp = opendir(path);
+    if(dirp == NULL) {
+        printf("Cannot open directory %s\n", path);
+        return -1;
+    }
+    source.packed = false;
+    source.directory = path;
+    
+    struct dirent *dp;
+    while((dp = readdir(dirp)) != NULL) {
+        // Check if it's an image file
+        bool is_image = accept ? accept(dp->d_name) :
+                        (strstr(dp->d_name, ".jpg") || 
+                         strstr(dp->d_name, ".png") || 
+                         strstr(dp->d_name, ".JPG") ||
+                         strstr(dp->d_name, ".PNG"));
+        if(is_image) {
+            source.rows[dp->d_name] = source.names.size();
+            source.names.push_back(dp->d_name);
+        }
+    }
+    closedir(dirp);
+    
+    return 0;
+}
+
+int find_source_image(const ImageSource &source, const std::string &name) {
+    auto it = source.rows.find(name);
+    return it == source.rows.end() ? -1 : it->second;
+}
+
+cv::Mat read_source_image(const ImageSource &source, int i, int flags) {
+    if(source.packed) {
+        // Mat header over the mapped bytes; imdecode reads them in place
+        const PackEntry &e = source.pack.entries[i];
+        cv::Mat encoded(1, (int)e.length, CV_8U, (void *)source.pack.data(i));
+        return cv::imdecode(encoded, flags);
+    }
+    
+    return cv::imread(source.directory + "/" + source.names[i], flags);
+}
+
+void start_source_read_ahead(const ImageSource &source, const std::vector<int> &order, int depth, int threads,
+                             ImageReadAhead &reader) {
+    std::vector<int> ids = order;
+    if(ids.empty()) {
+        for(int i = 0; i < source.count(); i++) ids.push_back(i);
+    }
+    
+    if(source.packed) {
+        reader.start_pack(source.pack, ids, depth);
+        return;
+    }
+    
+    std::vector<std::string> paths;
+    for(int id : ids) {
+        paths.push_back(source.directory + "/" + source.names[id]);
+    }
+    reader.start_files(paths, ids, depth, threads);
+}
+
+bool next_source_image(ImageReadAhead &reader, int &index, cv::Mat &image, int flags) {
+    const unsigned char *data;
+    size_t length;
+    if(!reader.next(index, data, length)) {
+        return false;
+    }
+    
+    if(length == 0) {
+        image = cv::Mat();
+    } else {
+        // Decode in place from the read buffer (valid until the next call)
+        cv::Mat encoded(1, (int)length, CV_8U, (void *)data);
+        image = cv::imdecode(encoded, flags);
+    }
+    return true;
+}
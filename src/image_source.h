@@ -0,0 +1,68 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the image source used by the matchers and builders (a directory or a pack file)
+*/
+
+#ifndef IMAGE_SOURCE_H
+#define IMAGE_SOURCE_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <opencv2/opencv.hpp>
+#include "image_pack.h"
+#include "image_readahead.h"
+
+/*
+  The images of a collection, from a directory (.jpg/.png files, read with
+  cv::imread) or from a pack file (decoded straight from the mapping)
+*/
+struct ImageSource {
+    bool packed = false;
+    std::string directory;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> rows;
+    ImagePack pack;
+
+    int count() const { return names.size(); }
+};
+
+/*
+  Which files of a directory are images: true to include the file
+*/
+typedef bool (*ImageNameFilter)(const char *filename);
+
+/*
+  Open a directory or a pack file written by cbir_pack
+  A directory lists the files accept() takes, or .jpg/.png files if accept is NULL
+  Returns 0 on success, -1 on error
+*/
+int open_image_source(const char *path, ImageSource &source, ImageNameFilter accept = NULL);
+
+/*
+  Index of an image by filename, -1 if it is not in the source
+*/
+int find_source_image(const ImageSource &source, const std::string &name);
+
+/*
+  Decode image i (empty Mat if it cannot be read)
+  Pack images are decoded from the mapped bytes without copying them
+*/
+cv::Mat read_source_image(const ImageSource &source, int i, int flags = cv::IMREAD_COLOR);
+
+/*
+  Start reading images ahead of use: the source indices in order (every
+  image in source order if order is empty), depth reads in flight, and
+  threads pread workers when io_uring is not available
+*/
+void start_source_read_ahead(const ImageSource &source, const std::vector<int> &order, int depth, int threads,
+                             ImageReadAhead &reader);
+
+/*
+  Decode the next read-ahead image from its buffer
+  Returns false when all images have been handed out (image is empty if unreadable)
+*/
+bool next_source_image(ImageReadAhead &reader, int &index, cv::Mat &image, int flags = cv::IMREAD_COLOR);
+
+#endif
@@ -0,0 +1,125 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of Cauchy-projection LSH tables for near-duplicate candidate generation
+*/
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "lsh.h"
+
+/*
+  Cauchy projections are 1-stable: a . (x - y) is distributed like
+  ||x - y||_1 times a standard Cauchy variable
+*/
+void lsh_init(LSHIndex &index, int dim, const LSHParams &params) {
+    index.dim = dim;
+    index.params = params;
+    
+    int total = params.num_tables * params.hashes_per_table;
+    std::mt19937 rng(params.seed);
+    std::cauchy_distribution<float> cauchy(0.0f, 1.0f);
+    std::uniform_real_distribution<float> uniform(0.0f, params.bucket_width);
+    
+    index.projections.resize((size_t)total * dim);
+    for(float &a : index.projections) a = cauchy(rng);
+    index.offsets.resize(total);
+    for(float &b : index.offsets) b = uniform(rng);
+    
+    index.tables.assign(params.num_tables, std::unordered_map<uint64_t, std::vector<int>>());
+}
+
+/*
+  Combine the table's quantized projections into one 64-bit key (FNV-1a over the values)
+*/
+uint64_t lsh_key(const LSHIndex &index, int table, const SparseHist &hist) {
+    int k = index.params.hashes_per_table;
+    uint64_t key = 1469598103934665603ULL;
+    
+    for(int j = 0; j < k; j++) {
+        int h = table * k + j;
+        const float *a = &index.projections[(size_t)h * index.dim];
+        float dot = index.offsets[h];
+        for(size_t i = 0; i < hist.bins.size(); i++) {
+            dot += a[hist.bins[i]] * hist.weights[i];
+        }
+        
+        int64_t slot = (int64_t)std::floor(dot / index.params.bucket_width);
+        key = (key ^ (uint64_t)slot) * 1099511628211ULL;
+    }
+    
+    return key;
+}
+
+/*
+  Add the image to one bucket per table
+*/
+void lsh_insert(LSHIndex &index, int image, const SparseHist &hist) {
+    for(int t = 0; t < index.params.num_tables; t++) {
+        index.tables[t][lsh_key(index, t, hist)].push_back(image);
+    }
+}
+
+/*
+  Pairs within each bucket, a window of neighbours in a shuffled order for
+  oversized buckets. Each table records every image's bucket number and its
+  position in the shuffled order (0 in buckets that pair everything), so a
+  later table can tell whether an earlier one already produced a pair.
+*/
+size_t lsh_candidate_pairs(const LSHIndex &index, const std::function<void(int, int)> &visit) {
+    size_t capped = 0;
+    int window = index.params.max_bucket > 1 ? index.params.max_bucket - 1 : 0;
+    int num_images = 0;
+    if(!index.tables.empty()) {
+        for(const auto &bucket : index.tables[0]) {
+            for(int id : bucket.second) num_images = std::max(num_images, id + 1);
+        }
+    }
+    
+    std::vector<std::vector<int>> bucket_of(index.tables.size());
+    std::vector<std::vector<int>> position(index.tables.size());
+    auto paired_before = [&](size_t t, int a, int b) {
+        for(size_t u = 0; u < t; u++) {
+            if(bucket_of[u][a] == bucket_of[u][b] && std::abs(position[u][a] - position[u][b]) <= window) {
+                return true;
+            }
+        }
+        return false;
+    };
+    
+    std::vector<int> shuffled;
+    for(size_t t = 0; t < index.tables.size(); t++) {
+        bucket_of[t].assign(num_images, -1);
+        position[t].assign(num_images, 0);
+        int number = 0;
+        for(const auto &bucket : index.tables[t]) {
+            const std::vector<int> *ids = &bucket.second;
+            int reach = ids->size();
+            if(index.params.max_bucket > 0 && ids->size() > (size_t)index.params.max_bucket) {
+                // Seeded by table and key, so a run is repeatable
+                shuffled = *ids;
+                std::mt19937 rng(index.params.seed ^ (unsigned int)(bucket.first * 0x9e3779b97f4a7c15ULL >> 32) ^ t);
+                std::shuffle(shuffled.begin(), shuffled.end(), rng);
+                ids = &shuffled;
+                reach = window;
+                capped++;
+                for(int i = 0; i < (int)ids->size(); i++) position[t][(*ids)[i]] = i;
+            }
+            for(int id : *ids) bucket_of[t][id] = number;
+            number++;
+            
+            for(int i = 0; i < (int)ids->size(); i++) {
+                int last = std::min((int)ids->size(), i + 1 + reach);
+                for(int j = i + 1; j < last; j++) {
+                    int lo = std::min((*ids)[i], (*ids)[j]);
+                    int hi = std::max((*ids)[i], (*ids)[j]);
+                    if(!paired_before(t, lo, hi)) visit(lo, hi);
+                }
+            }
+        }
+    }
+    return capped;
+}
@@ -0,0 +1,69 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for L1 locality-sensitive hashing of histograms (p-stable / Cauchy projections)
+*/
+
+#ifndef LSH_H
+#define LSH_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include "sparse_hist.h"
+
+/*
+  Hash family settings
+  Each table concatenates hashes_per_table values floor((a . x + b) / bucket_width)
+  with Cauchy-distributed a, so histograms close in L1 tend to share a bucket.
+  For normalized histograms L1 = 2 * intersection distance.
+*/
+struct LSHParams {
+    int num_tables = 20;
+    int hashes_per_table = 8;
+    float bucket_width = 1.6f;
+    int max_bucket = 64;              // larger buckets are sub-sampled, 0 = compare all pairs
+    unsigned int seed = 1234;
+};
+
+/*
+  Hash functions plus one bucket map per table (bucket key -> image ids)
+*/
+struct LSHIndex {
+    int dim = 0;
+    LSHParams params;
+    std::vector<float> projections;   // [table][hash][dim]
+    std::vector<float> offsets;       // [table][hash], uniform in [0, bucket_width)
+    std::vector<std::unordered_map<uint64_t, std::vector<int>>> tables;
+};
+
+/*
+  Draw the random projections for dim-dimensional histograms
+*/
+void lsh_init(LSHIndex &index, int dim, const LSHParams &params);
+
+/*
+  Bucket key of one histogram in one table (projections only touch its nonzero bins)
+*/
+uint64_t lsh_key(const LSHIndex &index, int table, const SparseHist &hist);
+
+/*
+  Add an image to its bucket in every table
+*/
+void lsh_insert(LSHIndex &index, int image, const SparseHist &hist);
+
+/*
+  Call visit(i, j), i < j, once for every distinct pair that shares a bucket
+  in at least one table, table by table, without collecting the pairs
+  A bucket of b > max_bucket images would give b^2 / 2 pairs; instead its
+  images are shuffled and each is paired with the next max_bucket - 1, so a
+  bucket costs at most b x max_bucket pairs
+  A pair already paired by an earlier table is skipped, using each image's
+  bucket and position in the earlier tables, so memory grows with
+  images x tables, not with the number of pairs
+  Returns the number of buckets that were sub-sampled
+*/
+size_t lsh_candidate_pairs(const LSHIndex &index, const std::function<void(int, int)> &visit);
+
+#endif
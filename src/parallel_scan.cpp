@@ -0,0 +1,145 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the persistent scan thread pool and per-thread top-K scoring
+*/
+
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "parallel_scan.h"
+#include "block_kernels.h"
+
+// Rows claimed per grab of the shared counter (a whole number of blocks)
+#define SCAN_CHUNK_ROWS 4096
+
+ScanPool::ScanPool(int threads) {
+    for(int t = 0; t < std::max(1, threads); t++) {
+        workers.emplace_back(&ScanPool::worker_loop, this, t);
+    }
+}
+
+ScanPool::~ScanPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for(std::thread &t : workers) t.join();
+}
+
+void ScanPool::run(const std::function<void(int)> &job) {
+    std::unique_lock<std::mutex> lock(mutex);
+    task = &job;
+    running = workers.size();
+    generation++;
+    work_ready.notify_all();
+    work_done.wait(lock, [&] { return running == 0; });
+    task = NULL;
+}
+
+void ScanPool::worker_loop(int index) {
+    uint64_t seen = 0;
+    for(;;) {
+        const std::function<void(int)> *job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&] { return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+            job = task;
+        }
+        
+        (*job)(index);
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--running == 0) work_done.notify_one();
+    }
+}
+
+void parallel_top_k(ScanPool &pool, const FeatureStoreInfo &info, const std::vector<float> &data,
+                    const RetrievalMethod &method, const std::vector<float> &query, int k,
+                    std::vector<ScanMatch> &matches, ParallelScanStats &stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = ParallelScanStats();
+    matches.clear();
+    if(k <= 0) return;
+    
+    bool blocked = info.layout == FEATURE_STORE_BLOCKED;
+    bool batched = blocked && method.block_distance != NULL;
+    std::atomic<uint64_t> next_chunk(0);
+    std::atomic<float> threshold(INFINITY);
+    std::vector<std::vector<ScanMatch>> local(pool.size());
+    std::vector<uint64_t> pruned(pool.size(), 0);
+    
+    pool.run([&](int worker) {
+        std::vector<ScanMatch> &heap = local[worker];   // max-heap: front is this worker's k-th best
+        heap.clear();
+        heap.reserve(k);
+        std::vector<float> row_vec(info.dim);
+        std::vector<float> block_dists(SCAN_CHUNK_ROWS);
+        uint64_t rejected = 0;
+        
+        auto offer = [&](float distance, uint64_t row) {
+            if(distance > threshold.load(std::memory_order_relaxed)) {
+                rejected++;
+                return;
+            }
+            ScanMatch m = {distance, row};
+            if((int)heap.size() < k) {
+                heap.push_back(m);
+                std::push_heap(heap.begin(), heap.end());
+                if((int)heap.size() < k) return;
+            } else if(m < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = m;
+                std::push_heap(heap.begin(), heap.end());
+            } else {
+                return;
+            }
+            
+            // This worker's k-th distance bounds the global k-th; publish it if it is the tightest yet
+            float kth = heap.front().distance;
+            float current = threshold.load(std::memory_order_relaxed);
+            while(kth < current && !threshold.compare_exchange_weak(current, kth, std::memory_order_relaxed)) {
+            }
+        };
+        
+        for(;;) {
+            uint64_t first = next_chunk.fetch_add(1, std::memory_order_relaxed) * SCAN_CHUNK_ROWS;
+            if(first >= info.count) break;
+            size_t num_rows = (size_t)std::min((uint64_t)SCAN_CHUNK_ROWS, info.count - first);
+            const float *rows = data.data() + first * info.dim;
+            
+            if(batched) {
+                size_t num_blocks = (num_rows + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+                method.block_distance(rows, num_blocks, info.dim, query.data(), block_dists.data());
+                for(size_t r = 0; r < num_rows; r++) offer(block_dists[r], first + r);
+                continue;
+            }
+            for(size_t r = 0; r < num_rows; r++) {
+                if(blocked) {
+                    const float *block = rows + (r / FEATURE_BLOCK) * FEATURE_BLOCK * info.dim;
+                    gather_block_row(block, info.dim, r % FEATURE_BLOCK, row_vec.data());
+                } else {
+                    const float *row = rows + r * info.dim;
+                    row_vec.assign(row, row + info.dim);
+                }
+                offer(method.distance(query, row_vec), first + r);
+            }
+        }
+        pruned[worker] = rejected;
+    });
+    
+    // Merge the per-worker lists
+    for(int w = 0; w < pool.size(); w++) {
+        matches.insert(matches.end(), local[w].begin(), local[w].end());
+        stats.pruned += pruned[w];
+    }
+    size_t keep = std::min((size_t)k, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + keep, matches.end());
+    matches.resize(keep);
+    
+    stats.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
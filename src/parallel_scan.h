@@ -0,0 +1,81 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for multi-threaded top-K scoring of an in-memory feature store
+*/
+
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include "feature_store.h"
+#include "retrieval_engine.h"
+
+/*
+  Worker threads that live as long as the pool, so each query only pays for
+  waking them. run() hands the same task to every worker and returns once
+  all of them have finished it.
+*/
+class ScanPool {
+public:
+    explicit ScanPool(int threads);
+    ScanPool(const ScanPool &) = delete;
+    ScanPool &operator=(const ScanPool &) = delete;
+    ~ScanPool();
+    
+    int size() const { return (int)workers.size(); }
+    
+    /*
+      Call task(worker index) on every worker and wait for all of them
+    */
+    void run(const std::function<void(int)> &task);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    const std::function<void(int)> *task = NULL;
+    uint64_t generation = 0;       // bumped for every run()
+    int running = 0;
+    bool stopping = false;
+    
+    void worker_loop(int index);
+};
+
+/*
+  A scored row; ordered by distance, then row, so results do not depend on
+  how rows were split between threads
+*/
+struct ScanMatch {
+    float distance;
+    uint64_t row;
+    bool operator<(const ScanMatch &other) const {
+        return distance < other.distance || (distance == other.distance && row < other.row);
+    }
+};
+
+struct ParallelScanStats {
+    uint64_t pruned = 0;           // rows rejected by the shared threshold without touching a heap
+    double secs = 0.0;
+};
+
+/*
+  Closest k rows to query in data (an in-memory store from load_feature_store)
+  Workers claim chunks of rows from a shared counter and keep their own top k.
+  Once a worker holds k rows its k-th distance bounds the global k-th, so the
+  smallest of those bounds is shared through an atomic and every worker drops
+  rows beyond it. The per-worker lists are merged at the end.
+  Blocked stores are scored with the method's block kernel when it has one.
+  matches receives min(k, count) rows in ascending order.
+*/
+void parallel_top_k(ScanPool &pool, const FeatureStoreInfo &info, const std::vector<float> &data,
+                    const RetrievalMethod &method, const std::vector<float> &query, int k,
+                    std::vector<ScanMatch> &matches, ParallelScanStats &stats);
+
+#endif
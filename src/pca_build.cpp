@@ -0,0 +1,64 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Fit a PCA projection to the DNN embeddings and store every image's reduced vector
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "embedding_store.h"
+#include "pca_index.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <embeddings_csv> <index_file> <components> [--sample S] [--dim D]\n", argv[0]);
+        printf("  components: principal axes kept per image (e.g. 64 or 128 of 512)\n");
+        printf("  --sample: fit the projection to S images spread over the file (default all)\n");
+        printf("  --dim: embedding length (default 512)\n");
+        printf("Example: ./pca_build ResNet18_olym.csv olympus_dnn64.pca 64\n");
+        return -1;
+    }
+    
+    const char *embeddings_csv = argv[1];
+    const char *index_file = argv[2];
+    int components = atoi(argv[3]);
+    int sample = 0;
+    int dim = 512;
+    for(int i = 4; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--sample") == 0) sample = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--dim") == 0) dim = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    EmbeddingStore store;
+    if(load_embedding_store(embeddings_csv, dim, store) != 0) {
+        printf("Error: No %d-d embeddings in %s\n", dim, embeddings_csv);
+        return -1;
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    PCAIndex index;
+    if(pca_train(store, components, sample, index) != 0) {
+        printf("Error: components must be between 1 and %d, with at least 2 images\n", dim);
+        return -1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    if(write_pca_index(index_file, index) != 0) {
+        return -1;
+    }
+    
+    size_t full_bytes = (size_t)store.stride * sizeof(float);
+    printf("Fit %d of %d axes to %d embeddings in %.2f s: %.1f%% of the variance kept\n",
+           index.components, dim, store.count, secs, 100.0 * index.explained);
+    printf("Wrote %s: %lu bytes per image (full embedding: %lu bytes, %.1fx smaller)\n",
+           index_file, index.image_bytes(), full_bytes, (double)full_bytes / index.image_bytes());
+    
+    return 0;
+}
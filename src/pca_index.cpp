@@ -0,0 +1,216 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the PCA-reduced embedding index: training, projection, file I/O,
+           reduced scan and exact re-ranking
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "pca_index.h"
+
+#define PCA_MAGIC "PCA1"
+
+int pca_train(const EmbeddingStore &store, int components, int sample, PCAIndex &index) {
+    int dim = store.dim;
+    if(components < 1 || components > dim || store.count < 2) {
+        return -1;
+    }
+    
+    // Training rows spread evenly over the store
+    int rows = (sample <= 0) ? store.count : std::min(sample, store.count);
+    rows = std::max(rows, 2);
+    cv::Mat data(rows, dim, CV_32F);
+    for(int r = 0; r < rows; r++) {
+        const float *x = store.row((int)((long long)r * store.count / rows));
+        std::copy(x, x + dim, data.ptr<float>(r));
+    }
+    cv::PCA pca(data, cv::Mat(), cv::PCA::DATA_AS_ROW, components);
+    
+    // cv::PCA keeps fewer axes than asked when there are fewer training rows
+    index.dim = dim;
+    index.components = pca.eigenvectors.rows;
+    index.stride = (index.components + 15) / 16 * 16;
+    index.mean.assign(pca.mean.ptr<float>(0), pca.mean.ptr<float>(0) + dim);
+    index.basis.resize((size_t)index.components * dim);
+    for(int c = 0; c < index.components; c++) {
+        const float *axis = pca.eigenvectors.ptr<float>(c);
+        std::copy(axis, axis + dim, index.basis.begin() + (size_t)c * dim);
+    }
+    
+    // Variance kept: the eigenvalues over the total variance of the training rows
+    double total = 0.0, kept = 0.0;
+    for(int r = 0; r < rows; r++) {
+        const float *x = data.ptr<float>(r);
+        for(int d = 0; d < dim; d++) {
+            double diff = x[d] - index.mean[d];
+            total += diff * diff;
+        }
+    }
+    total /= rows;
+    for(int c = 0; c < index.components; c++) kept += pca.eigenvalues.at<float>(c);
+    index.explained = total > 0.0 ? (float)std::min(1.0, kept / total) : 1.0f;
+    
+    // Project every image
+    index.names = store.names;
+    index.reduced.assign((size_t)store.count * index.stride, 0.0f);
+    index.offsets.resize(store.count);
+    for(int i = 0; i < store.count; i++) {
+        pca_project(index, store.row(i), &index.reduced[(size_t)i * index.stride], index.offsets[i]);
+    }
+    return 0;
+}
+
+void pca_project(const PCAIndex &index, const float *x, float *y, float &offset) {
+    std::vector<float> centered(index.dim);
+    offset = 0.0f;
+    for(int d = 0; d < index.dim; d++) {
+        centered[d] = x[d] - index.mean[d];
+        offset += index.mean[d] * x[d];
+    }
+    for(int c = 0; c < index.components; c++) {
+        const float *axis = &index.basis[(size_t)c * index.dim];
+        float sum = 0.0f;
+        for(int d = 0; d < index.dim; d++) sum += axis[d] * centered[d];
+        y[c] = sum;
+    }
+    for(int c = index.components; c < index.stride; c++) y[c] = 0.0f;
+}
+
+/*
+  Write the index: magic, header, projection, names, reduced vectors and offsets
+*/
+int write_pca_index(const char *filename, const PCAIndex &index) {
+    FILE *fp = fopen(filename, "wb");
+    if(!fp) {
+        printf("Unable to open output file %s\n", filename);
+        return -1;
+    }
+    
+    int header[4] = {index.dim, index.components, index.stride, index.count()};
+    fwrite(PCA_MAGIC, sizeof(char), 4, fp);
+    fwrite(header, sizeof(int), 4, fp);
+    fwrite(&index.explained, sizeof(float), 1, fp);
+    fwrite(index.mean.data(), sizeof(float), index.mean.size(), fp);
+    fwrite(index.basis.data(), sizeof(float), index.basis.size(), fp);
+    
+    for(const std::string &name : index.names) {
+        int len = name.size();
+        fwrite(&len, sizeof(int), 1, fp);
+        fwrite(name.data(), sizeof(char), len, fp);
+    }
+    
+    fwrite(index.reduced.data(), sizeof(float), index.reduced.size(), fp);
+    fwrite(index.offsets.data(), sizeof(float), index.offsets.size(), fp);
+    
+    bool ok = ferror(fp) == 0;
+    fclose(fp);
+    if(!ok) {
+        printf("Error: Failed writing %s\n", filename);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+  Read an index written by write_pca_index
+*/
+int read_pca_index(const char *filename, PCAIndex &index) {
+    FILE *fp = fopen(filename, "rb");
+    if(!fp) {
+        printf("Unable to open PCA index %s\n", filename);
+        return -1;
+    }
+    
+    char magic[4];
+    int header[4];
+    if(fread(magic, sizeof(char), 4, fp) != 4 || memcmp(magic, PCA_MAGIC, 4) != 0 ||
+       fread(header, sizeof(int), 4, fp) != 4 || fread(&index.explained, sizeof(float), 1, fp) != 1 ||
+       header[0] <= 0 || header[1] <= 0 || header[1] > header[0] || header[2] < header[1] || header[3] < 0) {
+        printf("%s is not a PCA index\n", filename);
+        fclose(fp);
+        return -1;
+    }
+    
+    index.dim = header[0];
+    index.components = header[1];
+    index.stride = header[2];
+    int count = header[3];
+    
+    index.mean.resize(index.dim);
+    index.basis.resize((size_t)index.components * index.dim);
+    bool ok = fread(index.mean.data(), sizeof(float), index.mean.size(), fp) == index.mean.size() &&
+              fread(index.basis.data(), sizeof(float), index.basis.size(), fp) == index.basis.size();
+    
+    index.names.clear();
+    for(int i = 0; ok && i < count; i++) {
+        int len = 0;
+        ok = fread(&len, sizeof(int), 1, fp) == 1 && len >= 0;
+        if(!ok) break;
+        std::string name(len, '\0');
+        ok = fread(&name[0], sizeof(char), len, fp) == (size_t)len;
+        index.names.push_back(name);
+    }
+    
+    index.reduced.resize((size_t)count * index.stride);
+    index.offsets.resize(count);
+    ok = ok && fread(index.reduced.data(), sizeof(float), index.reduced.size(), fp) == index.reduced.size() &&
+         fread(index.offsets.data(), sizeof(float), index.offsets.size(), fp) == index.offsets.size();
+    fclose(fp);
+    
+    if(!ok) {
+        printf("Truncated PCA index %s\n", filename);
+        return -1;
+    }
+    
+    return 0;
+}
+
+void pca_scan(const PCAIndex &index, const float *query_y, float query_offset, std::vector<float> &distances) {
+    float mean_sq = 0.0f;
+    for(float m : index.mean) mean_sq += m * m;
+    
+    // 1 - (y_x . y_q + m . x + m . q - m . m)
+    float bias = 1.0f - query_offset + mean_sq;
+    int count = index.count();
+    distances.resize(count);
+    const float *y = index.reduced.data();
+    for(int i = 0; i < count; i++) {
+        distances[i] = bias - embedding_dot(query_y, y + (size_t)i * index.stride, index.stride) - index.offsets[i];
+    }
+}
+
+void pca_search(const PCAIndex &index, const EmbeddingStore &store, int q, int n, int candidates,
+                std::vector<std::pair<float, int>> &results, PCASearchStats &stats) {
+    stats = PCASearchStats();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<float> distances;
+    pca_scan(index, &index.reduced[(size_t)q * index.stride], index.offsets[q], distances);
+    
+    results.clear();
+    results.reserve(distances.size());
+    for(size_t i = 0; i < distances.size(); i++) {
+        if((int)i != q) results.push_back({distances[i], (int)i});
+    }
+    int keep = std::min((int)results.size(), std::max(n, candidates));
+    std::partial_sort(results.begin(), results.begin() + keep, results.end());
+    results.resize(keep);
+    auto scanned = std::chrono::steady_clock::now();
+    stats.scan_ms = std::chrono::duration<double, std::milli>(scanned - start).count();
+    
+    // Exact cosine over the shortlist
+    if(candidates > 0) {
+        for(std::pair<float, int> &r : results) {
+            r.first = embedding_cosine_distance(store, q, r.second);
+        }
+        std::sort(results.begin(), results.end());
+        stats.rerank_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - scanned).count();
+    }
+    results.resize(std::min(n, (int)results.size()));
+}
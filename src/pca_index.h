@@ -0,0 +1,76 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the PCA-reduced embedding index (cv::PCA projection, reduced scan, exact cosine re-ranking)
+*/
+
+#ifndef PCA_INDEX_H
+#define PCA_INDEX_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "embedding_store.h"
+
+/*
+  PCA projection of the normalized embeddings and the reduced vector of every image
+  For normalized rows x, q and the mean m, with y = P (x - m):
+    x . q = (x - m) . (q - m) + m . x + m . q - m . m
+          ~ y_x . y_q + m . x + m . q - m . m
+  so each image keeps its reduced vector and the exact m . x, and a scan
+  touches components + 1 floats per image instead of dim.
+*/
+struct PCAIndex {
+    int dim = 0;                        // full embedding length
+    int components = 0;                 // principal axes kept
+    int stride = 0;                     // floats per reduced row, components rounded up to 16
+    float explained = 0.0f;             // fraction of the variance the kept axes carry
+    std::vector<float> mean;            // dim
+    std::vector<float> basis;           // components x dim, one principal axis per row
+    std::vector<std::string> names;
+    std::vector<float> reduced;         // count x stride, zero padded
+    std::vector<float> offsets;         // m . x per image
+
+    int count() const { return names.size(); }
+    size_t image_bytes() const { return ((size_t)stride + 1) * sizeof(float); }
+};
+
+/*
+  Fit components principal axes (cv::PCA) to the store's normalized rows,
+  using up to sample rows spread over the store (all of them if sample <= 0),
+  then project every row
+  Returns 0 on success, -1 on bad parameters
+*/
+int pca_train(const EmbeddingStore &store, int components, int sample, PCAIndex &index);
+
+/*
+  Reduced vector (stride floats) and mean offset of one normalized row
+*/
+void pca_project(const PCAIndex &index, const float *x, float *y, float &offset);
+
+/*
+  Write / read a PCA index file (projection, names, reduced vectors, offsets)
+*/
+int write_pca_index(const char *filename, const PCAIndex &index);
+int read_pca_index(const char *filename, PCAIndex &index);
+
+/*
+  Approximate cosine distance from a projected query to every image
+*/
+void pca_scan(const PCAIndex &index, const float *query_y, float query_offset, std::vector<float> &distances);
+
+struct PCASearchStats {
+    double scan_ms = 0.0;
+    double rerank_ms = 0.0;
+};
+
+/*
+  Top n images for store row q (left out of the results): the candidates
+  images closest in the reduced space, re-ranked with the full cosine
+  distance. The index rows must be in store order.
+  results holds (distance, row) pairs, best first.
+*/
+void pca_search(const PCAIndex &index, const EmbeddingStore &store, int q, int n, int candidates,
+                std::vector<std::pair<float, int>> &results, PCASearchStats &stats);
+
+#endif
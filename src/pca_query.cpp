@@ -0,0 +1,145 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Query the PCA-reduced embeddings with exact cosine re-ranking, and measure memory, scan speed
+           and recall against exhaustive search
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "embedding_store.h"
+#include "pca_index.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 5) {
+        printf("Usage: %s <embeddings_csv> <index_file> <target_image> <N> [--candidates R] [--recall Q]\n", argv[0]);
+        printf("  target_image: an image name in the embeddings file\n");
+        printf("  --candidates: images taken from the reduced scan and re-ranked with the full cosine\n");
+        printf("                (default 10 x N; 0 ranks by the reduced distance alone)\n");
+        printf("  --recall: measure recall@N, scan speed and memory against exhaustive search over Q queries\n");
+        printf("Example: ./pca_query ResNet18_olym.csv olympus_dnn64.pca pic.0893.jpg 5 --candidates 50 --recall 200\n");
+        return -1;
+    }
+    
+    const char *embeddings_csv = argv[1];
+    const char *index_file = argv[2];
+    const char *target = argv[3];
+    int N = atoi(argv[4]);
+    int candidates = -1;
+    int recall_queries = 0;
+    for(int i = 5; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--candidates") == 0) candidates = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--recall") == 0) recall_queries = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(N <= 0) {
+        printf("Error: N must be > 0\n");
+        return -1;
+    }
+    if(candidates < 0) candidates = 10 * N;
+    
+    PCAIndex index;
+    if(read_pca_index(index_file, index) != 0) {
+        return -1;
+    }
+    EmbeddingStore store;
+    if(load_embedding_store(embeddings_csv, index.dim, store) != 0) {
+        printf("Error: No %d-d embeddings in %s\n", index.dim, embeddings_csv);
+        return -1;
+    }
+    
+    // Reduced rows must line up with the full ones
+    if(store.count != index.count() || store.names != index.names) {
+        printf("Error: %s was not built from %s (run pca_build again)\n", index_file, embeddings_csv);
+        return -1;
+    }
+    
+    int target_row = embedding_store_find(store, target);
+    if(target_row < 0) {
+        printf("Error: target image not found in %s: %s\n", embeddings_csv, target);
+        return -1;
+    }
+    
+    printf("Index: %s (%d images, %d of %d axes, %.1f%% of the variance)\n", index_file, index.count(),
+           index.components, index.dim, 100.0 * index.explained);
+    
+    // Single query
+    std::vector<std::pair<float, int>> results;
+    PCASearchStats stats;
+    pca_search(index, store, target_row, N, candidates, results, stats);
+    
+    printf("\nTop %lu matches for %s%s:\n", results.size(), target, candidates > 0 ? " (re-ranked)" : " (reduced)");
+    for(size_t i = 0; i < results.size(); i++) {
+        printf("%lu. %s (distance: %.6f)\n", i + 1, store.names[results[i].second].c_str(), results[i].first);
+    }
+    printf("\nQuery time: %.3f ms (reduced scan %.3f ms", stats.scan_ms + stats.rerank_ms, stats.scan_ms);
+    if(candidates > 0) {
+        printf(", re-rank of %d %.3f ms", std::min(std::max(N, candidates), store.count - 1), stats.rerank_ms);
+    }
+    printf(")\n");
+    
+    // Recall@N, scan speed and memory against exhaustive cosine search, queries spread over the store
+    if(recall_queries > 0) {
+        int n = store.count;
+        int q_count = std::min(recall_queries, n);
+        double recall_sum = 0.0, pca_ms = 0.0, exact_ms = 0.0, full_scan_ms = 0.0, reduced_scan_ms = 0.0;
+        std::vector<float> distances;
+        
+        for(int q = 0; q < q_count; q++) {
+            int qi = (int)((long long)q * n / q_count);
+            
+            auto t0 = std::chrono::steady_clock::now();
+            std::vector<std::pair<float, int>> approx;
+            pca_search(index, store, qi, N, candidates, approx, stats);
+            auto t1 = std::chrono::steady_clock::now();
+            
+            embedding_cosine_distances(store, qi, distances);
+            auto t2 = std::chrono::steady_clock::now();
+            std::vector<std::pair<float, int>> exact;
+            for(int i = 0; i < n; i++) {
+                if(i != qi) exact.push_back({distances[i], i});
+            }
+            int k = std::min(N, (int)exact.size());
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+            auto t3 = std::chrono::steady_clock::now();
+            
+            // The two scans alone
+            pca_scan(index, &index.reduced[(size_t)qi * index.stride], index.offsets[qi], distances);
+            auto t4 = std::chrono::steady_clock::now();
+            
+            int hits = 0;
+            for(const std::pair<float, int> &a : approx) {
+                for(int e = 0; e < k; e++) {
+                    if(a.second == exact[e].second) hits++;
+                }
+            }
+            recall_sum += k > 0 ? (double)hits / k : 1.0;
+            pca_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            exact_ms += std::chrono::duration<double, std::milli>(t3 - t1).count();
+            full_scan_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+            reduced_scan_ms += std::chrono::duration<double, std::milli>(t4 - t3).count();
+        }
+        
+        double full_mb = (double)n * store.stride * sizeof(float) / (1024.0 * 1024.0);
+        double reduced_mb = (double)n * index.image_bytes() / (1024.0 * 1024.0);
+        printf("\nMemory: full embeddings %.2f MB, reduced vectors %.2f MB (%.1fx smaller)\n", full_mb, reduced_mb,
+               full_mb / reduced_mb);
+        printf("Scan per query: full cosine %.3f ms, reduced %.3f ms (%.1fx faster)\n", full_scan_ms / q_count,
+               reduced_scan_ms / q_count, full_scan_ms / std::max(reduced_scan_ms, 1e-9));
+        printf("Query: exhaustive %.3f ms, reduced scan", exact_ms / q_count);
+        if(candidates > 0) printf(" + re-rank of %d", candidates);
+        printf(" %.3f ms (%.1fx faster)\n", pca_ms / q_count, exact_ms / std::max(pca_ms, 1e-9));
+        printf("Recall@%d over %d queries: %.4f\n", N, q_count, recall_sum / q_count);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Train a product quantization index from a CSV feature file
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "csv_util.h"
+#include "pq_index.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 5) {
+        printf("Usage: %s <features_csv> <method> <index_file> <num_subvectors> [bits] [iterations] [--sample S]\n", argv[0]);
+        printf("  bits: 8 (256 centroids, 1 byte per subvector) or 4 (16 centroids, SIMD fast scan)\n");
+        printf("  --sample: train the codebooks on S vectors spread over the file (default all);\n");
+        printf("            every vector is still encoded\n");
+        printf("Example: ./pq_build olympus_multi.csv multi olympus_multi.pq 32 8 --sample 20000\n");
+        return -1;
+    }
+    
+    char *features_csv = argv[1];
+    const char *method = argv[2];
+    const char *index_file = argv[3];
+    int num_sub = atoi(argv[4]);
+    int nbits = 8;
+    int iterations = 20;
+    int sample = 0;
+    int positional = 0;
+    for(int i = 5; i < argc; i++) {
+        if(strcmp(argv[i], "--sample") == 0 && i + 1 < argc) sample = atoi(argv[++i]);
+        else if(positional == 0 && argv[i][0] != '-') nbits = atoi(argv[i]), positional++;
+        else if(positional == 1 && argv[i][0] != '-') iterations = atoi(argv[i]), positional++;
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    // Load the feature store
+    std::vector<char *> filenames;
+    std::vector<std::vector<float>> data;
+    if(read_image_data_csv(features_csv, filenames, data) != 0 || data.empty()) {
+        printf("Error: No features in %s\n", features_csv);
+        return -1;
+    }
+    
+    std::vector<std::string> names(filenames.begin(), filenames.end());
+    for(char *name : filenames) {
+        delete[] name;
+    }
+    
+    // Training vectors spread evenly over the file (k-means costs grow with their number)
+    size_t rows = (sample <= 0) ? data.size() : std::min((size_t)sample, data.size());
+    std::vector<std::vector<float>> training_sample;
+    if(rows < data.size()) {
+        training_sample.reserve(rows);
+        for(size_t r = 0; r < rows; r++) {
+            training_sample.push_back(data[r * data.size() / rows]);
+        }
+    }
+    const std::vector<std::vector<float>> &training = rows < data.size() ? training_sample : data;
+    
+    // Train codebooks and encode every vector
+    PQIndex index;
+    index.method = method;
+    printf("Training %d subvectors x %d centroids on %lu of %lu vectors of %lu dims\n",
+           num_sub, 1 << nbits, training.size(), data.size(), data[0].size());
+    if(pq_train(training, num_sub, nbits, iterations, index) != 0) {
+        printf("Error: Invalid PQ parameters (bits must be 8 or 4, at most 256 subvectors for 4 bits)\n");
+        return -1;
+    }
+    pq_encode(data, names, index);
+    
+    if(write_pq_index(index_file, index) != 0) {
+        return -1;
+    }
+    
+    printf("Wrote %s: %lu bytes per image (raw float features: %lu bytes)\n",
+           index_file, index.code_bytes(), data[0].size() * sizeof(float));
+    
+    return 0;
+}
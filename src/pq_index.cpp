@@ -0,0 +1,416 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of product quantization training, encoding, storage and ADC scanning
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include "pq_index.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Images per 4-bit code block (one SIMD register of byte lookups)
+static const int PQ_BLOCK = 16;
+
+static const char PQ_MAGIC[4] = {'P', 'Q', 'I', 'X'};
+
+/*
+  Copy subvector m of a feature vector, zero padding past the end
+*/
+static void get_subvector(const std::vector<float> &vec, int m, int sub_dim, float *out) {
+    for(int j = 0; j < sub_dim; j++) {
+        size_t idx = (size_t)m * sub_dim + j;
+        out[j] = idx < vec.size() ? vec[idx] : 0.0f;
+    }
+}
+
+/*
+  Squared L2 distance between two subvectors
+*/
+static float sub_ssd(const float *a, const float *b, int n) {
+    float sum = 0.0f;
+    for(int j = 0; j < n; j++) {
+        float diff = a[j] - b[j];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+/*
+  Nearest centroid of one subvector
+*/
+static int nearest_centroid(const float *sub, const float *centroids, int ksub, int sub_dim) {
+    int best = 0;
+    float best_dist = FLT_MAX;
+    for(int k = 0; k < ksub; k++) {
+        float d = sub_ssd(sub, centroids + (size_t)k * sub_dim, sub_dim);
+        if(d < best_dist) {
+            best_dist = d;
+            best = k;
+        }
+    }
+    return best;
+}
+
+/*
+  Train the codebooks: independent k-means (Lloyd iterations) per subvector
+*/
+int pq_train(const std::vector<std::vector<float>> &data, int num_sub, int nbits, int iterations, PQIndex &index) {
+    if(data.empty() || num_sub <= 0 || (nbits != 8 && nbits != 4)) {
+        return -1;
+    }
+    
+    // 4-bit scan sums up to num_sub bytes in 16-bit lanes
+    if(nbits == 4 && num_sub > 256) {
+        return -1;
+    }
+    
+    index.dim = data[0].size();
+    index.num_sub = num_sub;
+    index.sub_dim = (index.dim + num_sub - 1) / num_sub;
+    index.nbits = nbits;
+    
+    int ksub = index.ksub();
+    int sub_dim = index.sub_dim;
+    int n = data.size();
+    index.centroids.assign((size_t)num_sub * ksub * sub_dim, 0.0f);
+    
+    // Fixed seed so the same data always gives the same index
+    std::mt19937 rng(1234);
+    std::vector<int> order(n);
+    for(int i = 0; i < n; i++) order[i] = i;
+    
+    std::vector<float> subs((size_t)n * sub_dim);
+    std::vector<int> assign(n);
+    std::vector<int> sizes(ksub);
+    
+    for(int m = 0; m < num_sub; m++) {
+        for(int i = 0; i < n; i++) {
+            get_subvector(data[i], m, sub_dim, &subs[(size_t)i * sub_dim]);
+        }
+        
+        // Initialize centroids from distinct random samples (repeat if n < ksub)
+        float *cent = &index.centroids[(size_t)m * ksub * sub_dim];
+        std::shuffle(order.begin(), order.end(), rng);
+        for(int k = 0; k < ksub; k++) {
+            const float *src = &subs[(size_t)order[k % n] * sub_dim];
+            std::copy(src, src + sub_dim, cent + (size_t)k * sub_dim);
+        }
+        
+        for(int it = 0; it < iterations; it++) {
+            // Assignment step
+            for(int i = 0; i < n; i++) {
+                assign[i] = nearest_centroid(&subs[(size_t)i * sub_dim], cent, ksub, sub_dim);
+            }
+            
+            // Update step
+            std::fill(cent, cent + (size_t)ksub * sub_dim, 0.0f);
+            std::fill(sizes.begin(), sizes.end(), 0);
+            for(int i = 0; i < n; i++) {
+                float *c = cent + (size_t)assign[i] * sub_dim;
+                const float *s = &subs[(size_t)i * sub_dim];
+                for(int j = 0; j < sub_dim; j++) c[j] += s[j];
+                sizes[assign[i]]++;
+            }
+            for(int k = 0; k < ksub; k++) {
+                float *c = cent + (size_t)k * sub_dim;
+                if(sizes[k] > 0) {
+                    for(int j = 0; j < sub_dim; j++) c[j] /= (float)sizes[k];
+                } else {
+                    // Empty cluster: restart it on a random sample
+                    const float *s = &subs[(size_t)(rng() % n) * sub_dim];
+                    std::copy(s, s + sub_dim, c);
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/*
+  Encode vectors; 4-bit codes are interleaved in blocks of 16 images:
+  block b, subvector pair p holds 16 bytes, byte i = code(m = 2p) | code(m = 2p + 1) << 4
+*/
+int pq_encode(const std::vector<std::vector<float>> &data, const std::vector<std::string> &filenames, PQIndex &index) {
+    if(data.size() != filenames.size() || index.centroids.empty()) {
+        return -1;
+    }
+    
+    int ksub = index.ksub();
+    int sub_dim = index.sub_dim;
+    int n = data.size();
+    index.filenames = filenames;
+    
+    std::vector<float> sub(sub_dim);
+    if(index.nbits == 8) {
+        index.codes.assign((size_t)n * index.num_sub, 0);
+        for(int i = 0; i < n; i++) {
+            for(int m = 0; m < index.num_sub; m++) {
+                get_subvector(data[i], m, sub_dim, sub.data());
+                const float *cent = &index.centroids[(size_t)m * ksub * sub_dim];
+                index.codes[(size_t)i * index.num_sub + m] = (unsigned char)nearest_centroid(sub.data(), cent, ksub, sub_dim);
+            }
+        }
+    } else {
+        int num_blocks = (n + PQ_BLOCK - 1) / PQ_BLOCK;
+        int pairs = index.code_bytes();
+        index.codes.assign((size_t)num_blocks * pairs * PQ_BLOCK, 0);
+        for(int i = 0; i < n; i++) {
+            unsigned char *block = &index.codes[(size_t)(i / PQ_BLOCK) * pairs * PQ_BLOCK];
+            for(int m = 0; m < index.num_sub; m++) {
+                get_subvector(data[i], m, sub_dim, sub.data());
+                const float *cent = &index.centroids[(size_t)m * ksub * sub_dim];
+                int code = nearest_centroid(sub.data(), cent, ksub, sub_dim);
+                block[(m / 2) * PQ_BLOCK + (i % PQ_BLOCK)] |= (unsigned char)(code << ((m % 2) * 4));
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/*
+  Write the index: header, method, codebooks, filenames, codes
+*/
+int write_pq_index(const char *filename, const PQIndex &index) {
+    FILE *fp = fopen(filename, "wb");
+    if(!fp) {
+        printf("Unable to open output file %s\n", filename);
+        return -1;
+    }
+    
+    int header[5] = {index.dim, index.num_sub, index.sub_dim, index.nbits, (int)index.filenames.size()};
+    int method_len = index.method.size();
+    fwrite(PQ_MAGIC, sizeof(char), 4, fp);
+    fwrite(header, sizeof(int), 5, fp);
+    fwrite(&method_len, sizeof(int), 1, fp);
+    fwrite(index.method.data(), sizeof(char), method_len, fp);
+    fwrite(index.centroids.data(), sizeof(float), index.centroids.size(), fp);
+    
+    for(const std::string &name : index.filenames) {
+        int len = name.size();
+        fwrite(&len, sizeof(int), 1, fp);
+        fwrite(name.data(), sizeof(char), len, fp);
+    }
+    
+    size_t num_codes = index.codes.size();
+    fwrite(&num_codes, sizeof(size_t), 1, fp);
+    fwrite(index.codes.data(), sizeof(unsigned char), num_codes, fp);
+    
+    fclose(fp);
+    return 0;
+}
+
+/*
+  Read an index written by write_pq_index
+*/
+int read_pq_index(const char *filename, PQIndex &index) {
+    FILE *fp = fopen(filename, "rb");
+    if(!fp) {
+        printf("Unable to open PQ index %s\n", filename);
+        return -1;
+    }
+    
+    char magic[4];
+    int header[5];
+    int method_len = 0;
+    if(fread(magic, sizeof(char), 4, fp) != 4 || memcmp(magic, PQ_MAGIC, 4) != 0 ||
+       fread(header, sizeof(int), 5, fp) != 5 || fread(&method_len, sizeof(int), 1, fp) != 1) {
+        printf("%s is not a PQ index\n", filename);
+        fclose(fp);
+        return -1;
+    }
+    
+    index.dim = header[0];
+    index.num_sub = header[1];
+    index.sub_dim = header[2];
+    index.nbits = header[3];
+    int count = header[4];
+    
+    index.method.assign(method_len, '\0');
+    index.centroids.resize((size_t)index.num_sub * index.ksub() * index.sub_dim);
+    bool ok = fread(&index.method[0], sizeof(char), method_len, fp) == (size_t)method_len &&
+              fread(index.centroids.data(), sizeof(float), index.centroids.size(), fp) == index.centroids.size();
+    
+    index.filenames.clear();
+    for(int i = 0; ok && i < count; i++) {
+        int len = 0;
+        ok = fread(&len, sizeof(int), 1, fp) == 1;
+        if(!ok) break;
+        std::string name(len, '\0');
+        ok = fread(&name[0], sizeof(char), len, fp) == (size_t)len;
+        index.filenames.push_back(name);
+    }
+    
+    size_t num_codes = 0;
+    ok = ok && fread(&num_codes, sizeof(size_t), 1, fp) == 1;
+    if(ok) {
+        index.codes.resize(num_codes);
+        ok = fread(index.codes.data(), sizeof(unsigned char), num_codes, fp) == num_codes;
+    }
+    fclose(fp);
+    
+    if(!ok) {
+        printf("Truncated PQ index %s\n", filename);
+        return -1;
+    }
+    
+    return 0;
+}
+
+/*
+  Build the per-query lookup table
+  SSD:          table = ||q_m - c_mk||^2,        offset = 0
+  Intersection: table = -sum(min(q_m, c_mk)),    offset = 1
+*/
+void pq_distance_table(const PQIndex &index, const std::vector<float> &query, int metric,
+                       std::vector<float> &table, float &offset) {
+    int ksub = index.ksub();
+    int sub_dim = index.sub_dim;
+    table.assign((size_t)index.num_sub * ksub, 0.0f);
+    offset = (metric == PQ_INTERSECTION) ? 1.0f : 0.0f;
+    
+    std::vector<float> sub(sub_dim);
+    for(int m = 0; m < index.num_sub; m++) {
+        get_subvector(query, m, sub_dim, sub.data());
+        const float *cent = &index.centroids[(size_t)m * ksub * sub_dim];
+        
+        for(int k = 0; k < ksub; k++) {
+            const float *c = cent + (size_t)k * sub_dim;
+            float value = 0.0f;
+            if(metric == PQ_INTERSECTION) {
+                for(int j = 0; j < sub_dim; j++) value -= std::min(sub[j], c[j]);
+            } else {
+                value = sub_ssd(sub.data(), c, sub_dim);
+            }
+            table[(size_t)m * ksub + k] = value;
+        }
+    }
+}
+
+/*
+  8-bit ADC: one table lookup per subvector per image
+*/
+static void pq_scan8(const PQIndex &index, const std::vector<float> &table, float offset, std::vector<float> &distances) {
+    int num_sub = index.num_sub;
+    size_t n = index.filenames.size();
+    const unsigned char *codes = index.codes.data();
+    const float *t = table.data();
+    
+    for(size_t i = 0; i < n; i++) {
+        const unsigned char *code = codes + i * num_sub;
+        float d = offset;
+        for(int m = 0; m < num_sub; m++) {
+            d += t[m * 256 + code[m]];
+        }
+        distances[i] = d;
+    }
+}
+
+/*
+  4-bit fast scan: the float table is quantized to bytes
+    qtable[m][k] = round((table[m][k] - min_m) / delta)
+  so one 16-entry table fits in a register and 16 images are looked up with
+  one byte shuffle. Sums of up to 256 bytes fit in 16-bit accumulators.
+*/
+static void pq_scan4(const PQIndex &index, const std::vector<float> &table, float offset, std::vector<float> &distances) {
+    int num_sub = index.num_sub;
+    int pairs = index.code_bytes();
+    size_t n = index.filenames.size();
+    
+    // Quantize the table
+    float bias = offset;
+    float max_range = 0.0f;
+    std::vector<float> mins(num_sub);
+    for(int m = 0; m < num_sub; m++) {
+        const float *t = &table[m * 16];
+        mins[m] = *std::min_element(t, t + 16);
+        max_range = std::max(max_range, *std::max_element(t, t + 16) - mins[m]);
+        bias += mins[m];
+    }
+    float delta = max_range > 0.0f ? max_range / 255.0f : 1.0f;
+    
+    // Two subvectors per code byte; odd num_sub gets an all-zero last table
+    std::vector<unsigned char> qtable((size_t)pairs * 2 * 16, 0);
+    for(int m = 0; m < num_sub; m++) {
+        for(int k = 0; k < 16; k++) {
+            qtable[m * 16 + k] = (unsigned char)std::lround((table[m * 16 + k] - mins[m]) / delta);
+        }
+    }
+    
+    size_t num_blocks = (n + PQ_BLOCK - 1) / PQ_BLOCK;
+    unsigned short acc[PQ_BLOCK];
+    
+    for(size_t b = 0; b < num_blocks; b++) {
+        const unsigned char *block = &index.codes[b * pairs * PQ_BLOCK];
+        
+#if defined(__SSSE3__)
+        __m128i acc_lo = _mm_setzero_si128();
+        __m128i acc_hi = _mm_setzero_si128();
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i low_mask = _mm_set1_epi8(0x0f);
+        for(int p = 0; p < pairs; p++) {
+            __m128i packed = _mm_loadu_si128((const __m128i *)(block + p * PQ_BLOCK));
+            __m128i lut0 = _mm_loadu_si128((const __m128i *)&qtable[(2 * p) * 16]);
+            __m128i lut1 = _mm_loadu_si128((const __m128i *)&qtable[(2 * p + 1) * 16]);
+            __m128i idx0 = _mm_and_si128(packed, low_mask);
+            __m128i idx1 = _mm_and_si128(_mm_srli_epi16(packed, 4), low_mask);
+            __m128i v0 = _mm_shuffle_epi8(lut0, idx0);
+            __m128i v1 = _mm_shuffle_epi8(lut1, idx1);
+            acc_lo = _mm_add_epi16(acc_lo, _mm_add_epi16(_mm_unpacklo_epi8(v0, zero), _mm_unpacklo_epi8(v1, zero)));
+            acc_hi = _mm_add_epi16(acc_hi, _mm_add_epi16(_mm_unpackhi_epi8(v0, zero), _mm_unpackhi_epi8(v1, zero)));
+        }
+        _mm_storeu_si128((__m128i *)acc, acc_lo);
+        _mm_storeu_si128((__m128i *)(acc + 8), acc_hi);
+#elif defined(__ARM_NEON)
+        uint16x8_t acc_lo = vdupq_n_u16(0);
+        uint16x8_t acc_hi = vdupq_n_u16(0);
+        const uint8x16_t low_mask = vdupq_n_u8(0x0f);
+        for(int p = 0; p < pairs; p++) {
+            uint8x16_t packed = vld1q_u8(block + p * PQ_BLOCK);
+            uint8x16_t v0 = vqtbl1q_u8(vld1q_u8(&qtable[(2 * p) * 16]), vandq_u8(packed, low_mask));
+            uint8x16_t v1 = vqtbl1q_u8(vld1q_u8(&qtable[(2 * p + 1) * 16]), vshrq_n_u8(packed, 4));
+            acc_lo = vaddw_u8(vaddw_u8(acc_lo, vget_low_u8(v0)), vget_low_u8(v1));
+            acc_hi = vaddw_u8(vaddw_u8(acc_hi, vget_high_u8(v0)), vget_high_u8(v1));
+        }
+        vst1q_u16(acc, acc_lo);
+        vst1q_u16(acc + 8, acc_hi);
+#else
+        for(int i = 0; i < PQ_BLOCK; i++) acc[i] = 0;
+        for(int p = 0; p < pairs; p++) {
+            const unsigned char *packed = block + p * PQ_BLOCK;
+            for(int i = 0; i < PQ_BLOCK; i++) {
+                acc[i] += qtable[(2 * p) * 16 + (packed[i] & 0x0f)] + qtable[(2 * p + 1) * 16 + (packed[i] >> 4)];
+            }
+        }
+#endif
+        
+        for(int i = 0; i < PQ_BLOCK && b * PQ_BLOCK + i < n; i++) {
+            distances[b * PQ_BLOCK + i] = bias + delta * (float)acc[i];
+        }
+    }
+}
+
+/*
+  Asymmetric distance from the lookup table to every indexed image
+*/
+void pq_scan(const PQIndex &index, const std::vector<float> &table, float offset, std::vector<float> &distances) {
+    distances.resize(index.filenames.size());
+    if(index.nbits == 8) {
+        pq_scan8(index, table, offset, distances);
+    } else {
+        pq_scan4(index, table, offset, distances);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the product quantization (PQ) index with asymmetric distance lookup tables
+*/
+
+#ifndef PQ_INDEX_H
+#define PQ_INDEX_H
+
+#include <vector>
+#include <string>
+
+// Distances that split into a sum over dimensions, so they work with lookup tables
+enum PQMetric {
+    PQ_SSD = 0,             // sum of squared differences
+    PQ_INTERSECTION = 1     // 1 - sum(min(a, b)) for normalized histograms
+};
+
+/*
+  Product quantization index
+  Each feature vector is cut into num_sub subvectors of sub_dim values (zero padded)
+  and every subvector is replaced by the id of its nearest centroid:
+    nbits = 8: 256 centroids per subvector, 1 byte per subvector
+    nbits = 4: 16 centroids per subvector, 2 subvectors per byte, stored in
+               blocks of 16 images for SIMD shuffle-based table lookups
+*/
+struct PQIndex {
+    std::string method;                 // feature method the index was built from
+    int dim = 0;                        // original feature length
+    int num_sub = 0;                    // number of subvectors
+    int sub_dim = 0;                    // values per subvector (num_sub * sub_dim >= dim)
+    int nbits = 8;                      // bits per code (8 or 4)
+    std::vector<float> centroids;       // num_sub x ksub x sub_dim
+    std::vector<std::string> filenames;
+    std::vector<unsigned char> codes;   // see layout above
+
+    int ksub() const { return 1 << nbits; }
+    size_t code_bytes() const { return nbits == 8 ? num_sub : (num_sub + 1) / 2; }
+};
+
+/*
+  Train the codebooks with k-means on the given vectors (every one of them:
+  pass a sample, as pq_build --sample does, to bound the training cost)
+  Returns 0 on success, -1 on bad parameters
+*/
+int pq_train(const std::vector<std::vector<float>> &data, int num_sub, int nbits, int iterations, PQIndex &index);
+
+/*
+  Encode every vector with the trained codebooks and store it with its filename
+*/
+int pq_encode(const std::vector<std::vector<float>> &data, const std::vector<std::string> &filenames, PQIndex &index);
+
+/*
+  Write / read a PQ index file (codebooks, filenames and codes)
+*/
+int write_pq_index(const char *filename, const PQIndex &index);
+int read_pq_index(const char *filename, PQIndex &index);
+
+/*
+  Per-query lookup table: table[m * ksub + k] is the contribution of subvector m
+  when its code is k. Summing num_sub entries gives the asymmetric distance
+  (query kept exact, database vector quantized). offset is added once per image.
+*/
+void pq_distance_table(const PQIndex &index, const std::vector<float> &query, int metric,
+                       std::vector<float> &table, float &offset);
+
+/*
+  Asymmetric distance from the lookup table to every indexed image
+  The 4-bit variant quantizes the table to 8 bits and uses SIMD shuffles when available
+*/
+void pq_scan(const PQIndex &index, const std::vector<float> &table, float offset, std::vector<float> &distances);
+
+#endif
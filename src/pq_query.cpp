@@ -0,0 +1,229 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Query a product quantization index with asymmetric distances, optional exact re-ranking and recall measurement
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include "features.h"
+#include "distance.h"
+#include "csv_util.h"
+#include "pq_index.h"
+
+// Structure to hold an index position and its distance to target
+struct Candidate {
+    int idx;
+    float distance;
+    
+    // For sorting
+    bool operator<(const Candidate &other) const {
+        return distance < other.distance;
+    }
+};
+
+/*
+  Exact distance used for re-ranking and for ground truth
+*/
+static float exact_distance(const std::vector<float> &a, const std::vector<float> &b, int metric) {
+    if(metric == PQ_INTERSECTION) {
+        return histogram_intersection_distance(a, b);
+    }
+    return ssd_distance(a, b);
+}
+
+/*
+  Top n results for one query vector, skipping the image at position skip
+  ADC over the codes, then optionally re-rank the best rerank candidates exactly
+*/
+static void pq_search(const PQIndex &index, const std::vector<float> &query, int metric, int n, int skip,
+                      int rerank, const std::vector<const std::vector<float> *> &vectors,
+                      std::vector<Candidate> &results) {
+    std::vector<float> table, distances;
+    float offset = 0.0f;
+    pq_distance_table(index, query, metric, table, offset);
+    pq_scan(index, table, offset, distances);
+    
+    std::vector<Candidate> all;
+    all.reserve(distances.size());
+    for(size_t i = 0; i < distances.size(); i++) {
+        if((int)i != skip) {
+            all.push_back({(int)i, distances[i]});
+        }
+    }
+    
+    int keep = std::min((int)all.size(), std::max(n, rerank));
+    std::partial_sort(all.begin(), all.begin() + keep, all.end());
+    all.resize(keep);
+    
+    // Exact re-ranking of the shortlist
+    if(rerank > 0) {
+        for(Candidate &c : all) {
+            c.distance = exact_distance(query, *vectors[c.idx], metric);
+        }
+        std::sort(all.begin(), all.end());
+    }
+    
+    all.resize(std::min(n, (int)all.size()));
+    results = all;
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <index_file> <target_image> <N> [--features csv] [--metric ssd|intersection] [--rerank R] [--recall Q]\n", argv[0]);
+        printf("  target_image is an image name in --features, or a path to an image file\n");
+        printf("  --rerank R re-scores the R best ADC candidates with exact distances (needs --features)\n");
+        printf("  --recall Q measures recall@N against exhaustive search for Q queries (needs --features)\n");
+        printf("Example: ./pq_query olympus_multi.pq pic.0274.jpg 5 --features olympus_multi.csv --rerank 50\n");
+        return -1;
+    }
+    
+    char *index_file = argv[1];
+    char *target_filename = argv[2];
+    int N = atoi(argv[3]);
+    char *features_csv = NULL;
+    const char *metric_name = NULL;
+    int rerank = 0;
+    int recall_queries = 0;
+    
+    for(int i = 4; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--features") == 0) features_csv = argv[i + 1];
+        else if(strcmp(argv[i], "--metric") == 0) metric_name = argv[i + 1];
+        else if(strcmp(argv[i], "--rerank") == 0) rerank = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--recall") == 0) recall_queries = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    
+    if(N <= 0) {
+        printf("Error: N must be > 0\n");
+        return -1;
+    }
+    if((rerank > 0 || recall_queries > 0) && features_csv == NULL) {
+        printf("Error: --rerank and --recall need the exact vectors from --features\n");
+        return -1;
+    }
+    
+    // Load index
+    PQIndex index;
+    if(read_pq_index(index_file, index) != 0) {
+        return -1;
+    }
+    
+    // Histogram methods are compared with intersection, the baseline patch with SSD
+    int metric = (index.method == "baseline") ? PQ_SSD : PQ_INTERSECTION;
+    if(metric_name != NULL) {
+        if(strcmp(metric_name, "ssd") == 0) metric = PQ_SSD;
+        else if(strcmp(metric_name, "intersection") == 0) metric = PQ_INTERSECTION;
+        else {
+            printf("Error: metric must be 'ssd' or 'intersection'\n");
+            return -1;
+        }
+    }
+    
+    printf("Index: %s (%s, %lu images, %d x %d-bit codes = %lu bytes per image)\n",
+           index_file, index.method.c_str(), index.filenames.size(), index.num_sub, index.nbits, index.code_bytes());
+    
+    // Exact vectors, aligned with the index order
+    std::vector<std::vector<float>> data;
+    std::vector<const std::vector<float> *> vectors;
+    if(features_csv != NULL) {
+        std::vector<char *> filenames;
+        if(read_image_data_csv(features_csv, filenames, data) != 0) {
+            return -1;
+        }
+        
+        std::map<std::string, int> rows;
+        for(size_t i = 0; i < filenames.size(); i++) {
+            rows[filenames[i]] = i;
+            delete[] filenames[i];
+        }
+        
+        for(const std::string &name : index.filenames) {
+            auto it = rows.find(name);
+            if(it == rows.end()) {
+                printf("Error: %s is indexed but missing from %s\n", name.c_str(), features_csv);
+                return -1;
+            }
+            vectors.push_back(&data[it->second]);
+        }
+    }
+    
+    // Target vector: from the feature file when indexed, otherwise extracted from the image
+    std::vector<float> target;
+    int target_idx = -1;
+    for(size_t i = 0; i < index.filenames.size(); i++) {
+        if(index.filenames[i] == target_filename) target_idx = i;
+    }
+    if(target_idx >= 0 && !vectors.empty()) {
+        target = *vectors[target_idx];
+    } else {
+        cv::Mat img = cv::imread(target_filename);
+        if(img.empty() || extract_feature(index.method.c_str(), img, target) != 0) {
+            printf("Error: Cannot get a %s feature for %s\n", index.method.c_str(), target_filename);
+            return -1;
+        }
+    }
+    
+    // Single query
+    std::vector<Candidate> results;
+    auto start = std::chrono::steady_clock::now();
+    pq_search(index, target, metric, N, target_idx, rerank, vectors, results);
+    double query_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    printf("\nTop %lu matches%s:\n", results.size(), rerank > 0 ? " (re-ranked)" : " (ADC)");
+    for(size_t i = 0; i < results.size(); i++) {
+        printf("%lu. %s (distance: %.6f)\n", i + 1, index.filenames[results[i].idx].c_str(), results[i].distance);
+    }
+    printf("\nQuery time: %.3f ms\n", query_ms);
+    
+    // Recall@N against exhaustive exact search, queries spread over the index
+    if(recall_queries > 0) {
+        int n = index.filenames.size();
+        int q_count = std::min(recall_queries, n);
+        double recall_sum = 0.0, pq_ms = 0.0, exact_ms = 0.0;
+        
+        for(int q = 0; q < q_count; q++) {
+            int qi = (int)((long long)q * n / q_count);
+            const std::vector<float> &query = *vectors[qi];
+            
+            auto t0 = std::chrono::steady_clock::now();
+            std::vector<Candidate> approx;
+            pq_search(index, query, metric, N, qi, rerank, vectors, approx);
+            auto t1 = std::chrono::steady_clock::now();
+            
+            std::vector<Candidate> exact;
+            for(int i = 0; i < n; i++) {
+                if(i != qi) exact.push_back({i, exact_distance(query, *vectors[i], metric)});
+            }
+            int k = std::min(N, (int)exact.size());
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+            auto t2 = std::chrono::steady_clock::now();
+            
+            int hits = 0;
+            for(int a = 0; a < (int)approx.size(); a++) {
+                for(int e = 0; e < k; e++) {
+                    if(approx[a].idx == exact[e].idx) hits++;
+                }
+            }
+            recall_sum += k > 0 ? (double)hits / k : 1.0;
+            pq_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            exact_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        }
+        
+        printf("\nRecall@%d over %d queries: %.4f\n", N, q_count, recall_sum / q_count);
+        printf("Mean query time: PQ %.3f ms, exhaustive %.3f ms\n", pq_ms / q_count, exact_ms / q_count);
+    }
+    
+    return 0;
+}
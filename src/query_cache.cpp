@@ -0,0 +1,236 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the LRU query result cache and its file format
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "query_cache.h"
+
+static const char CACHE_MAGIC[4] = {'Q', 'C', 'A', 'C'};
+static const uint32_t CACHE_VERSION = 1;
+
+uint64_t query_hash_bytes(const void *data, size_t length, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t h = seed;
+    for(size_t i = 0; i < length; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t file_generation(const char *path) {
+    struct stat st;
+    if(stat(path, &st) != 0) return 0;
+    uint64_t fields[4] = {(uint64_t)st.st_ino, (uint64_t)st.st_size, (uint64_t)st.st_mtim.tv_sec,
+                          (uint64_t)st.st_mtim.tv_nsec};
+    return query_hash_bytes(fields, sizeof(fields));
+}
+
+bool QueryKey::operator==(const QueryKey &other) const {
+    return content == other.content && n == other.n && method == other.method && weights == other.weights;
+}
+
+size_t QueryKeyHash::operator()(const QueryKey &key) const {
+    uint64_t h = query_hash_bytes(&key.content, sizeof(key.content));
+    h = query_hash_bytes(key.method.data(), key.method.size(), h);
+    h = query_hash_bytes(key.weights.data(), key.weights.size() * sizeof(float), h);
+    return (size_t)query_hash_bytes(&key.n, sizeof(key.n), h);
+}
+
+/*
+  Approximate heap footprint of one entry, for the memory cap
+*/
+static size_t entry_bytes(const QueryKey &key, const QueryResult &result) {
+    size_t bytes = 128 + key.method.size() + key.weights.size() * sizeof(float);
+    for(const std::string &name : result.names) bytes += sizeof(std::string) + name.size() + sizeof(float);
+    return bytes;
+}
+
+QueryCache::QueryCache(size_t max_bytes) : max_bytes(max_bytes) {}
+
+void QueryCache::clear() {
+    entries.clear();
+    index.clear();
+    used_bytes = 0;
+}
+
+void QueryCache::evict_to(size_t limit) {
+    while(!entries.empty() && used_bytes > limit) {
+        used_bytes -= entries.back().bytes;
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+void QueryCache::set_generation(uint64_t g) {
+    if(g != generation) clear();
+    generation = g;
+}
+
+bool QueryCache::lookup(const QueryKey &key, QueryResult &result) {
+    auto it = index.find(key);
+    if(it == index.end()) {
+        miss_count++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->result;
+    hit_count++;
+    return true;
+}
+
+void QueryCache::insert(const QueryKey &key, const QueryResult &result) {
+    auto it = index.find(key);
+    if(it != index.end()) {
+        used_bytes -= it->second->bytes;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    
+    Entry entry = {key, result, entry_bytes(key, result)};
+    if(entry.bytes > max_bytes) return;
+    evict_to(max_bytes - entry.bytes);
+    entries.push_front(entry);
+    index[key] = entries.begin();
+    used_bytes += entry.bytes;
+}
+
+static void write_string(FILE *fp, const std::string &s) {
+    uint32_t length = s.size();
+    fwrite(&length, sizeof(uint32_t), 1, fp);
+    fwrite(s.data(), 1, length, fp);
+}
+
+static bool read_string(FILE *fp, std::string &s) {
+    uint32_t length;
+    if(fread(&length, sizeof(uint32_t), 1, fp) != 1 || length > (1u << 20)) return false;
+    s.resize(length);
+    return length == 0 || fread(&s[0], 1, length, fp) == length;
+}
+
+/*
+  Layout: "QCAC", u32 version, u64 generation, u64 hits, u64 misses, u32 entries,
+  then each entry from most to least recently used: u64 content hash, method,
+  u32 weight count, weights, i32 N, u32 result count, (name, f32 distance) each.
+  Written to a uniquely named temporary file in the same directory and renamed,
+  so readers never see a partial cache and concurrent writers never share one.
+*/
+int QueryCache::save(const char *path) const {
+    std::string tmp_path = std::string(path) + ".XXXXXX";
+    int fd = mkstemp(&tmp_path[0]);
+    FILE *fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+    if(!fp) {
+        printf("Unable to write query cache %s\n", tmp_path.c_str());
+        if(fd >= 0) {
+            close(fd);
+            remove(tmp_path.c_str());
+        }
+        return -1;
+    }
+    
+    // mkstemp creates the file 0600; give it the usual permissions
+    mode_t mask = umask(0);
+    umask(mask);
+    fchmod(fd, 0666 & ~mask);
+    
+    uint32_t count = entries.size();
+    fwrite(CACHE_MAGIC, 1, 4, fp);
+    fwrite(&CACHE_VERSION, sizeof(uint32_t), 1, fp);
+    fwrite(&generation, sizeof(uint64_t), 1, fp);
+    fwrite(&hit_count, sizeof(uint64_t), 1, fp);
+    fwrite(&miss_count, sizeof(uint64_t), 1, fp);
+    fwrite(&count, sizeof(uint32_t), 1, fp);
+    for(const Entry &e : entries) {
+        fwrite(&e.key.content, sizeof(uint64_t), 1, fp);
+        write_string(fp, e.key.method);
+        uint32_t num_weights = e.key.weights.size();
+        fwrite(&num_weights, sizeof(uint32_t), 1, fp);
+        if(num_weights > 0) fwrite(e.key.weights.data(), sizeof(float), num_weights, fp);
+        int32_t n = e.key.n;
+        fwrite(&n, sizeof(int32_t), 1, fp);
+        uint32_t num_results = e.result.names.size();
+        fwrite(&num_results, sizeof(uint32_t), 1, fp);
+        for(uint32_t i = 0; i < num_results; i++) {
+            write_string(fp, e.result.names[i]);
+            fwrite(&e.result.distances[i], sizeof(float), 1, fp);
+        }
+    }
+    
+    bool ok = !ferror(fp);
+    ok = fclose(fp) == 0 && ok;
+    if(!ok || rename(tmp_path.c_str(), path) != 0) {
+        printf("Error: Failed to write query cache %s\n", path);
+        remove(tmp_path.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+int QueryCache::load(const char *path) {
+    FILE *fp = fopen(path, "rb");
+    if(!fp) return 0;      // no cache yet
+    
+    char magic[4];
+    uint32_t version = 0, count = 0;
+    uint64_t file_gen = 0, hits = 0, misses = 0;
+    bool ok = fread(magic, 1, 4, fp) == 4 && memcmp(magic, CACHE_MAGIC, 4) == 0 &&
+              fread(&version, sizeof(uint32_t), 1, fp) == 1 && version == CACHE_VERSION &&
+              fread(&file_gen, sizeof(uint64_t), 1, fp) == 1 &&
+              fread(&hits, sizeof(uint64_t), 1, fp) == 1 &&
+              fread(&misses, sizeof(uint64_t), 1, fp) == 1 &&
+              fread(&count, sizeof(uint32_t), 1, fp) == 1;
+    if(!ok) {
+        printf("Error: %s is not a query cache\n", path);
+        fclose(fp);
+        return -1;
+    }
+    hit_count += hits;
+    miss_count += misses;
+    if(file_gen != generation) {
+        fclose(fp);
+        return 0;
+    }
+    
+    // Entries are stored most recent first; appending keeps that order
+    for(uint32_t e = 0; e < count && ok; e++) {
+        QueryKey key;
+        QueryResult result;
+        uint32_t num_weights = 0, num_results = 0;
+        int32_t n = 0;
+        ok = fread(&key.content, sizeof(uint64_t), 1, fp) == 1 && read_string(fp, key.method) &&
+             fread(&num_weights, sizeof(uint32_t), 1, fp) == 1 && num_weights <= 1024;
+        if(ok) {
+            key.weights.resize(num_weights);
+            ok = (num_weights == 0 || fread(key.weights.data(), sizeof(float), num_weights, fp) == num_weights) &&
+                 fread(&n, sizeof(int32_t), 1, fp) == 1 &&
+                 fread(&num_results, sizeof(uint32_t), 1, fp) == 1;
+        }
+        key.n = n;
+        for(uint32_t i = 0; i < num_results && ok; i++) {
+            std::string name;
+            float distance;
+            ok = read_string(fp, name) && fread(&distance, sizeof(float), 1, fp) == 1;
+            result.names.push_back(name);
+            result.distances.push_back(distance);
+        }
+        if(!ok || index.count(key)) continue;
+        
+        Entry entry = {key, result, entry_bytes(key, result)};
+        if(used_bytes + entry.bytes > max_bytes) break;
+        entries.push_back(entry);
+        index[key] = std::prev(entries.end());
+        used_bytes += entry.bytes;
+    }
+    fclose(fp);
+    if(!ok) {
+        printf("Warning: query cache %s is truncated, kept %lu entries\n", path, entries.size());
+    }
+    return 0;
+}
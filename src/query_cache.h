@@ -0,0 +1,111 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the LRU query result cache (in-process, optionally persisted to disk)
+*/
+
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <vector>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+
+/*
+  64-bit FNV-1a over raw bytes; pass a previous result as seed to continue it
+*/
+#define QUERY_HASH_SEED 1469598103934665603ULL
+uint64_t query_hash_bytes(const void *data, size_t length, uint64_t seed = QUERY_HASH_SEED);
+
+/*
+  Generation of an index or feature file: changes whenever the file is
+  rewritten (inode, size and modification time), 0 if it cannot be stat'ed
+*/
+uint64_t file_generation(const char *path);
+
+/*
+  What a query asked for: hash of the target image bytes (or of its feature
+  vector when the target is named), method, weights and N
+*/
+struct QueryKey {
+    uint64_t content = 0;
+    std::string method;
+    std::vector<float> weights;
+    int n = 0;
+
+    bool operator==(const QueryKey &other) const;
+};
+
+struct QueryKeyHash {
+    size_t operator()(const QueryKey &key) const;
+};
+
+/*
+  A cached ranking, best match first
+*/
+struct QueryResult {
+    std::vector<std::string> names;
+    std::vector<float> distances;
+};
+
+/*
+  Least-recently-used cache of query results under a memory cap
+  Every entry belongs to one index generation: set_generation() with a
+  different value drops them all, so results never outlive the index they
+  were computed from. Hit and miss counters are kept across save()/load().
+*/
+class QueryCache {
+public:
+    explicit QueryCache(size_t max_bytes);
+
+    /*
+      Switch to an index generation, clearing the cache if it changed
+    */
+    void set_generation(uint64_t generation);
+
+    /*
+      Copy out a cached result and mark it most recently used
+      Returns false (and counts a miss) if the key is not cached
+    */
+    bool lookup(const QueryKey &key, QueryResult &result);
+
+    /*
+      Add or replace a result, evicting least recently used entries until the cache fits
+    */
+    void insert(const QueryKey &key, const QueryResult &result);
+
+    /*
+      Persist to / restore from a file; load() keeps nothing if the file is
+      missing or was written for another generation (counters are kept)
+      Return 0 on success, -1 on error
+    */
+    int save(const char *path) const;
+    int load(const char *path);
+
+    size_t size() const { return entries.size(); }
+    size_t bytes() const { return used_bytes; }
+    uint64_t hits() const { return hit_count; }
+    uint64_t misses() const { return miss_count; }
+
+private:
+    struct Entry {
+        QueryKey key;
+        QueryResult result;
+        size_t bytes;
+    };
+
+    size_t max_bytes;
+    size_t used_bytes = 0;
+    uint64_t generation = 0;
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+    std::list<Entry> entries;      // most recently used first
+    std::unordered_map<QueryKey, std::list<Entry>::iterator, QueryKeyHash> index;
+
+    void clear();
+    void evict_to(size_t limit);
+};
+
+#endif
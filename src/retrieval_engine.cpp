@@ -0,0 +1,133 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of the shared retrieval engine used by the evaluation harness
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "csv_util.h"
+#include "distance.h"
+#include "features.h"
+#include "hybrid_index.h"
+#include "retrieval_engine.h"
+
+/*
+  Default pyramid (1x1, 2x2, 4x4) with each level weighted equally
+*/
+static float pyramid_distance(const std::vector<float> &a, const std::vector<float> &b) {
+    // Built once, on first use, even when pool threads score concurrently
+    static const std::vector<float> weights = [] {
+        std::vector<PyramidGrid> grids = {{1, 1}, {2, 2}, {4, 4}};
+        std::vector<float> w;
+        spatial_pyramid_weights(grids, w);
+        return w;
+    }();
+    return multi_region_intersection_distance(a, b, 512, weights);
+}
+
+/*
+  Task 7: one hybrid index record per image, ranked with task7_custom's default weights
+*/
+static float task7_distance(const std::vector<float> &a, const std::vector<float> &b) {
+    if(a.size() != HYBRID_STRIDE || b.size() != HYBRID_STRIDE) return -1.0f;
+    return hybrid_record_distance(a.data(), b.data(), 0.55f, 0.30f, 0.15f);
+}
+
+const std::vector<RetrievalMethod> &retrieval_methods() {
+    static const std::vector<RetrievalMethod> methods = {
+        {"baseline", ssd_distance, block_ssd_distances},
+        {"rgb", histogram_intersection_distance, block_intersection_distances},
+        {"hsv", histogram_intersection_distance, block_intersection_distances},
+        {"multi", [](const std::vector<float> &a, const std::vector<float> &b) {
+            return multi_region_intersection_distance(a, b, 512, std::vector<float>());
+        }, NULL},
+        {"pyramid", pyramid_distance, NULL},
+        {"color_texture", [](const std::vector<float> &a, const std::vector<float> &b) {
+            return color_texture_distance(a, b);
+        }, NULL},
+        {"laws", [](const std::vector<float> &a, const std::vector<float> &b) {
+            return color_laws_distance(a, b);
+        }, NULL},
+        {"gabor", [](const std::vector<float> &a, const std::vector<float> &b) {
+            return colorGaborDistance(a, b);
+        }, NULL},
+        {"dnn", cosine_distance, block_cosine_distances},
+        {"task7", task7_distance, NULL},
+    };
+    return methods;
+}
+
+const RetrievalMethod *find_retrieval_method(const char *name) {
+    for(const RetrievalMethod &m : retrieval_methods()) {
+        if(strcmp(m.name, name) == 0) return &m;
+    }
+    return NULL;
+}
+
+size_t FeatureDatabase::feature_bytes() const {
+    size_t total = 0;
+    for(const std::vector<float> &f : features) total += f.size() * sizeof(float);
+    return total;
+}
+
+/*
+  Copy the records of a task7_custom --build index into the database
+*/
+static int load_hybrid_database(const char *path, FeatureDatabase &db) {
+    HybridIndex index;
+    if(read_hybrid_index(path, index) != 0 || index.count == 0) {
+        return -1;
+    }
+    for(int i = 0; i < index.count; i++) {
+        db.names.push_back(index.names[i]);
+        db.features.emplace_back(index.record(i), index.record(i) + HYBRID_STRIDE);
+        db.rows[index.names[i]] = i;
+    }
+    return 0;
+}
+
+int load_feature_database(const char *csv_path, FeatureDatabase &db) {
+    std::vector<char *> filenames;
+    db.names.clear();
+    db.features.clear();
+    db.rows.clear();
+    
+    size_t length = strlen(csv_path);
+    if(length > 4 && strcmp(csv_path + length - 4, ".hyb") == 0) {
+        return load_hybrid_database(csv_path, db);
+    }
+    
+    if(read_image_data_csv((char *)csv_path, filenames, db.features, 0) != 0 || db.features.empty()) {
+        return -1;
+    }
+    for(size_t i = 0; i < filenames.size(); i++) {
+        db.names.push_back(filenames[i]);
+        db.rows[filenames[i]] = i;
+        delete[] filenames[i];
+    }
+    return 0;
+}
+
+void rank_images(const FeatureDatabase &db, const RetrievalMethod &method, int query_row, int depth,
+                 std::vector<int> &ranked) {
+    const std::vector<float> &query = db.features[query_row];
+    
+    std::vector<std::pair<float, int>> scored;
+    scored.reserve(db.features.size());
+    for(int i = 0; i < (int)db.features.size(); i++) {
+        if(i == query_row) continue;
+        scored.push_back({method.distance(query, db.features[i]), i});
+    }
+    
+    int keep = (depth <= 0) ? scored.size() : std::min(depth, (int)scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + keep, scored.end());
+    
+    ranked.resize(keep);
+    for(int i = 0; i < keep; i++) ranked[i] = scored[i].second;
+}
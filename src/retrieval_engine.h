@@ -0,0 +1,65 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for the shared retrieval engine: method registry, feature database and ranking
+*/
+
+#ifndef RETRIEVAL_ENGINE_H
+#define RETRIEVAL_ENGINE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include "block_kernels.h"
+
+typedef float (*FeatureDistance)(const std::vector<float> &feat1, const std::vector<float> &feat2);
+
+/*
+  A retrieval method: the build_features method name that produces its
+  features and the distance its matching program ranks with
+  block_distance is the same distance over column-blocked stores, NULL if the
+  method has none (its rows are then gathered and scored one at a time)
+*/
+struct RetrievalMethod {
+    const char *name;
+    FeatureDistance distance;
+    BlockDistance block_distance;
+};
+
+/*
+  All methods the engine knows (baseline, rgb, hsv, multi, pyramid,
+  color_texture, laws, gabor, dnn, task7)
+*/
+const std::vector<RetrievalMethod> &retrieval_methods();
+
+/*
+  Registered method by name, NULL if unknown
+*/
+const RetrievalMethod *find_retrieval_method(const char *name);
+
+/*
+  Feature vectors of every image, loaded from a build_features CSV
+*/
+struct FeatureDatabase {
+    std::vector<std::string> names;
+    std::vector<std::vector<float>> features;
+    std::map<std::string, int> rows;
+
+    size_t feature_bytes() const;
+};
+
+/*
+  Load a feature CSV (filename,v1,v2,...), or a Task 7 hybrid index
+  (a .hyb file from task7_custom --build, one record per image)
+  Returns 0 on success, -1 if the file cannot be read or is empty
+*/
+int load_feature_database(const char *csv_path, FeatureDatabase &db);
+
+/*
+  Rank all other images by distance to the query row
+  Keeps the closest depth images in order (all of them if depth <= 0)
+*/
+void rank_images(const FeatureDatabase &db, const RetrievalMethod &method, int query_row, int depth,
+                 std::vector<int> &ranked);
+
+#endif
@@ -0,0 +1,211 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Scale the image set out to an arbitrary size, either as augmented image files or as a
+           synthetic feature store that follows a method's real features
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <sys/stat.h>
+#include <opencv2/opencv.hpp>
+#include "synthetic_data.h"
+#include "retrieval_engine.h"
+#include "image_source.h"
+#include "image_pack.h"
+
+static void print_usage(const char *program) {
+    printf("Usage: %s images <image_directory|pack> <output_directory> <count> [--seed S] [--quality Q] [--pack file]\n", program);
+    printf("       %s features <features_csv> <method> <output_store> <count> [--seed S] [--threads T]\n", program);
+    printf("       [--mix M] [--noise F]\n");
+    printf("  images: count augmented copies (crop, flip, color jitter, resize) named syn.00000000.jpg, ...\n");
+    printf("          --quality: JPEG quality (default 90); --pack: also pack them into one file\n");
+    printf("  features: count synthetic rows of method's features written as a feature store (for stream_query)\n");
+    printf("          --threads: generator threads (default 4)\n");
+    printf("          --mix: largest weight given to the second real row of a mix (default 0.25)\n");
+    printf("          --noise: added noise in per-dimension standard deviations (default 0.05; none for histograms)\n");
+    printf("Example: ./scale_dataset images src/olympus olympus_100k 100000 --pack olympus_100k.pack\n");
+    printf("         ./scale_dataset features olympus_rgb.csv rgb rgb_10m.store 10000000\n");
+}
+
+static int scale_images(const char *input, const char *output_dir, uint64_t count, uint64_t seed, int quality,
+                        const char *pack_file) {
+    ImageSource source;
+    if(open_image_source(input, source) != 0) {
+        return -1;
+    }
+    if(source.count() == 0) {
+        printf("Error: No images in %s\n", input);
+        return -1;
+    }
+    if(mkdir(output_dir, 0755) != 0 && errno != EEXIST) {
+        printf("Error: Unable to create %s\n", output_dir);
+        return -1;
+    }
+    
+    // Copy k is made from source image k % n, so each source is decoded once
+    auto start = std::chrono::steady_clock::now();
+    int n = source.count();
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> failed{0};
+    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, quality};
+    cv::parallel_for_(cv::Range(0, n), [&](const cv::Range &range) {
+        char name[64];
+        for(int s = range.start; s < range.end; s++) {
+            if((uint64_t)s >= count) break;
+            cv::Mat img = read_source_image(source, s);
+            for(uint64_t k = s; k < count; k += n) {
+                cv::Mat copy;
+                if(!img.empty()) augment_image(img, seed, k, copy);
+                snprintf(name, sizeof(name), "syn.%08llu.jpg", (unsigned long long)k);
+                if(copy.empty() || !cv::imwrite(std::string(output_dir) + "/" + name, copy, params)) {
+                    failed++;
+                    continue;
+                }
+                written++;
+            }
+        }
+    });
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Wrote %llu augmented images from %d sources to %s in %.1f s (%.0f images/s)\n",
+           (unsigned long long)written.load(), n, output_dir, secs, written / std::max(secs, 1e-9));
+    if(failed > 0) {
+        printf("Warning: %llu images could not be made or written\n", (unsigned long long)failed.load());
+    }
+    
+    if(pack_file) {
+        std::vector<std::string> names, paths;
+        char name[64];
+        for(uint64_t k = 0; k < count; k++) {
+            snprintf(name, sizeof(name), "syn.%08llu.jpg", (unsigned long long)k);
+            struct stat st;
+            std::string path = std::string(output_dir) + "/" + name;
+            if(stat(path.c_str(), &st) != 0) continue;
+            names.push_back(name);
+            paths.push_back(path);
+        }
+        int packed = write_image_pack(pack_file, names, paths);
+        if(packed < 0) {
+            return -1;
+        }
+        printf("Packed %d images into %s\n", packed, pack_file);
+    }
+    return failed > 0 ? -1 : 0;
+}
+
+static void print_distribution_row(const char *label, const FeatureDistribution &dist) {
+    printf("%-10s %10.4f %12.4f %12.4f %12.4f\n", label, dist.zero_fraction, dist.distance_mean, dist.distance_stddev,
+           dist.nearest_mean);
+}
+
+static int scale_features(const char *features_csv, const char *method_name, const char *store_path, uint64_t count,
+                          uint64_t seed, int threads, float mix, float noise) {
+    const RetrievalMethod *method = find_retrieval_method(method_name);
+    if(!method) {
+        printf("Error: Unknown method %s\n", method_name);
+        return -1;
+    }
+    FeatureDatabase db;
+    if(load_feature_database(features_csv, db) != 0) {
+        return -1;
+    }
+    FeatureModel model;
+    if(fit_feature_model(db, model) != 0) {
+        return -1;
+    }
+    model.mix = mix;
+    model.noise = noise;
+    printf("Model: %lu real %d-d rows of %s; %s\n", model.count, model.dim, method_name,
+           model.fixed_sum ? "rows share one total (histogram), mixed without noise" : "mixed with per-dimension noise");
+    
+    auto start = std::chrono::steady_clock::now();
+    int64_t written = write_synthetic_store(store_path, model, count, seed, threads);
+    if(written < 0) {
+        return -1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double gb = written * (double)model.dim * sizeof(float) / 1e9;
+    printf("Wrote %lld synthetic rows (%.2f GB) to %s in %.1f s (%.0f rows/s)\n", (long long)written, gb, store_path,
+           secs, written / std::max(secs, 1e-9));
+    
+    // Compare the real rows with as many synthetic ones (nearest-neighbor distances depend on the set size)
+    size_t sample = std::min((uint64_t)model.count, count);
+    std::vector<float> synthetic(sample * model.dim);
+    for(size_t i = 0; i < sample; i++) {
+        synthesize_feature_row(model, seed, i, &synthetic[i * model.dim]);
+    }
+    FeatureDistribution real_dist, synthetic_dist;
+    describe_feature_distribution(model.rows.data(), model.count, model.dim, *method, 20000, 100, real_dist);
+    describe_feature_distribution(synthetic.data(), sample, model.dim, *method, 20000, 100, synthetic_dist);
+    
+    printf("\nDistribution (%lu rows each, %s distance)\n", sample, method_name);
+    printf("%-10s %10s %12s %12s %12s\n", "rows", "zeros", "pair mean", "pair stddev", "nearest");
+    print_distribution_row("real", real_dist);
+    print_distribution_row("synthetic", synthetic_dist);
+    
+    double mean_err = 0.0, spread_err = 0.0, spread = 0.0;
+    for(int d = 0; d < model.dim; d++) {
+        mean_err += std::fabs(real_dist.mean[d] - synthetic_dist.mean[d]);
+        spread_err += std::fabs(real_dist.stddev[d] - synthetic_dist.stddev[d]);
+        spread += real_dist.stddev[d];
+    }
+    printf("Per-dimension mean error %.3f and stddev error %.3f of the mean real stddev\n",
+           mean_err / std::max(spread, 1e-12), spread_err / std::max(spread, 1e-12));
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    
+    bool images = strcmp(argv[1], "images") == 0;
+    bool features = strcmp(argv[1], "features") == 0;
+    int positional = images ? 3 : 4;
+    if((!images && !features) || argc < 2 + positional) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    uint64_t count = strtoull(argv[1 + positional], NULL, 10);
+    if(count == 0) {
+        printf("Error: count must be positive\n");
+        return -1;
+    }
+    
+    uint64_t seed = 42;
+    int quality = 90;
+    const char *pack_file = NULL;
+    int threads = 4;
+    float mix = 0.25f;
+    float noise = 0.05f;
+    for(int i = 2 + positional; i < argc; i++) {
+        if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(images && i + 1 < argc && strcmp(argv[i], "--quality") == 0) quality = atoi(argv[++i]);
+        else if(images && i + 1 < argc && strcmp(argv[i], "--pack") == 0) pack_file = argv[++i];
+        else if(features && i + 1 < argc && strcmp(argv[i], "--threads") == 0) threads = std::max(1, atoi(argv[++i]));
+        else if(features && i + 1 < argc && strcmp(argv[i], "--mix") == 0) mix = atof(argv[++i]);
+        else if(features && i + 1 < argc && strcmp(argv[i], "--noise") == 0) noise = atof(argv[++i]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(mix < 0.0f || mix > 1.0f || noise < 0.0f) {
+        printf("Error: --mix must be in [0, 1] and --noise must not be negative\n");
+        return -1;
+    }
+    
+    if(images) {
+        return scale_images(argv[2], argv[3], count, seed, quality, pack_file) == 0 ? 0 : -1;
+    }
+    return scale_features(argv[2], argv[3], argv[4], count, seed, threads, mix, noise) == 0 ? 0 : -1;
+}
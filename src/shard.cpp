@@ -0,0 +1,187 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of shard assignment and the length-prefixed shard message protocol
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include "shard.h"
+
+// Largest accepted payload, guards against a corrupt length field
+static const unsigned int MAX_PAYLOAD = 64u << 20;
+
+/*
+  FNV-1a hash of the filename
+*/
+int shard_of_name(const char *image_filename, int num_shards) {
+    unsigned int h = 2166136261u;
+    for(const char *s = image_filename; *s != '\0'; s++) {
+        h ^= (unsigned char)*s;
+        h *= 16777619u;
+    }
+    return (int)(h % (unsigned int)num_shards);
+}
+
+/*
+  Contiguous ranges of roughly equal size
+*/
+int shard_of_row(int row, int total_rows, int num_shards) {
+    return (int)((long long)row * num_shards / total_rows);
+}
+
+void PayloadWriter::put_u32(unsigned int v) {
+    unsigned int n = htonl(v);
+    const unsigned char *p = (const unsigned char *)&n;
+    bytes.insert(bytes.end(), p, p + 4);
+}
+
+void PayloadWriter::put_f32(float v) {
+    unsigned int bits;
+    memcpy(&bits, &v, 4);
+    put_u32(bits);
+}
+
+void PayloadWriter::put_string(const std::string &s) {
+    put_u32(s.size());
+    bytes.insert(bytes.end(), s.begin(), s.end());
+}
+
+void PayloadWriter::put_floats(const std::vector<float> &v) {
+    put_u32(v.size());
+    for(float f : v) put_f32(f);
+}
+
+unsigned int PayloadReader::get_u32() {
+    if(pos + 4 > bytes.size()) {
+        ok = false;
+        return 0;
+    }
+    unsigned int n;
+    memcpy(&n, &bytes[pos], 4);
+    pos += 4;
+    return ntohl(n);
+}
+
+float PayloadReader::get_f32() {
+    unsigned int bits = get_u32();
+    float v;
+    memcpy(&v, &bits, 4);
+    return v;
+}
+
+std::string PayloadReader::get_string() {
+    unsigned int len = get_u32();
+    if(!ok || pos + len > bytes.size()) {
+        ok = false;
+        return std::string();
+    }
+    std::string s((const char *)&bytes[pos], len);
+    pos += len;
+    return s;
+}
+
+std::vector<float> PayloadReader::get_floats() {
+    unsigned int n = get_u32();
+    std::vector<float> v;
+    if(!ok || pos + (size_t)n * 4 > bytes.size()) {
+        ok = false;
+        return v;
+    }
+    v.reserve(n);
+    for(unsigned int i = 0; i < n; i++) v.push_back(get_f32());
+    return v;
+}
+
+/*
+  Write all bytes, retrying on short writes
+  A non-blocking fd whose buffer is full waits for it to drain, for at most
+  timeout_ms in total (-1: as long as it takes)
+*/
+static int write_all(int fd, const unsigned char *p, size_t n, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+    while(n > 0) {
+        ssize_t w = write(fd, p, n);
+        if(w < 0 && errno == EINTR) continue;
+        if(w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            int wait_ms = -1;
+            if(timeout_ms >= 0) {
+                wait_ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+                if(wait_ms <= 0) return -1;
+            }
+            pollfd pfd = {fd, POLLOUT, 0};
+            if(poll(&pfd, 1, wait_ms) < 0 && errno != EINTR) return -1;
+            if(pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) return -1;
+            continue;
+        }
+        if(w <= 0) return -1;
+        p += w;
+        n -= w;
+    }
+    return 0;
+}
+
+/*
+  Read exactly n bytes, -1 on EOF or error
+*/
+static int read_all(int fd, unsigned char *p, size_t n) {
+    while(n > 0) {
+        ssize_t r = read(fd, p, n);
+        if(r <= 0) return -1;
+        p += r;
+        n -= r;
+    }
+    return 0;
+}
+
+int write_frame(int fd, unsigned int type, unsigned int request_id, const std::vector<unsigned char> &payload,
+                int timeout_ms) {
+    PayloadWriter header;
+    header.put_u32(payload.size());
+    header.put_u32(type);
+    header.put_u32(request_id);
+    
+    // One buffer so a frame goes out in a single write where possible
+    header.bytes.insert(header.bytes.end(), payload.begin(), payload.end());
+    return write_all(fd, header.bytes.data(), header.bytes.size(), timeout_ms);
+}
+
+int read_frame(int fd, Frame &frame) {
+    std::vector<unsigned char> header(12);
+    if(read_all(fd, header.data(), 12) != 0) return -1;
+    
+    PayloadReader r(header);
+    unsigned int len = r.get_u32();
+    frame.type = r.get_u32();
+    frame.request_id = r.get_u32();
+    if(len > MAX_PAYLOAD) return -1;
+    
+    frame.payload.resize(len);
+    return len > 0 ? read_all(fd, frame.payload.data(), len) : 0;
+}
+
+void FrameBuffer::feed(const unsigned char *bytes, size_t n) {
+    data.insert(data.end(), bytes, bytes + n);
+}
+
+bool FrameBuffer::next(Frame &frame) {
+    if(data.size() < 12) return false;
+    
+    std::vector<unsigned char> header(data.begin(), data.begin() + 12);
+    PayloadReader r(header);
+    unsigned int len = r.get_u32();
+    if(data.size() < 12 + (size_t)len) return false;
+    
+    frame.type = r.get_u32();
+    frame.request_id = r.get_u32();
+    frame.payload.assign(data.begin() + 12, data.begin() + 12 + len);
+    data.erase(data.begin(), data.begin() + 12 + len);
+    return true;
+}
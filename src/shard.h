@@ -0,0 +1,91 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for feature store sharding and the coordinator <-> shard worker message protocol
+*/
+
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <vector>
+#include <string>
+
+/*
+  Shard assignment of an image
+  hash:  FNV-1a of the filename modulo num_shards
+  range: contiguous blocks of the store order (row * num_shards / total)
+*/
+int shard_of_name(const char *image_filename, int num_shards);
+int shard_of_row(int row, int total_rows, int num_shards);
+
+/*
+  Message types. Every frame is: u32 payload length, u32 type, u32 request id, payload.
+  All integers and floats are sent in network byte order, so the same frames
+  work over pipes, Unix sockets or TCP between hosts.
+*/
+enum ShardMessage {
+    MSG_SEARCH = 1,     // coordinator -> worker: k, metric, exclude name, query vector
+    MSG_FETCH = 2,      // coordinator -> worker: image name, reply with its vector if held
+    MSG_RESULTS = 3,    // worker -> coordinator: local top-k (name, distance)
+    MSG_VECTOR = 4,     // worker -> coordinator: feature vector (empty if not held)
+    MSG_QUIT = 5        // coordinator -> worker: exit
+};
+
+// Metrics understood by the workers
+enum ShardMetric {
+    SHARD_SSD = 0,
+    SHARD_INTERSECTION = 1
+};
+
+/*
+  One decoded frame
+*/
+struct Frame {
+    unsigned int type = 0;
+    unsigned int request_id = 0;
+    std::vector<unsigned char> payload;
+};
+
+/*
+  Payload builder / parser for the fixed-width fields
+*/
+struct PayloadWriter {
+    std::vector<unsigned char> bytes;
+    void put_u32(unsigned int v);
+    void put_f32(float v);
+    void put_string(const std::string &s);
+    void put_floats(const std::vector<float> &v);
+};
+
+struct PayloadReader {
+    const std::vector<unsigned char> &bytes;
+    size_t pos = 0;
+    bool ok = true;
+    explicit PayloadReader(const std::vector<unsigned char> &b) : bytes(b) {}
+    unsigned int get_u32();
+    float get_f32();
+    std::string get_string();
+    std::vector<float> get_floats();
+};
+
+/*
+  Blocking frame I/O (used by the workers). Return 0 on success, -1 on EOF or error.
+  On a non-blocking fd, write_frame waits up to timeout_ms for a full buffer to
+  drain (-1: no limit); a frame that times out is cut short, so the connection
+  must be dropped.
+*/
+int write_frame(int fd, unsigned int type, unsigned int request_id, const std::vector<unsigned char> &payload,
+                int timeout_ms = -1);
+int read_frame(int fd, Frame &frame);
+
+/*
+  Incremental frame decoder for non-blocking reads (used by the coordinator)
+  feed() appends bytes; next() pops one complete frame if available
+*/
+struct FrameBuffer {
+    std::vector<unsigned char> data;
+    void feed(const unsigned char *bytes, size_t n);
+    bool next(Frame &frame);
+};
+
+#endif
@@ -0,0 +1,311 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Scatter-gather coordinator - fans a query out to shard worker processes and merges their top-K
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <vector>
+#include <string>
+#include <queue>
+#include <chrono>
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "shard.h"
+
+// One local worker process and its connection
+struct Worker {
+    int shard;
+    pid_t pid = -1;
+    int fd = -1;
+    bool alive = false;
+    FrameBuffer buffer;
+};
+
+// One result row from a shard
+struct ShardMatch {
+    std::string filename;
+    float distance;
+};
+
+/*
+  Start a worker on a socketpair; the child talks the protocol on stdin/stdout
+*/
+static bool spawn_worker(Worker &w, const char *worker_path, const std::string &shard_file) {
+    int sv[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        return false;
+    }
+    
+    pid_t pid = fork();
+    if(pid < 0) {
+        close(sv[0]);
+        close(sv[1]);
+        return false;
+    }
+    if(pid == 0) {
+        dup2(sv[1], 0);
+        dup2(sv[1], 1);
+        close(sv[0]);
+        close(sv[1]);
+        execl(worker_path, worker_path, shard_file.c_str(), (char *)NULL);
+        _exit(127);
+    }
+    
+    close(sv[1]);
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+    w.pid = pid;
+    w.fd = sv[0];
+    w.alive = true;
+    return true;
+}
+
+/*
+  Send one request to every live worker, then collect replies with this
+  request id until all have answered or the deadline passes.
+  Workers that hang up, or stop reading until a send outlasts the deadline,
+  are marked dead; slow ones simply miss this round (their late reply is
+  discarded by request id next time).
+*/
+static std::vector<Frame> scatter_gather(std::vector<Worker> &workers, unsigned int type, unsigned int request_id,
+                                         const std::vector<unsigned char> &payload, int timeout_ms,
+                                         std::vector<bool> &answered) {
+    std::vector<Frame> replies(workers.size());
+    answered.assign(workers.size(), false);
+    
+    // The deadline covers the sends too, so a worker that stopped reading cannot block the query
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    auto remaining_ms = [&]() {
+        return (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    };
+    
+    int pending = 0;
+    for(Worker &w : workers) {
+        if(!w.alive) continue;
+        if(write_frame(w.fd, type, request_id, payload, std::max(remaining_ms(), 0)) != 0) {
+            w.alive = false;
+            continue;
+        }
+        pending++;
+    }
+    
+    unsigned char chunk[65536];
+    
+    while(pending > 0) {
+        int remaining = remaining_ms();
+        if(remaining <= 0) break;
+        
+        std::vector<pollfd> fds;
+        std::vector<int> which;
+        for(size_t i = 0; i < workers.size(); i++) {
+            if(workers[i].alive && !answered[i]) {
+                fds.push_back({workers[i].fd, POLLIN, 0});
+                which.push_back(i);
+            }
+        }
+        
+        if(poll(fds.data(), fds.size(), remaining) <= 0) continue;
+        
+        for(size_t p = 0; p < fds.size(); p++) {
+            if(fds[p].revents == 0) continue;
+            Worker &w = workers[which[p]];
+            
+            ssize_t n = read(w.fd, chunk, sizeof(chunk));
+            if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if(n <= 0) {
+                // Worker exited or the connection broke
+                w.alive = false;
+                pending--;
+                continue;
+            }
+            w.buffer.feed(chunk, n);
+            
+            Frame frame;
+            while(!answered[which[p]] && w.buffer.next(frame)) {
+                if(frame.request_id == request_id) {
+                    replies[which[p]] = frame;
+                    answered[which[p]] = true;
+                    pending--;
+                }
+            }
+        }
+    }
+    
+    return replies;
+}
+
+/*
+  K-way merge of the sorted per-shard lists
+*/
+static std::vector<ShardMatch> merge_top_k(const std::vector<std::vector<ShardMatch>> &lists, int k) {
+    typedef std::pair<float, std::pair<int, int>> Entry;   // distance, (list, position)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for(size_t l = 0; l < lists.size(); l++) {
+        if(!lists[l].empty()) heap.push({lists[l][0].distance, {(int)l, 0}});
+    }
+    
+    std::vector<ShardMatch> merged;
+    while(!heap.empty() && (int)merged.size() < k) {
+        Entry top = heap.top();
+        heap.pop();
+        int l = top.second.first;
+        int pos = top.second.second;
+        merged.push_back(lists[l][pos]);
+        if(pos + 1 < (int)lists[l].size()) {
+            heap.push({lists[l][pos + 1].distance, {l, pos + 1}});
+        }
+    }
+    return merged;
+}
+
+int main(int argc, char *argv[]) {
+    if(argc < 5) {
+        printf("Usage: %s <shard_prefix> <num_shards> <target_image_name> <N> [options]\n", argv[0]);
+        printf("  --metric ssd|intersection   distance used by the workers (default intersection)\n");
+        printf("  --timeout ms                per-query deadline; late shards are left out (default 1000)\n");
+        printf("  --repeat R                  run the query R times and report mean latency (default 1)\n");
+        printf("  --worker path               shard worker binary (default: shard_worker next to this program)\n");
+        printf("Example: ./shard_query olympus_rgb 4 pic.0164.jpg 5 --timeout 200\n");
+        return -1;
+    }
+    
+    const char *prefix = argv[1];
+    int num_shards = atoi(argv[2]);
+    std::string target_name = argv[3];
+    int N = atoi(argv[4]);
+    unsigned int metric = SHARD_INTERSECTION;
+    int timeout_ms = 1000;
+    int repeat = 1;
+    std::string worker_path;
+    
+    for(int i = 5; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--metric") == 0) metric = strcmp(argv[i + 1], "ssd") == 0 ? SHARD_SSD : SHARD_INTERSECTION;
+        else if(strcmp(argv[i], "--timeout") == 0) timeout_ms = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--repeat") == 0) repeat = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--worker") == 0) worker_path = argv[i + 1];
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(num_shards <= 0 || N <= 0 || repeat <= 0) {
+        printf("Error: num_shards, N and repeat must be > 0\n");
+        return -1;
+    }
+    
+    // Default worker binary lives next to this one
+    if(worker_path.empty()) {
+        std::string self = argv[0];
+        size_t slash = self.rfind('/');
+        worker_path = (slash == std::string::npos ? std::string(".") : self.substr(0, slash)) + "/shard_worker";
+    }
+    
+    // A dead worker must not kill the coordinator on write
+    signal(SIGPIPE, SIG_IGN);
+    
+    std::vector<Worker> workers(num_shards);
+    for(int s = 0; s < num_shards; s++) {
+        workers[s].shard = s;
+        std::string shard_file = std::string(prefix) + "." + std::to_string(s) + ".csv";
+        if(!spawn_worker(workers[s], worker_path.c_str(), shard_file)) {
+            printf("Warning: could not start worker for shard %d\n", s);
+        }
+    }
+    
+    // Phase 1: find the target's vector on whichever shard holds it
+    // (the first round also waits for workers to load, so it gets a longer deadline)
+    unsigned int request_id = 1;
+    std::vector<bool> answered;
+    PayloadWriter fetch;
+    fetch.put_string(target_name);
+    std::vector<Frame> replies = scatter_gather(workers, MSG_FETCH, request_id++, fetch.bytes,
+                                                std::max(timeout_ms, 60000), answered);
+    
+    std::vector<float> query;
+    int ready = 0;
+    for(int s = 0; s < num_shards; s++) {
+        if(!answered[s]) {
+            printf("Warning: shard %d did not start\n", s);
+            continue;
+        }
+        ready++;
+        PayloadReader r(replies[s].payload);
+        std::vector<float> vec = r.get_floats();
+        if(r.ok && !vec.empty()) query = vec;
+    }
+    
+    if(query.empty()) {
+        printf("Error: %s was not found on any responding shard (%d of %d up)\n", target_name.c_str(), ready, num_shards);
+    } else {
+        // Phase 2: scatter the search, gather local top-N lists, merge
+        PayloadWriter search;
+        search.put_u32(N);
+        search.put_u32(metric);
+        search.put_string(target_name);
+        search.put_floats(query);
+        
+        std::vector<ShardMatch> merged;
+        int responded = 0;
+        double total_ms = 0.0;
+        for(int r = 0; r < repeat; r++) {
+            auto start = std::chrono::steady_clock::now();
+            replies = scatter_gather(workers, MSG_SEARCH, request_id++, search.bytes, timeout_ms, answered);
+            
+            std::vector<std::vector<ShardMatch>> lists;
+            responded = 0;
+            for(int s = 0; s < num_shards; s++) {
+                if(!answered[s]) continue;
+                responded++;
+                PayloadReader in(replies[s].payload);
+                unsigned int count = in.get_u32();
+                std::vector<ShardMatch> list;
+                for(unsigned int i = 0; i < count && in.ok; i++) {
+                    ShardMatch m;
+                    m.filename = in.get_string();
+                    m.distance = in.get_f32();
+                    if(in.ok) list.push_back(m);
+                }
+                lists.push_back(list);
+            }
+            merged = merge_top_k(lists, N);
+            total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        
+        printf("Target image: %s\n", target_name.c_str());
+        printf("\nTop %lu matches%s:\n", merged.size(), responded < num_shards ? " (PARTIAL)" : "");
+        for(size_t i = 0; i < merged.size(); i++) {
+            printf("%lu. %s (distance: %.6f)\n", i + 1, merged[i].filename.c_str(), merged[i].distance);
+        }
+        printf("\nShards answered: %d of %d\n", responded, num_shards);
+        printf("Mean query latency: %.3f ms over %d runs\n", total_ms / repeat, repeat);
+    }
+    
+    // Shut down: ask politely (within the query deadline), then make sure nothing is left behind
+    for(Worker &w : workers) {
+        if(w.alive) write_frame(w.fd, MSG_QUIT, 0, std::vector<unsigned char>(), std::max(timeout_ms, 0));
+        if(w.fd >= 0) close(w.fd);
+    }
+    for(Worker &w : workers) {
+        if(w.pid <= 0) continue;
+        int status;
+        bool exited = false;
+        for(int i = 0; i < 50 && !exited; i++) {
+            exited = waitpid(w.pid, &status, WNOHANG) == w.pid;
+            if(!exited) usleep(10000);
+        }
+        if(!exited) {
+            kill(w.pid, SIGKILL);
+            waitpid(w.pid, &status, 0);
+        }
+    }
+    
+    return query.empty() ? -1 : 0;
+}
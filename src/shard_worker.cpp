@@ -0,0 +1,106 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Shard worker - holds one feature shard in memory and answers search requests with its local top-K
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unistd.h>
+#include "csv_util.h"
+#include "distance.h"
+#include "shard.h"
+
+// Structure to hold a shard row and its distance to the query
+struct ImageMatch {
+    int row;
+    float distance;
+    
+    // For sorting
+    bool operator<(const ImageMatch &other) const {
+        return distance < other.distance;
+    }
+};
+
+/*
+  Speaks the shard protocol on stdin/stdout, so the coordinator can run it
+  over a pipe or socketpair (or a socket forwarded from another host).
+  Log messages go to stderr to keep stdout clean for frames.
+*/
+int main(int argc, char *argv[]) {
+    if(argc < 2) {
+        fprintf(stderr, "Usage: %s <shard_csv>\n", argv[0]);
+        fprintf(stderr, "  normally started by shard_query, talks the shard protocol on stdin/stdout\n");
+        return -1;
+    }
+    
+    char *shard_csv = argv[1];
+    
+    // read_image_data_csv prints progress on stdout, which carries frames here
+    std::vector<char *> filenames;
+    std::vector<std::vector<float>> data;
+    fflush(stdout);
+    int saved_stdout = dup(1);
+    dup2(2, 1);
+    int status = read_image_data_csv(shard_csv, filenames, data);
+    fflush(stdout);
+    dup2(saved_stdout, 1);
+    close(saved_stdout);
+    if(status != 0) {
+        return -1;
+    }
+    
+    std::vector<std::string> names(filenames.begin(), filenames.end());
+    for(char *name : filenames) delete[] name;
+    
+    Frame request;
+    while(read_frame(0, request) == 0) {
+        PayloadReader in(request.payload);
+        PayloadWriter out;
+        
+        if(request.type == MSG_QUIT) {
+            break;
+        } else if(request.type == MSG_FETCH) {
+            std::string name = in.get_string();
+            std::vector<float> vec;
+            for(size_t i = 0; i < names.size(); i++) {
+                if(names[i] == name) vec = data[i];
+            }
+            out.put_floats(vec);
+            if(write_frame(1, MSG_VECTOR, request.request_id, out.bytes) != 0) break;
+        } else if(request.type == MSG_SEARCH) {
+            unsigned int k = in.get_u32();
+            unsigned int metric = in.get_u32();
+            std::string exclude = in.get_string();
+            std::vector<float> query = in.get_floats();
+            if(!in.ok) break;
+            
+            // Exhaustive scan of this shard
+            std::vector<ImageMatch> matches;
+            matches.reserve(data.size());
+            for(size_t i = 0; i < data.size(); i++) {
+                if(names[i] == exclude) continue;
+                float d = (metric == SHARD_INTERSECTION) ? histogram_intersection_distance(query, data[i])
+                                                         : ssd_distance(query, data[i]);
+                matches.push_back({(int)i, d});
+            }
+            
+            // Local top-K only
+            size_t keep = std::min((size_t)k, matches.size());
+            std::partial_sort(matches.begin(), matches.begin() + keep, matches.end());
+            
+            out.put_u32(keep);
+            for(size_t i = 0; i < keep; i++) {
+                out.put_string(names[matches[i].row]);
+                out.put_f32(matches[i].distance);
+            }
+            if(write_frame(1, MSG_RESULTS, request.request_id, out.bytes) != 0) break;
+        }
+    }
+    
+    return 0;
+}
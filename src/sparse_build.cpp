@@ -0,0 +1,47 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Convert a dense histogram CSV feature file into the sparse (bin:weight) feature store
+*/
+
+#include <cstdio>
+#include <vector>
+#include "csv_util.h"
+#include "sparse_hist.h"
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 3) {
+        printf("Usage: %s <features_csv> <sparse_csv>\n", argv[0]);
+        printf("Example: ./sparse_build olympus_rgb.csv olympus_rgb.sparse.csv\n");
+        return -1;
+    }
+    
+    char *features_csv = argv[1];
+    char *sparse_csv = argv[2];
+    
+    // Load dense histograms
+    std::vector<char *> filenames;
+    std::vector<std::vector<float>> data;
+    if(read_image_data_csv(features_csv, filenames, data) != 0 || data.empty()) {
+        printf("Error: No features in %s\n", features_csv);
+        return -1;
+    }
+    
+    // Write only the occupied bins
+    long long nonzero = 0;
+    int num_bins = data[0].size();
+    for(size_t i = 0; i < data.size(); i++) {
+        SparseHist sparse;
+        to_sparse_hist(data[i], sparse);
+        append_sparse_data_csv(sparse_csv, filenames[i], sparse.bins, sparse.weights, num_bins, i == 0);
+        nonzero += sparse.bins.size();
+        delete[] filenames[i];
+    }
+    
+    double mean_nonzero = (double)nonzero / data.size();
+    printf("Wrote %lu sparse histograms to %s\n", data.size(), sparse_csv);
+    printf("Mean occupied bins: %.1f of %d (%.1f%%)\n", mean_nonzero, num_bins, 100.0 * mean_nonzero / num_bins);
+    
+    return 0;
+}
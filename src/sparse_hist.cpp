@@ -0,0 +1,105 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of sparse histogram intersection and inverted-list candidate scoring
+*/
+
+#include <vector>
+#include <algorithm>
+#include "sparse_hist.h"
+
+/*
+  Keep only the nonzero bins, in ascending bin order
+*/
+void to_sparse_hist(const std::vector<float> &dense, SparseHist &sparse) {
+    sparse.bins.clear();
+    sparse.weights.clear();
+    for(int i = 0; i < (int)dense.size(); i++) {
+        if(dense[i] != 0.0f) {
+            sparse.bins.push_back(i);
+            sparse.weights.push_back(dense[i]);
+        }
+    }
+}
+
+/*
+  Expand a sparse histogram to num_bins dense bins
+*/
+void to_dense_hist(const SparseHist &sparse, int num_bins, std::vector<float> &dense) {
+    dense.assign(num_bins, 0.0f);
+    for(size_t i = 0; i < sparse.bins.size(); i++) {
+        dense[sparse.bins[i]] = sparse.weights[i];
+    }
+}
+
+/*
+  Sorted merge: min() is only nonzero where both histograms occupy the bin,
+  and the shared bins are visited in the same ascending order as the dense loop
+*/
+float sparse_intersection_distance(const SparseHist &a, const SparseHist &b) {
+    float intersection = 0.0f;
+    size_t i = 0, j = 0;
+    
+    while(i < a.bins.size() && j < b.bins.size()) {
+        if(a.bins[i] < b.bins[j]) {
+            i++;
+        } else if(a.bins[i] > b.bins[j]) {
+            j++;
+        } else {
+            intersection += std::min(a.weights[i], b.weights[j]);
+            i++;
+            j++;
+        }
+    }
+    
+    return 1.0f - intersection;
+}
+
+/*
+  Build the posting lists (images appear in ascending order in every list)
+*/
+void build_inverted_index(const std::vector<SparseHist> &hists, int num_bins, InvertedIndex &index) {
+    index.num_bins = num_bins;
+    index.num_images = hists.size();
+    index.lists.assign(num_bins, std::vector<Posting>());
+    
+    // Size the lists first so each is one allocation
+    std::vector<int> lengths(num_bins, 0);
+    for(const SparseHist &h : hists) {
+        for(int bin : h.bins) lengths[bin]++;
+    }
+    for(int b = 0; b < num_bins; b++) {
+        index.lists[b].reserve(lengths[b]);
+    }
+    
+    for(int img = 0; img < (int)hists.size(); img++) {
+        const SparseHist &h = hists[img];
+        for(size_t i = 0; i < h.bins.size(); i++) {
+            index.lists[h.bins[i]].push_back({img, h.weights[i]});
+        }
+    }
+}
+
+/*
+  Accumulate intersections over the query's posting lists
+  Query bins are visited in ascending order, so every image's sum is built in
+  the same order as the dense and merge versions and the results are identical
+*/
+void inverted_intersection_distances(const InvertedIndex &index, const SparseHist &query, std::vector<float> &distances) {
+    std::vector<float> scores(index.num_images, 0.0f);
+    
+    for(size_t i = 0; i < query.bins.size(); i++) {
+        if(query.bins[i] >= index.num_bins) {
+            continue;
+        }
+        float q = query.weights[i];
+        for(const Posting &p : index.lists[query.bins[i]]) {
+            scores[p.image] += std::min(q, p.weight);
+        }
+    }
+    
+    distances.resize(index.num_images);
+    for(int img = 0; img < index.num_images; img++) {
+        distances[img] = 1.0f - scores[img];
+    }
+}
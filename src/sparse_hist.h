@@ -0,0 +1,65 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for sparse histograms and the bin -> image inverted index
+*/
+
+#ifndef SPARSE_HIST_H
+#define SPARSE_HIST_H
+
+#include <vector>
+
+/*
+  Sparse histogram: only the nonzero bins, sorted by bin index
+*/
+struct SparseHist {
+    std::vector<int> bins;
+    std::vector<float> weights;
+};
+
+/*
+  One entry of a posting list: an image that has weight in the list's bin
+*/
+struct Posting {
+    int image;
+    float weight;
+};
+
+/*
+  Inverted index: for every bin, the images that occupy it
+*/
+struct InvertedIndex {
+    int num_bins = 0;
+    int num_images = 0;
+    std::vector<std::vector<Posting>> lists;
+};
+
+/*
+  Keep only the nonzero bins of a dense histogram
+*/
+void to_sparse_hist(const std::vector<float> &dense, SparseHist &sparse);
+
+/*
+  Expand a sparse histogram back to num_bins dense bins
+*/
+void to_dense_hist(const SparseHist &sparse, int num_bins, std::vector<float> &dense);
+
+/*
+  Histogram intersection distance by a sorted merge over the nonzero bins
+  Gives exactly the same value as histogram_intersection_distance on the dense form
+*/
+float sparse_intersection_distance(const SparseHist &a, const SparseHist &b);
+
+/*
+  Build the posting lists of a set of sparse histograms
+*/
+void build_inverted_index(const std::vector<SparseHist> &hists, int num_bins, InvertedIndex &index);
+
+/*
+  Intersection distance from the query to every image, accumulated only over
+  the posting lists of the query's occupied bins. Images that share no bin
+  with the query keep distance 1. Exact (same result as the dense scan).
+*/
+void inverted_intersection_distances(const InvertedIndex &index, const SparseHist &query, std::vector<float> &distances);
+
+#endif
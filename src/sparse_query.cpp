@@ -0,0 +1,178 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Exact histogram intersection queries over the sparse feature store using inverted lists
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <map>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include "csv_util.h"
+#include "distance.h"
+#include "sparse_hist.h"
+
+// Structure to hold image filename and its distance to target
+struct ImageMatch {
+    std::string filename;
+    float distance;
+    
+    // For sorting
+    bool operator<(const ImageMatch &other) const {
+        return distance < other.distance;
+    }
+};
+
+/*
+  Time one scoring function over all images, in milliseconds per query
+*/
+template <typename ScoreFn>
+static double time_ms(ScoreFn score, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < repeats; r++) {
+        score();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <sparse_csv> <target_image_name> <N> [dense_csv]\n", argv[0]);
+        printf("  dense_csv: the build_features CSV the store was built from; distances are checked against it\n");
+        printf("Example: ./sparse_query olympus_rgb.sparse.csv pic.0164.jpg 5 olympus_rgb.csv\n");
+        return -1;
+    }
+    
+    char *sparse_csv = argv[1];
+    char *target_name = argv[2];
+    int N = atoi(argv[3]);
+    char *dense_csv = (argc >= 5) ? argv[4] : NULL;
+    
+    // Load the sparse store
+    std::vector<char *> filenames;
+    std::vector<std::vector<int>> bins;
+    std::vector<std::vector<float>> weights;
+    int num_bins = 0;
+    if(read_sparse_data_csv(sparse_csv, filenames, bins, weights, num_bins) != 0 || filenames.empty()) {
+        printf("Error: No histograms in %s\n", sparse_csv);
+        return -1;
+    }
+    
+    int n = filenames.size();
+    int target_idx = -1;
+    std::vector<SparseHist> hists(n);
+    for(int i = 0; i < n; i++) {
+        hists[i].bins.swap(bins[i]);
+        hists[i].weights.swap(weights[i]);
+        if(strcmp(filenames[i], target_name) == 0) target_idx = i;
+    }
+    if(target_idx < 0) {
+        printf("Error: %s is not in %s\n", target_name, sparse_csv);
+        return -1;
+    }
+    
+    // Posting lists: bin -> (image, weight)
+    InvertedIndex index;
+    build_inverted_index(hists, num_bins, index);
+    
+    const SparseHist &query = hists[target_idx];
+    long long postings = 0;
+    for(int bin : query.bins) postings += index.lists[bin].size();
+    
+    printf("Target image: %s (%lu of %d bins occupied)\n", target_name, query.bins.size(), num_bins);
+    printf("Postings visited: %lld (dense scan reads %lld bins)\n", postings, (long long)n * num_bins);
+    
+    // Inverted-list scoring
+    std::vector<float> distances;
+    inverted_intersection_distances(index, query, distances);
+    
+    std::vector<ImageMatch> matches;
+    for(int i = 0; i < n; i++) {
+        if(i != target_idx) matches.push_back({filenames[i], distances[i]});
+    }
+    int k = std::min(N, (int)matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + k, matches.end());
+    
+    printf("\nTop %d matches:\n", k);
+    for(int i = 0; i < k; i++) {
+        printf("%d. %s (distance: %.6f)\n", i+1, matches[i].filename.c_str(), matches[i].distance);
+    }
+    
+    // The sorted merge is an independent sparse path; it must give the same distances
+    int merge_mismatches = 0;
+    for(int i = 0; i < n; i++) {
+        if(sparse_intersection_distance(query, hists[i]) != distances[i]) merge_mismatches++;
+    }
+    printf("\nExact match with sorted merge: %s (%d differing distances)\n", merge_mismatches == 0 ? "yes" : "NO",
+           merge_mismatches);
+    
+    // Exactness against the original dense features, which the sparse store was not derived from here
+    if(dense_csv) {
+        std::vector<char *> dense_names;
+        std::vector<std::vector<float>> original;
+        if(read_image_data_csv(dense_csv, dense_names, original) != 0 || original.empty()) {
+            printf("Error: No features in %s\n", dense_csv);
+            return -1;
+        }
+        std::map<std::string, int> dense_row;
+        for(size_t i = 0; i < dense_names.size(); i++) {
+            dense_row[dense_names[i]] = i;
+            delete[] dense_names[i];
+        }
+        
+        auto target_row = dense_row.find(target_name);
+        if(target_row == dense_row.end() || (int)original[target_row->second].size() != num_bins) {
+            printf("Error: %s has no %d-bin histogram for %s\n", dense_csv, num_bins, target_name);
+            return -1;
+        }
+        const std::vector<float> &dense_query = original[target_row->second];
+        
+        int mismatches = 0, missing = 0;
+        float max_error = 0.0f;
+        for(int i = 0; i < n; i++) {
+            auto row = dense_row.find(filenames[i]);
+            if(row == dense_row.end() || (int)original[row->second].size() != num_bins) {
+                missing++;
+                continue;
+            }
+            float expected = histogram_intersection_distance(dense_query, original[row->second]);
+            if(expected != distances[i]) mismatches++;
+            max_error = std::max(max_error, std::fabs(expected - distances[i]));
+        }
+        printf("Exact match with dense scan of %s: %s (%d differing distances, max |error| %g", dense_csv,
+               mismatches == 0 && missing == 0 ? "yes" : "NO", mismatches, max_error);
+        if(missing > 0) printf(", %d images missing", missing);
+        printf(")\n");
+    } else {
+        printf("Dense check skipped (pass the build_features CSV as dense_csv)\n");
+    }
+    
+    // Speed against a dense scan of the same histograms
+    std::vector<std::vector<float>> dense(n);
+    for(int i = 0; i < n; i++) to_dense_hist(hists[i], num_bins, dense[i]);
+    
+    std::vector<float> scratch(n);
+    int repeats = 20;
+    double dense_ms = time_ms([&]() {
+        for(int i = 0; i < n; i++) scratch[i] = histogram_intersection_distance(dense[target_idx], dense[i]);
+    }, repeats);
+    double merge_ms = time_ms([&]() {
+        for(int i = 0; i < n; i++) scratch[i] = sparse_intersection_distance(query, hists[i]);
+    }, repeats);
+    double inverted_ms = time_ms([&]() {
+        inverted_intersection_distances(index, query, scratch);
+    }, repeats);
+    
+    printf("Query time: dense %.3f ms, sorted merge %.3f ms (%.1fx), inverted lists %.3f ms (%.1fx)\n",
+           dense_ms, merge_ms, dense_ms / merge_ms, inverted_ms, dense_ms / inverted_ms);
+    
+    for(char *name : filenames) delete[] name;
+    
+    return 0;
+}
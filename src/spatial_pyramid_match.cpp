@@ -0,0 +1,109 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Spatial pyramid histogram matching with configurable grids (e.g. 1x1, 2x2, 4x4)
+*/
+
+#include <opencv2/opencv.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "features.h"
+#include "distance.h"
+#include "csv_util.h"
+#include "image_source.h"
+
+// Structure to hold image filename and its distance to target
+struct ImageMatch {
+    std::string filename;
+    float distance;
+    
+    // For sorting
+    bool operator<(const ImageMatch &other) const {
+        return distance < other.distance;
+    }
+};
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <target_image> <image_directory|pack> <num_matches> [grids]\n", argv[0]);
+        printf("Example: ./spatial_pyramid_match data/olympus/pic.0274.jpg data/olympus 5 1x1,2x2,4x4\n");
+        return -1;
+    }
+    
+    char *target_filename = argv[1];
+    char *directory = argv[2];
+    int num_matches = atoi(argv[3]);
+    const char *layout = (argc >= 5) ? argv[4] : "1x1,2x2,4x4";
+    
+    // Parse pyramid layout
+    std::vector<PyramidGrid> grids;
+    if(parse_pyramid_grids(layout, grids) != 0) {
+        printf("Error: Invalid grid layout %s (expected e.g. 1x1,2x2,4x4, at most %d cells per level)\n", layout,
+               PYRAMID_MAX_LEVEL_CELLS);
+        return -1;
+    }
+    
+    // Each level contributes equally, split over its cells
+    std::vector<float> region_weights;
+    spatial_pyramid_weights(grids, region_weights);
+    
+    // Read target image
+    cv::Mat target = cv::imread(target_filename);
+    if(target.empty()) {
+        printf("Error: Cannot read target image %s\n", target_filename);
+        return -1;
+    }
+    
+    // Extract spatial pyramid features from target
+    std::vector<float> target_features;
+    spatial_pyramid_feature(target, grids, target_features);
+    
+    printf("Target image: %s\n", target_filename);
+    printf("Feature vector size: %lu (spatial pyramid %s, %lu regions)\n",
+           target_features.size(), layout, region_weights.size());
+    
+    // Open the image directory or pack file
+    ImageSource source;
+    if(open_image_source(directory, source) != 0) {
+        return -1;
+    }
+    
+    // Store all matches
+    std::vector<ImageMatch> matches;
+    
+    // Loop through all images in the source
+    for(int i = 0; i < source.count(); i++) {
+        // Read image
+        cv::Mat img = read_source_image(source, i);
+        if(img.empty()) {
+            continue;
+        }
+        
+        // Extract spatial pyramid features
+        std::vector<float> features;
+        spatial_pyramid_feature(img, grids, features);
+        
+        // Weighted intersection over all pyramid regions
+        float distance = multi_region_intersection_distance(target_features, features, 512, region_weights);
+        
+        // Store match
+        ImageMatch match;
+        match.filename = source.names[i];
+        match.distance = distance;
+        matches.push_back(match);
+    }
+    
+    // Sort matches by distance
+    std::sort(matches.begin(), matches.end());
+    
+    // Print top N matches
+    printf("\nTop %d matches:\n", num_matches);
+    for(int i = 0; i < num_matches && i < matches.size(); i++) {
+        printf("%d. %s (distance: %.6f)\n", i+1, matches[i].filename.c_str(), matches[i].distance);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,325 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Out-of-core queries: convert a feature CSV into a binary feature store, then answer
+           top-N queries by streaming the store in chunks under a fixed memory budget
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <queue>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <sys/resource.h>
+#include <opencv2/opencv.hpp>
+#include "features.h"
+#include "feature_store.h"
+#include "retrieval_engine.h"
+#include "block_kernels.h"
+#include "parallel_scan.h"
+#include "query_cache.h"
+
+static void usage(const char *prog) {
+    printf("Usage: %s --convert <features.csv> <store> [--blocked]\n", prog);
+    printf("       %s <store> <target_image> <method> <N> [--mem-budget MB] [--load [--threads T] [--repeat R]]\n", prog);
+    printf("       %*s [--cache file [--cache-mb MB]]\n", (int)strlen(prog), "");
+    printf("  method: baseline, rgb, hsv, multi, pyramid, color_texture, laws, gabor, dnn\n");
+    printf("  target: an image file, or the name of an image already in the store\n");
+    printf("  --blocked: store images in blocks of %d, dimension-major, for batched SIMD scoring\n", FEATURE_BLOCK);
+    printf("  --mem-budget: bytes for the two chunk buffers, in MB (default 256)\n");
+    printf("  --load: read the whole store into memory and score it on a pool of threads\n");
+    printf("  --threads: scoring threads for --load (default: all cores)\n");
+    printf("  --repeat: run the in-memory query R times on the same pool, reporting the best (default 1)\n");
+    printf("  --cache: LRU result cache file, keyed by target content, method and N; reset when the store changes\n");
+    printf("  --cache-mb: memory cap of the cache in MB (default 64)\n");
+    printf("Example: ./stream_query --convert olympus_rgb.csv olympus_rgb.fst\n");
+    printf("         ./stream_query olympus_rgb.fst src/olympus/pic.0164.jpg rgb 5 --mem-budget 64\n");
+    printf("         ./stream_query olympus_rgb.fst pic.0164.jpg rgb 5 --load --threads 8\n");
+}
+
+// Candidate in the running top N (max-heap on distance)
+struct Candidate {
+    float distance;
+    uint64_t row;
+    bool operator<(const Candidate &other) const { return distance < other.distance; }
+};
+
+/*
+  Names of the ranked rows, looked up in one pass over the store's names
+*/
+static void fill_result(const char *store_path, const FeatureStoreInfo &info, const std::vector<uint64_t> &rows,
+                        const std::vector<float> &distances, QueryResult &result) {
+    feature_store_names(store_path, info, rows, result.names);
+    result.distances = distances;
+}
+
+static void print_matches(const QueryResult &result) {
+    printf("\nTop %lu matches:\n", result.names.size());
+    for(size_t i = 0; i < result.names.size(); i++) {
+        printf("%lu. %s (distance: %.6f)\n", i + 1, result.names[i].c_str(), result.distances[i]);
+    }
+}
+
+/*
+  Whole file into bytes; false if it cannot be read
+*/
+static bool read_file_bytes(const char *path, std::vector<unsigned char> &bytes) {
+    FILE *fp = fopen(path, "rb");
+    if(!fp) return false;
+    fseeko(fp, 0, SEEK_END);
+    off_t length = ftello(fp);
+    fseeko(fp, 0, SEEK_SET);
+    bytes.resize(length > 0 ? length : 0);
+    bool ok = length > 0 && fread(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+    fclose(fp);
+    return ok;
+}
+
+static double peak_rss_mb() {
+    struct rusage usage_info;
+    getrusage(RUSAGE_SELF, &usage_info);
+    return usage_info.ru_maxrss / 1024.0;
+}
+
+/*
+  Load the whole store, then answer the query on a persistent pool of threads
+*/
+static int in_memory_query(const char *store_path, const FeatureStoreInfo &info, const RetrievalMethod &method,
+                           const std::vector<float> &query, int num_matches, int threads, int repeat,
+                           QueryResult &result) {
+    auto load_start = std::chrono::steady_clock::now();
+    std::vector<float> data;
+    if(load_feature_store(store_path, info, data) != 0) {
+        return -1;
+    }
+    double load_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start).count();
+    
+    ScanPool pool(threads);
+    std::vector<ScanMatch> matches;
+    ParallelScanStats stats;
+    double best_secs = 1e30;
+    for(int r = 0; r < repeat; r++) {
+        parallel_top_k(pool, info, data, method, query, num_matches, matches, stats);
+        best_secs = std::min(best_secs, stats.secs);
+    }
+    
+    std::vector<uint64_t> rows;
+    std::vector<float> distances;
+    for(const ScanMatch &m : matches) {
+        rows.push_back(m.row);
+        distances.push_back(m.distance);
+    }
+    fill_result(store_path, info, rows, distances, result);
+    
+    double gb = info.count * info.row_bytes() / 1e9;
+    printf("Loaded %.2f GB in %.3f s\n", gb, load_secs);
+    printf("Scored %lu rows on %d threads in %.2f ms (best of %d): %.2f GB/s, %lu rows pruned by the shared threshold\n",
+           (unsigned long)info.count, pool.size(), best_secs * 1e3, repeat, best_secs > 0 ? gb / best_secs : 0.0,
+           (unsigned long)stats.pruned);
+    printf("Peak RSS %.1f MB\n", peak_rss_mb());
+    return 0;
+}
+
+/*
+  Stream the store through a bounded top-N under the memory budget
+*/
+static int streaming_query(const char *store_path, const FeatureStoreInfo &info, const RetrievalMethod &method,
+                           const std::vector<float> &query, int num_matches, size_t mem_budget, QueryResult &result) {
+    // Only the top N survive the scan
+    std::priority_queue<Candidate> best;
+    auto offer = [&](float distance, uint64_t row) {
+        if((int)best.size() < num_matches) {
+            best.push({distance, row});
+        } else if(distance < best.top().distance) {
+            best.pop();
+            best.push({distance, row});
+        }
+    };
+    
+    // Blocked stores are scored a whole block at a time when the method has a block kernel;
+    // otherwise each row is copied into one reused vector so every registered distance can score it
+    bool blocked = info.layout == FEATURE_STORE_BLOCKED;
+    bool batched = blocked && method.block_distance != NULL;
+    std::vector<float> row_vec(info.dim);
+    std::vector<float> block_dists;
+    StreamScanStats stats;
+    int status = stream_scan(store_path, info, mem_budget,
+        [&](uint64_t first_row, const float *rows, size_t num_rows) {
+            if(batched) {
+                size_t num_blocks = (num_rows + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+                block_dists.resize(num_blocks * FEATURE_BLOCK);
+                method.block_distance(rows, num_blocks, info.dim, query.data(), block_dists.data());
+                for(size_t r = 0; r < num_rows; r++) offer(block_dists[r], first_row + r);
+                return;
+            }
+            for(size_t r = 0; r < num_rows; r++) {
+                if(blocked) {
+                    const float *block = rows + (r / FEATURE_BLOCK) * FEATURE_BLOCK * info.dim;
+                    gather_block_row(block, info.dim, r % FEATURE_BLOCK, row_vec.data());
+                } else {
+                    const float *row = rows + r * info.dim;
+                    row_vec.assign(row, row + info.dim);
+                }
+                offer(method.distance(query, row_vec), first_row + r);
+            }
+        },
+        stats);
+    if(status != 0) {
+        return -1;
+    }
+    
+    std::vector<Candidate> matches;
+    while(!best.empty()) {
+        matches.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(matches.begin(), matches.end());
+    
+    std::vector<uint64_t> rows;
+    std::vector<float> distances;
+    for(const Candidate &c : matches) {
+        rows.push_back(c.row);
+        distances.push_back(c.distance);
+    }
+    fill_result(store_path, info, rows, distances, result);
+    
+    printf("Scanned %lu rows (%.2f GB) in %.3f s: %.2f GB/s\n", (unsigned long)stats.rows,
+           stats.bytes / 1e9, stats.secs, stats.secs > 0 ? stats.bytes / 1e9 / stats.secs : 0.0);
+    printf("Chunks of %lu rows (%.1f MB x 2), %.3f s waiting on reads, peak RSS %.1f MB\n",
+           (unsigned long)stats.chunk_rows, stats.chunk_rows * info.row_bytes() / 1048576.0,
+           stats.read_wait_secs, peak_rss_mb());
+    
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if(argc >= 4 && strcmp(argv[1], "--convert") == 0) {
+        bool blocked = argc >= 5 && strcmp(argv[4], "--blocked") == 0;
+        int64_t rows = convert_csv_to_feature_store(argv[2], argv[3], blocked ? FEATURE_STORE_BLOCKED : FEATURE_STORE_ROWS);
+        if(rows < 0) return -1;
+        FeatureStoreInfo info;
+        if(read_feature_store_info(argv[3], info) != 0) return -1;
+        printf("Wrote %ld rows of %d values to %s (%s)\n", (long)rows, info.dim, argv[3],
+               blocked ? "blocked" : "row-major");
+        return 0;
+    }
+    if(argc < 5) {
+        usage(argv[0]);
+        return -1;
+    }
+    
+    char *store_path = argv[1];
+    char *target = argv[2];
+    char *method_name = argv[3];
+    int num_matches = atoi(argv[4]);
+    size_t mem_budget = 256ul << 20;
+    bool load = false;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 1;
+    const char *cache_path = NULL;
+    double cache_mb = 64.0;
+    for(int i = 5; i < argc; i++) {
+        if(strcmp(argv[i], "--load") == 0) load = true;
+        else if(strcmp(argv[i], "--cache") == 0 && i + 1 < argc) cache_path = argv[++i];
+        else if(strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) cache_mb = atof(argv[++i]);
+        else if(strcmp(argv[i], "--mem-budget") == 0 && i + 1 < argc) mem_budget = (size_t)(atof(argv[++i]) * (1 << 20));
+        else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = atoi(argv[++i]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(threads < 1) threads = 1;
+    if(repeat < 1) repeat = 1;
+    
+    const RetrievalMethod *method = find_retrieval_method(method_name);
+    if(!method || num_matches <= 0) {
+        usage(argv[0]);
+        return -1;
+    }
+    
+    FeatureStoreInfo info;
+    if(read_feature_store_info(store_path, info) != 0) {
+        return -1;
+    }
+    
+    // Results cached for an older version of the store are dropped
+    QueryCache cache((size_t)(cache_mb * (1 << 20)));
+    if(cache_path) {
+        cache.set_generation(file_generation(store_path));
+        if(cache.load(cache_path) != 0) return -1;
+    }
+    QueryKey key;
+    key.method = method_name;
+    key.n = num_matches;
+    
+    printf("Target image: %s\n", target);
+    printf("Store: %lu rows x %d values (%.2f GB, %s)\n", (unsigned long)info.count, info.dim,
+           info.count * info.row_bytes() / 1e9, info.layout == FEATURE_STORE_BLOCKED ? "blocked" : "row-major");
+    
+    // Print a cached result if there is one for the key
+    // A hit only moves recency and the counters, which reach the file with the next miss,
+    // so repeated hits never rewrite the cache
+    auto lookup_start = std::chrono::steady_clock::now();
+    auto cache_hit = [&]() {
+        QueryResult cached;
+        if(!cache.lookup(key, cached)) return false;
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - lookup_start).count();
+        print_matches(cached);
+        printf("Cache: hit in %.1f us (%lu hits, %lu misses so far)\n", us, (unsigned long)cache.hits(),
+               (unsigned long)cache.misses());
+        return true;
+    };
+    
+    // An image file is keyed by its bytes, so a cache hit needs no decoding or extraction
+    std::vector<unsigned char> target_bytes;
+    bool is_file = read_file_bytes(target, target_bytes);
+    if(cache_path && is_file) {
+        key.content = query_hash_bytes(target_bytes.data(), target_bytes.size());
+        if(cache_hit()) return 0;
+    }
+    
+    // Query vector: extract it from the target image, or look the target up in the store
+    std::vector<float> query;
+    cv::Mat img;
+    if(is_file) img = cv::imdecode(cv::Mat(1, (int)target_bytes.size(), CV_8U, target_bytes.data()), cv::IMREAD_COLOR);
+    if(img.empty() || extract_feature(method_name, img, query) != 0) {
+        int64_t row = feature_store_find(store_path, info, target);
+        if(row < 0 || feature_store_row(store_path, info, row, query) != 0) {
+            printf("Error: %s is neither a readable image nor a name in %s\n", target, store_path);
+            return -1;
+        }
+        
+        // A named target is keyed by its feature vector
+        if(cache_path && !is_file) {
+            key.content = query_hash_bytes(query.data(), query.size() * sizeof(float));
+            if(cache_hit()) return 0;
+        }
+    }
+    if((int)query.size() != info.dim) {
+        printf("Error: query has %lu values but the store holds %d per row\n", query.size(), info.dim);
+        return -1;
+    }
+    
+    QueryResult result;
+    int status = load ? in_memory_query(store_path, info, *method, query, num_matches, threads, repeat, result)
+                      : streaming_query(store_path, info, *method, query, num_matches, mem_budget, result);
+    if(status != 0) {
+        return -1;
+    }
+    print_matches(result);
+    
+    if(cache_path) {
+        cache.insert(key, result);
+        cache.save(cache_path);
+        printf("Cache: miss (%lu hits, %lu misses so far, %lu entries, %.1f KB)\n", (unsigned long)cache.hits(),
+               (unsigned long)cache.misses(), cache.size(), cache.bytes() / 1024.0);
+    }
+    
+    return 0;
+}
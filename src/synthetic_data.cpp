@@ -0,0 +1,246 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Implementation of synthetic dataset generation: image augmentation, feature models,
+           synthetic feature stores and distribution summaries
+*/
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include "synthetic_data.h"
+#include "feature_writer.h"
+
+// Rows a generator thread claims at a time (well under FEATURE_WRITER_MAX_PENDING per thread)
+#define SYNTHETIC_BATCH 128
+
+/*
+  splitmix64 finalizer: spreads (seed, index) over the whole RNG state
+*/
+static uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static uint64_t item_seed(uint64_t seed, uint64_t index) {
+    uint64_t s = mix64(seed ^ mix64(index));
+    return s ? s : 1;
+}
+
+void augment_image(const cv::Mat &src, uint64_t seed, uint64_t index, cv::Mat &out) {
+    cv::RNG rng(item_seed(seed, index));
+    
+    // Crop
+    int cw = std::max(1, (int)std::lround(src.cols * rng.uniform(0.6, 1.0)));
+    int ch = std::max(1, (int)std::lround(src.rows * rng.uniform(0.6, 1.0)));
+    int x = rng.uniform(0, src.cols - cw + 1);
+    int y = rng.uniform(0, src.rows - ch + 1);
+    cv::Mat crop = src(cv::Rect(x, y, cw, ch));
+    
+    // Flip
+    cv::Mat flipped = crop;
+    if(rng.uniform(0, 2) == 1) cv::flip(crop, flipped, 1);
+    
+    // Color jitter: out_c = brightness * gain_c * in_c + offset, saturated
+    float brightness = rng.uniform(0.8f, 1.2f);
+    float offset = rng.uniform(-20.0f, 20.0f);
+    cv::Mat jittered;
+    if(flipped.channels() == 3) {
+        cv::Mat m = cv::Mat::zeros(3, 4, CV_32F);
+        for(int c = 0; c < 3; c++) {
+            m.at<float>(c, c) = brightness * rng.uniform(0.9f, 1.1f);
+            m.at<float>(c, 3) = offset;
+        }
+        cv::transform(flipped, jittered, m);
+    } else {
+        flipped.convertTo(jittered, -1, brightness, offset);
+    }
+    
+    // Resize
+    double scale = rng.uniform(0.5, 1.0);
+    cv::Size size(std::max(1, (int)std::lround(cw * scale)), std::max(1, (int)std::lround(ch * scale)));
+    cv::resize(jittered, out, size, 0, 0, cv::INTER_AREA);
+}
+
+int fit_feature_model(const FeatureDatabase &db, FeatureModel &model) {
+    if(db.features.empty() || db.features[0].empty()) {
+        printf("Error: No feature vectors to model\n");
+        return -1;
+    }
+    int dim = db.features[0].size();
+    size_t count = db.features.size();
+    model.dim = dim;
+    model.count = count;
+    model.rows.resize(count * dim);
+    for(size_t i = 0; i < count; i++) {
+        if((int)db.features[i].size() != dim) {
+            printf("Error: %s has %lu values, expected %d\n", db.names[i].c_str(), db.features[i].size(), dim);
+            return -1;
+        }
+        std::copy(db.features[i].begin(), db.features[i].end(), model.rows.begin() + i * dim);
+    }
+    
+    std::vector<double> sum(dim, 0.0), sum_sq(dim, 0.0);
+    model.lo.assign(model.rows.begin(), model.rows.begin() + dim);
+    model.hi = model.lo;
+    model.fixed_sum = true;
+    double first_total = 0.0;
+    for(size_t i = 0; i < count; i++) {
+        const float *row = &model.rows[i * dim];
+        double total = 0.0;
+        for(int d = 0; d < dim; d++) {
+            sum[d] += row[d];
+            sum_sq[d] += (double)row[d] * row[d];
+            model.lo[d] = std::min(model.lo[d], row[d]);
+            model.hi[d] = std::max(model.hi[d], row[d]);
+            total += row[d];
+        }
+        if(i == 0) first_total = total;
+        // CSV values carry 4 decimals, so totals of a normalized method differ by rounding
+        if(std::fabs(total - first_total) > 1e-4 * dim + 1e-3 * std::fabs(first_total)) model.fixed_sum = false;
+    }
+    if(first_total == 0.0) model.fixed_sum = false;
+    
+    model.stddev.resize(dim);
+    for(int d = 0; d < dim; d++) {
+        double mean = sum[d] / count;
+        model.stddev[d] = std::sqrt(std::max(0.0, sum_sq[d] / count - mean * mean));
+    }
+    return 0;
+}
+
+void synthesize_feature_row(const FeatureModel &model, uint64_t seed, uint64_t index, float *row) {
+    cv::RNG rng(item_seed(seed, index));
+    int dim = model.dim;
+    const float *a = &model.rows[(size_t)rng.uniform(0, (int)model.count) * dim];
+    const float *b = &model.rows[(size_t)rng.uniform(0, (int)model.count) * dim];
+    float t = rng.uniform(0.0f, model.mix);
+    
+    // Only a's non-zero dimensions move, so the row keeps a's sparsity
+    bool noisy = !model.fixed_sum && model.noise > 0.0f;
+    double a_total = 0.0, total = 0.0;
+    for(int d = 0; d < dim; d++) {
+        float v = 0.0f;
+        if(a[d] != 0.0f) {
+            v = (1.0f - t) * a[d] + t * b[d];
+            if(noisy) v += (float)rng.gaussian(model.noise * model.stddev[d]);
+            v = std::min(model.hi[d], std::max(model.lo[d], v));
+        }
+        row[d] = v;
+        a_total += a[d];
+        total += v;
+    }
+    
+    // Histograms go back to a's total
+    if(model.fixed_sum && total > 0.0) {
+        float scale = a_total / total;
+        for(int d = 0; d < dim; d++) row[d] *= scale;
+    }
+}
+
+int64_t write_synthetic_store(const char *store_path, const FeatureModel &model, uint64_t count, uint64_t seed,
+                              int threads) {
+    FeatureWriter writer;
+    if(writer.open(store_path, FEATURE_WRITER_STORE) != 0) {
+        return -1;
+    }
+    
+    // Threads claim batches of row numbers; the writer keeps rows in order
+    std::atomic<uint64_t> next{0};
+    std::atomic<bool> failed{false};
+    auto generator = [&]() {
+        std::vector<float> row(model.dim);
+        char name[64];
+        for(;;) {
+            uint64_t first = next.fetch_add(SYNTHETIC_BATCH);
+            if(first >= count) return;
+            uint64_t last = std::min(count, first + SYNTHETIC_BATCH);
+            for(uint64_t i = first; i < last; i++) {
+                if(failed) {
+                    writer.skip(i);
+                    continue;
+                }
+                synthesize_feature_row(model, seed, i, row.data());
+                snprintf(name, sizeof(name), "syn.%08llu.jpg", (unsigned long long)i);
+                if(writer.submit(i, name, row) != 0) failed = true;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for(int t = 1; t < threads; t++) workers.emplace_back(generator);
+    generator();
+    for(std::thread &w : workers) w.join();
+    
+    int64_t written = writer.close();
+    if(failed || written < 0) {
+        return -1;
+    }
+    return written;
+}
+
+void describe_feature_distribution(const float *rows, size_t count, int dim, const RetrievalMethod &method,
+                                   int pairs, int probes, FeatureDistribution &dist) {
+    dist = FeatureDistribution();
+    dist.mean.assign(dim, 0.0f);
+    dist.stddev.assign(dim, 0.0f);
+    if(count == 0) return;
+    
+    std::vector<double> sum(dim, 0.0), sum_sq(dim, 0.0);
+    size_t zeros = 0;
+    for(size_t i = 0; i < count; i++) {
+        const float *row = rows + i * dim;
+        for(int d = 0; d < dim; d++) {
+            sum[d] += row[d];
+            sum_sq[d] += (double)row[d] * row[d];
+            if(row[d] == 0.0f) zeros++;
+        }
+    }
+    for(int d = 0; d < dim; d++) {
+        double mean = sum[d] / count;
+        dist.mean[d] = mean;
+        dist.stddev[d] = std::sqrt(std::max(0.0, sum_sq[d] / count - mean * mean));
+    }
+    dist.zero_fraction = (double)zeros / ((double)count * dim);
+    if(count < 2) return;
+    
+    // Distances between random pairs of rows
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    std::vector<float> a(dim), b(dim);
+    double d_sum = 0.0, d_sum_sq = 0.0;
+    for(int p = 0; p < pairs; p++) {
+        size_t i = pick(rng), j = pick(rng);
+        if(i == j) j = (j + 1) % count;
+        a.assign(rows + i * dim, rows + (i + 1) * dim);
+        b.assign(rows + j * dim, rows + (j + 1) * dim);
+        double d = method.distance(a, b);
+        d_sum += d;
+        d_sum_sq += d * d;
+    }
+    if(pairs > 0) {
+        dist.distance_mean = d_sum / pairs;
+        dist.distance_stddev = std::sqrt(std::max(0.0, d_sum_sq / pairs - d_sum / pairs * d_sum / pairs));
+    }
+    
+    // Nearest other row of sampled rows
+    double nn_sum = 0.0;
+    for(int p = 0; p < probes; p++) {
+        size_t i = pick(rng);
+        a.assign(rows + i * dim, rows + (i + 1) * dim);
+        float best = 1e30f;
+        for(size_t j = 0; j < count; j++) {
+            if(j == i) continue;
+            b.assign(rows + j * dim, rows + (j + 1) * dim);
+            best = std::min(best, method.distance(a, b));
+        }
+        nn_sum += best;
+    }
+    if(probes > 0) dist.nearest_mean = nn_sum / probes;
+}
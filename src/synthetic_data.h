@@ -0,0 +1,85 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Header file for scaling a small image set out to large synthetic datasets (augmented images
+           and synthetic feature stores that follow a method's real feature distribution)
+*/
+
+#ifndef SYNTHETIC_DATA_H
+#define SYNTHETIC_DATA_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+#include "retrieval_engine.h"
+
+/*
+  Random augmentation of a source image, the same for the same (seed, index):
+  a crop of 60-100% of each side, a horizontal flip half the time, brightness
+  and per-channel color gains with an offset, and a resize to 50-100%
+*/
+void augment_image(const cv::Mat &src, uint64_t seed, uint64_t index, cv::Mat &out);
+
+/*
+  What a synthetic row is drawn from: the real feature vectors of a method
+  and their per-dimension spread and range
+  Histogram methods have rows that all sum to the same total; they get no
+  added noise and synthetic rows keep that total.
+*/
+struct FeatureModel {
+    int dim = 0;
+    std::vector<float> rows;        // real vectors, row-major (count x dim)
+    size_t count = 0;
+    std::vector<float> stddev;      // per dimension
+    std::vector<float> lo;
+    std::vector<float> hi;
+    bool fixed_sum = false;         // every real row sums to the same total
+    float mix = 0.25f;              // weight of the second source row is U(0, mix)
+    float noise = 0.05f;            // Gaussian noise, as a fraction of each dimension's stddev
+};
+
+/*
+  Model of the rows of a feature database
+  Returns 0 on success, -1 if the database is empty or the rows differ in length
+*/
+int fit_feature_model(const FeatureDatabase &db, FeatureModel &model);
+
+/*
+  Synthetic row number index (dim floats), the same for the same (seed, index)
+  A real row moved toward a second random real row by up to mix on its
+  non-zero dimensions (so it keeps its sparsity), plus per-dimension noise
+  clamped to the real range; histograms are scaled back to their total.
+  Every synthetic row is a variant of one real image, so a large set is made
+  of families of near neighbors, as augmented copies of the images would be.
+*/
+void synthesize_feature_row(const FeatureModel &model, uint64_t seed, uint64_t index, float *row);
+
+/*
+  Write count synthetic rows (named syn.00000000.jpg, ...) to a row-major
+  feature store, generating on threads threads
+  Returns the number of rows written, -1 on error
+*/
+int64_t write_synthetic_store(const char *store_path, const FeatureModel &model, uint64_t count, uint64_t seed,
+                              int threads);
+
+/*
+  How closely a set of rows follows the real ones
+*/
+struct FeatureDistribution {
+    std::vector<float> mean;        // per dimension
+    std::vector<float> stddev;
+    float zero_fraction = 0.0f;     // values that are exactly 0
+    float distance_mean = 0.0f;     // method distance between random pairs of rows
+    float distance_stddev = 0.0f;
+    float nearest_mean = 0.0f;      // distance from a sampled row to its nearest other row
+};
+
+/*
+  Distribution of count rows (row-major, dim wide) under method, using up to
+  pairs random pairs and up to probes nearest-neighbor probes
+*/
+void describe_feature_distribution(const float *rows, size_t count, int dim, const RetrievalMethod &method,
+                                   int pairs, int probes, FeatureDistribution &dist);
+
+#endif
@@ -10,11 +10,9 @@ compares images using cosine distance to find the most visually similar images.
 #include <cstdio>    // printf, fopen, fgets
 #include <cstdlib>   // atoi, atof, malloc, free
 #include <cstring>   // strcmp, strcpy, strtok
-#include <cmath>     // sqrt
 #include <vector>    // vector
-#include <map>       // map
 #include <string>    // string
-#include <algorithm> // (not required here, but okay to have)
+#include "embedding_store.h" // contiguous normalized embedding matrix
 
 using namespace std;
 
@@ -28,54 +26,10 @@ struct ImageMatch {
 // Distance Functions
 // ----------------------------
 
-// SSD: sum of squared differences
-// This is basically: (a1-b1)^2 + (a2-b2)^2 + ...
-float ssdDistance(const vector<float>& a, const vector<float>& b) {
-  // if they don't match sizes, something is wrong, so return huge distance
-    if (a.size() != b.size()) return 999999.0f;
-
-    float sum = 0.0f;
-
-  // loop through all 512 values
-    for (size_t i = 0; i < a.size(); i++) {
-    float diff = a[i] - b[i];
-    sum += diff * diff;
-    }
-
-    return sum;
-}
-
-// Cosine distance: 1 - cosine similarity
-// cosine similarity = (a dot b) / (||a|| * ||b||)
-float cosineDistance(const vector<float>& a, const vector<float>& b) {
-    if (a.size() != b.size()) return 2.0f;
-
-  float dot = 0.0f;   // a dot b
-  float magA = 0.0f;  // ||a||^2 (we'll sqrt later)
-  float magB = 0.0f;  // ||b||^2 (we'll sqrt later)
-
-    for (size_t i = 0; i < a.size(); i++) {
-    dot += a[i] * b[i];
-    magA += a[i] * a[i];
-    magB += b[i] * b[i];
-    }
-
-  // convert squared magnitude into magnitude
-    magA = sqrt(magA);
-    magB = sqrt(magB);
-
-  // avoid dividing by zero (just in case)
-    if (magA == 0.0f || magB == 0.0f) return 2.0f;
-
-  float cosSim = dot / (magA * magB);
-
-  // sometimes floating point gives like 1.0000001, so clamp
-    if (cosSim > 1.0f) cosSim = 1.0f;
-    if (cosSim < -1.0f) cosSim = -1.0f;
-
-  // distance should be smaller for more similar vectors
-    return 1.0f - cosSim;
-}
+// Cosine and SSD distances come from the shared embedding store:
+// rows are normalized once at load time, so cosine is one dot product per
+// image (embedding_cosine_distances); for SSD the original rows are kept
+// as well and compared value by value (embedding_ssd_distances).
 
 // ----------------------------
 // Sorting helper for qsort
@@ -91,59 +45,6 @@ int compareMatches(const void* a, const void* b) {
     return 0;
 }
 
-// ----------------------------
-// CSV Reading
-// ----------------------------
-
-// Reads the embeddings CSV into a map:
-//   db["pic.0001.jpg"] = vector<float>(512 values)
-map<string, vector<float>> readCSV(const char* filepath) {
-    map<string, vector<float>> db;
-
-  // open file
-    FILE* file = fopen(filepath, "r");
-    if (file == NULL) {
-    printf("Error: cannot open CSV file: %s\n", filepath);
-    return db;
-    }
-
-  // each line is pretty long (filename + 512 floats)
-  // so we make a big buffer
-    char line[40000];
-
-    int count = 0;
-
-  // read line by line
-    while (fgets(line, sizeof(line), file) != NULL) {
-    // 1) first token = filename
-    char* fname = strtok(line, ",");
-    if (fname == NULL) continue;
-
-    // 2) remaining tokens = float values
-    vector<float> feat;
-    feat.reserve(512); // makes it a little faster + avoids resizing
-
-    char* token = NULL;
-    while ((token = strtok(NULL, ",")) != NULL) {
-        feat.push_back((float)atof(token));
-    }
-
-    // sometimes bad lines happen, so we only keep correct rows
-    if (feat.size() == 512) {
-        db[string(fname)] = feat;
-        count++;
-    } else {
-      // if you want to debug weird CSV problems, you can print this:
-      // printf("Skipping %s because it has %lu values\n", fname, feat.size());
-    }
-    }
-
-    fclose(file);
-
-    printf("Loaded %d embeddings from CSV\n", count);
-    return db;
-}
-
 // ----------------------------
 // Main
 // ----------------------------
@@ -192,26 +93,24 @@ int main(int argc, char* argv[]) {
     printf("----------------------------------------\n\n");
 
   // load the embeddings database from CSV
-    map<string, vector<float>> db = readCSV(csvFile);
-
-  // if CSV reading failed, db will be empty
-    if (db.empty()) {
+  // (one aligned N x 512 matrix of normalized rows + a filename hash)
+    EmbeddingStore db;
+    if (load_embedding_store(csvFile, 512, db, useSSD) != 0) {
     printf("Error: database is empty (CSV load failed?)\n");
     return -1;
     }
+    printf("Loaded %d embeddings from CSV\n", db.count);
 
   // target MUST exist in the CSV (Task 5 says we get target from file too)
-    if (db.find(targetName) == db.end()) {
+    int targetRow = embedding_store_find(db, targetName.c_str());
+    if (targetRow < 0) {
     printf("Error: target image not found in CSV: %s\n", targetName.c_str());
     return -1;
     }
 
-  // get target embedding vector (512 floats)
-    const vector<float>& targetVec = db[targetName];
-
   // we will compute distances to every OTHER image
-  // so at most db.size() - 1 results
-    int maxResults = (int)db.size() - 1;
+  // so at most db.count - 1 results
+    int maxResults = db.count - 1;
     if (maxResults < 1) {
     printf("Error: not enough images in the database\n");
     return -1;
@@ -225,28 +124,24 @@ int main(int argc, char* argv[]) {
     return -1;
     }
 
-  // compute distances
-    int idx = 0;
+  // compute distances to every row in one pass over the matrix
+    vector<float> dists;
+    if (useSSD) embedding_ssd_distances(db, targetRow, dists);
+    else embedding_cosine_distances(db, targetRow, dists);
 
-    for (const auto& entry : db) {
-    const string& name = entry.first;
+    int idx = 0;
 
+    for (int i = 0; i < db.count; i++) {
     // IMPORTANT:
     // We do NOT want the target image to show up as a "match"
     // because it will always have distance 0
-    if (name == targetName) {
+    if (i == targetRow) {
         continue;
     }
 
-    const vector<float>& vec = entry.second;
-
-    float d = 0.0f;
-    if (useSSD) d = ssdDistance(targetVec, vec);
-    else d = cosineDistance(targetVec, vec);
-
     // store filename and distance
-    strcpy(matches[idx].name, name.c_str());
-    matches[idx].dist = d;
+    strcpy(matches[idx].name, db.names[i].c_str());
+    matches[idx].dist = dists[i];
     idx++;
     }
 
@@ -13,10 +13,14 @@
 #include <cstring>
 #include <cmath>
 #include <vector>
-#include <map>
 #include <string>
 #include <algorithm>
+#include <chrono>
 #include <opencv2/opencv.hpp>
+#include "embedding_store.h"
+#include "features.h"
+#include "hybrid_index.h"
+#include "image_source.h"
 
 using namespace std;
 
@@ -26,40 +30,9 @@ struct Match {
   float dist;
 };
 
-// helper function to keep values in range
-float clampf(float v, float lo, float hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
-}
-
-// compares two DNN feature vectors
-// basically just checks angle between them
-// closer angle = more similar
-float cosineDistance(const vector<float>& a, const vector<float>& b) {
-  if (a.size() != b.size()) return 2.0f;
-
-  float dot = 0.0f;
-  float magA = 0.0f;
-  float magB = 0.0f;
-
-  // the math
-  for (size_t i = 0; i < a.size(); i++) {
-    dot += a[i] * b[i];
-    magA += a[i] * a[i];
-    magB += b[i] * b[i];
-  }
-
-  magA = sqrt(magA);
-  magB = sqrt(magB);
-
-  if (magA == 0.0f || magB == 0.0f) return 2.0f;
-
-  float cosSim = dot / (magA * magB);
-  cosSim = clampf(cosSim, -1.0f, 1.0f);
-
-  return 1.0f - cosSim;
-}
+// DNN features live in the shared embedding store: rows are normalized
+// when the CSV is loaded, so cosine distance is a single dot product
+// (embedding_cosine_distances scores every image in one pass)
 
 // compares two histograms
 // just sees how much they overlap
@@ -82,123 +55,190 @@ void normalizeHist(vector<float>& h) {
   for (float &v : h) v /= sum;
 }
 
-// reads the CSV with DNN features
-map<string, vector<float>> readResNetCSV(const char* csvPath) {
-  map<string, vector<float>> db;
+// makes a color histogram using HSV
+// HSV is better than RGB cuz it handles lighting better
+// bins come straight from BGR (hsv_histogram_counts), no HSV image in between
 
-  FILE* f = fopen(csvPath, "r");
-  if (!f) {
-    printf("uh oh can't open %s\n", csvPath);
-    return db;
-  }
+// which of the 8 hue bins a hue (0-179) goes in
+int hueBin8(int H) {
+  return min((H * 8) / 180, 7);
+}
 
-  char line[40000];
-  int count = 0;
+vector<float> computeHSVHist128(const cv::Mat& bgr) {
+  vector<float> h(128, 0.0f);
 
-  while (fgets(line, sizeof(line), f)) {
-    char* fname = strtok(line, ",");
-    if (!fname) continue;
+  // idx = hBin * 16 + sBin * 4 + vBin, S and V split in 4 (value / 64)
+  int counts[128];
+  if (hsv_histogram_counts(bgr, hueBin8, counts) != 0) return h;
 
-    vector<float> feat;
-    feat.reserve(512);
+  for (int i = 0; i < 128; i++) h[i] = (float)counts[i];
 
-    char* tok = NULL;
-    while ((tok = strtok(NULL, ",")) != NULL) {
-      feat.push_back((float)atof(tok));
-    }
+  normalizeHist(h);
+  return h;
+}
 
-    if (feat.size() == 512) {
-      db[string(fname)] = feat;
-      count++;
-    }
-  }
+// makes histogram of edge directions
+// tells us if pic has mostly vertical lines, horizontal, diagonal, etc
+// sobel + binning is one fused pass (gradient_histogram_counts in features.cpp)
+vector<float> computeEdgeDirHist8(const cv::Mat& bgr) {
+  vector<float> h(8, 0.0f);
 
-  fclose(f);
-  printf("got %d images from CSV\n", count);
-  return db;
+  // 8 direction bins over pixels with |dx| + |dy| >= 20, weak edges skipped
+  int counts[GRADIENT_DIRECTION_BINS];
+  if (gradient_histogram_counts(bgr, NULL, counts) != 0) return h;
+
+  for (int i = 0; i < 8; i++) h[i] = (float)counts[i];
+
+  normalizeHist(h);
+  return h;
 }
 
-// makes a color histogram using HSV
-// HSV is better than RGB cuz it handles lighting better
-vector<float> computeHSVHist128(const cv::Mat& bgr) {
-  vector<float> h(128, 0.0f);
+// prints best and worst matches
+void printResults(const vector<Match>& results, int N) {
+  // show top matches
+  int topK = min(N, (int)results.size());
+  printf("\n========================================\n");
+  printf("top %d matches:\n", topK);
+  printf("========================================\n");
+  for (int i = 0; i < topK; i++) {
+    printf("%d. %s (dist: %.6f)\n", 
+           i + 1, results[i].name.c_str(), results[i].dist);
+  }
 
-  cv::Mat hsv;
-  cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+  // show worst matches
+  printf("\n========================================\n");
+  printf("bottom %d (least similar):\n", topK);
+  printf("========================================\n");
+  for (int i = 0; i < topK; i++) {
+    int idx = (int)results.size() - 1 - i;
+    printf("%d. %s (dist: %.6f)\n", 
+           i + 1, results[idx].name.c_str(), results[idx].dist);
+  }
+}
 
-  // go thru every pixel and count colors
-  for (int y = 0; y < hsv.rows; y++) {
-    const cv::Vec3b* row = hsv.ptr<cv::Vec3b>(y);
-    for (int x = 0; x < hsv.cols; x++) {
-      int H = row[x][0];
-      int S = row[x][1];
-      int V = row[x][2];
+// builds the hybrid index: runs the HSV and edge features on every image
+// once and stores them next to its embedding, so queries never open a JPEG
+int buildIndex(int argc, char* argv[]) {
+  if (argc < 5) {
+    printf("\nusage:\n");
+    printf("  %s --build <csv> <folder|pack> <index>\n", argv[0]);
+    return -1;
+  }
 
-      // figure out which bin
-      int hBin = (H * 8) / 180;
-      int sBin = (S * 4) / 256;
-      int vBin = (V * 4) / 256;
+  const char* csvFile = argv[2];
+  const char* imgFolder = argv[3];
+  const char* indexFile = argv[4];
 
-      hBin = min(hBin, 7);
-      sBin = min(sBin, 3);
-      vBin = min(vBin, 3);
+  EmbeddingStore dnnDB;
+  if (load_embedding_store(csvFile, 512, dnnDB) != 0) {
+    printf("no embeddings loaded, something went wrong\n");
+    return -1;
+  }
 
-      int idx = hBin * 16 + sBin * 4 + vBin;
-      h[idx] += 1.0f;
+  // folder can also be a pack file from cbir_pack
+  ImageSource source;
+  if (open_image_source(imgFolder, source) != 0) return -1;
+
+  vector<string> names;
+  vector<float> records;
+  for (int row = 0; row < dnnDB.count; row++) {
+    int idx = find_source_image(source, dnnDB.names[row]);
+    cv::Mat img;
+    if (idx >= 0) img = read_source_image(source, idx);
+    if (img.empty()) {
+      printf("skipping %s (can't read it)\n", dnnDB.names[row].c_str());
+      continue;
     }
+
+    vector<float> hsv  = computeHSVHist128(img);
+    vector<float> edge = computeEdgeDirHist8(img);
+
+    records.resize(records.size() + HYBRID_STRIDE);
+    hybrid_pack_record(dnnDB.row(row), dnnDB.norms[row], hsv, edge,
+                       &records[records.size() - HYBRID_STRIDE]);
+    names.push_back(dnnDB.names[row]);
   }
 
-  normalizeHist(h);
-  return h;
+  if (write_hybrid_index(indexFile, names, records) != 0) return -1;
+  printf("indexed %lu images into %s\n", names.size(), indexFile);
+  return 0;
 }
 
-// makes histogram of edge directions
-// tells us if pic has mostly vertical lines, horizontal, diagonal, etc
-vector<float> computeEdgeDirHist8(const cv::Mat& bgr) {
-  vector<float> h(8, 0.0f);
-
-  cv::Mat gray;
-  cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+// answers a query from the hybrid index only
+// weights are applied while scoring so changing them needs no rebuild
+int queryIndex(int argc, char* argv[]) {
+  if (argc < 5) {
+    printf("\nusage:\n");
+    printf("  %s --index <index> <target> <N> [wDNN wHSV wEDGE]\n", argv[0]);
+    return -1;
+  }
 
-  // use sobel to find edges
-  cv::Mat gx, gy;
-  cv::Sobel(gray, gx, CV_32F, 1, 0, 3);
-  cv::Sobel(gray, gy, CV_32F, 0, 1, 3);
+  const char* indexFile = argv[2];
+  string targetName = argv[3];
+  int N = atoi(argv[4]);
+  if (N <= 0) {
+    printf("N needs to be positive\n");
+    return -1;
+  }
 
-  for (int y = 0; y < gray.rows; y++) {
-    const float* gxRow = gx.ptr<float>(y);
-    const float* gyRow = gy.ptr<float>(y);
+  float wDNN  = 0.55f;
+  float wHSV  = 0.30f;
+  float wEDGE = 0.15f;
+  if (argc >= 8) {
+    wDNN  = (float)atof(argv[5]);
+    wHSV  = (float)atof(argv[6]);
+    wEDGE = (float)atof(argv[7]);
+  }
 
-    for (int x = 0; x < gray.cols; x++) {
-      float dx = gxRow[x];
-      float dy = gyRow[x];
+  HybridIndex index;
+  if (read_hybrid_index(indexFile, index) != 0) return -1;
 
-      // skip if edge is too weak
-      float mag = fabs(dx) + fabs(dy);
-      if (mag < 20.0f) continue;
+  int targetRow = hybrid_index_find(index, targetName.c_str());
+  if (targetRow < 0) {
+    printf("can't find %s in the index\n", targetName.c_str());
+    return -1;
+  }
 
-      // get angle
-      float ang = atan2(dy, dx);
-      if (ang < 0) ang += 2.0f * (float)M_PI;
+  printf("target: %s\n", targetName.c_str());
+  printf("weights: dnn=%.2f color=%.2f edges=%.2f\n", wDNN, wHSV, wEDGE);
 
-      // put in bin
-      int bin = (int)(ang / (2.0f * (float)M_PI) * 8.0f);
-      if (bin < 0) bin = 0;
-      if (bin > 7) bin = 7;
+  auto start = chrono::steady_clock::now();
+  vector<float> dists;
+  hybrid_distances(index, targetRow, wDNN, wHSV, wEDGE, dists);
 
-      h[bin] += 1.0f;
-    }
+  vector<Match> results;
+  results.reserve(index.count);
+  for (int row = 0; row < index.count; row++) {
+    if (row == targetRow) continue;
+    Match m;
+    m.name = index.names[row];
+    m.dist = dists[row];
+    results.push_back(m);
   }
+  sort(results.begin(), results.end(),
+       [](const Match& a, const Match& b) { return a.dist < b.dist; });
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
 
-  normalizeHist(h);
-  return h;
+  printf("scored %d images in %.3f ms\n", index.count, ms);
+  if (results.empty()) {
+    printf("no other images in the index\n");
+    return -1;
+  }
+  printResults(results, N);
+  return 0;
 }
 
 int main(int argc, char* argv[]) {
   
+  // index modes: precompute once, then query without touching images
+  if (argc >= 2 && strcmp(argv[1], "--build") == 0) return buildIndex(argc, argv);
+  if (argc >= 2 && strcmp(argv[1], "--index") == 0) return queryIndex(argc, argv);
+
   if (argc < 5) {
     printf("\nusage:\n");
     printf("  %s <csv> <folder> <target> <N> [wDNN wHSV wEDGE]\n", argv[0]);
+    printf("  %s --build <csv> <folder|pack> <index>\n", argv[0]);
+    printf("  %s --index <index> <target> <N> [wDNN wHSV wEDGE]\n", argv[0]);
     printf("\nexample:\n");
     printf("  %s embeddings.csv olympus pic.1062.jpg 5\n\n", argv[0]);
     return -1;
@@ -240,14 +280,16 @@ int main(int argc, char* argv[]) {
 
   // load the DNN stuff
   printf("loading DNN features...\n");
-  map<string, vector<float>> dnnDB = readResNetCSV(csvFile);
-  if (dnnDB.empty()) {
+  EmbeddingStore dnnDB;
+  if (load_embedding_store(csvFile, 512, dnnDB) != 0) {
     printf("no embeddings loaded, something went wrong\n");
     return -1;
   }
 
   // check target exists
-  if (dnnDB.find(targetName) == dnnDB.end()) {
+  printf("got %d images from CSV\n", dnnDB.count);
+  int targetRow = embedding_store_find(dnnDB, targetName.c_str());
+  if (targetRow < 0) {
     printf("can't find %s in the CSV\n", targetName.c_str());
     return -1;
   }
@@ -263,25 +305,26 @@ int main(int argc, char* argv[]) {
 
   // get all features from target
   printf("extracting features from target...\n");
-  const vector<float>& targetDNN = dnnDB[targetName];
+  vector<float> dnnDists;
+  embedding_cosine_distances(dnnDB, targetRow, dnnDists);
   vector<float> targetHSV  = computeHSVHist128(targetImg);
   vector<float> targetEdge = computeEdgeDirHist8(targetImg);
   
-  printf("  dnn: %lu dims\n", targetDNN.size());
+  printf("  dnn: %d dims\n", dnnDB.dim);
   printf("  color bins: %lu\n", targetHSV.size());
   printf("  edge bins: %lu\n", targetEdge.size());
 
   // now compare with every other image
   printf("\ncomparing with all images...\n");
   vector<Match> results;
-  results.reserve((int)dnnDB.size());
+  results.reserve(dnnDB.count);
 
   int compared = 0;
-  for (const auto& it : dnnDB) {
-    const string& name = it.first;
+  for (int row = 0; row < dnnDB.count; row++) {
+    const string& name = dnnDB.names[row];
 
     // doesn't compare with itself
-    if (name == targetName) continue;
+    if (row == targetRow) continue;
 
     // load image
     string path = string(imgFolder) + "/" + name;
@@ -289,12 +332,11 @@ int main(int argc, char* argv[]) {
     if (img.empty()) continue;
 
     // get features
-    const vector<float>& dnn = it.second;
     vector<float> hsv  = computeHSVHist128(img);
     vector<float> edge = computeEdgeDirHist8(img);
 
     // calculate each distance
-    float dDNN  = cosineDistance(targetDNN, dnn);
+    float dDNN  = dnnDists[row];
     float dHSV  = histIntersectionDist(targetHSV, hsv);
     float dEDGE = histIntersectionDist(targetEdge, edge);
 
@@ -321,25 +363,7 @@ int main(int argc, char* argv[]) {
   sort(results.begin(), results.end(),
        [](const Match& a, const Match& b) { return a.dist < b.dist; });
 
-  // show top matches
-  int topK = min(N, (int)results.size());
-  printf("\n========================================\n");
-  printf("top %d matches:\n", topK);
-  printf("========================================\n");
-  for (int i = 0; i < topK; i++) {
-    printf("%d. %s (dist: %.6f)\n", 
-           i + 1, results[i].name.c_str(), results[i].dist);
-  }
-
-  // show worst matches
-  printf("\n========================================\n");
-  printf("bottom %d (least similar):\n", topK);
-  printf("========================================\n");
-  for (int i = 0; i < topK; i++) {
-    int idx = (int)results.size() - 1 - i;
-    printf("%d. %s (dist: %.6f)\n", 
-           i + 1, results[idx].name.c_str(), results[idx].dist);
-  }
+  printResults(results, N);
 
   printf("\n========================================\n");
   printf("done!\n");
@@ -0,0 +1,263 @@
+/*
+  Name: Sushma Ramesh, Dina Barua
+  Date: October 18, 2026
+  Purpose: Grid search over the component weights of a combined distance, scored against labeled queries
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <map>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "csv_util.h"
+#include "distance.h"
+#include "features.h"
+#include "hybrid_index.h"
+#include "ground_truth.h"
+
+/*
+  Component distances of one labeled query to every image, computed once:
+  components[c * num_images + i]
+*/
+struct CachedQuery {
+    int query;
+    std::vector<int> relevant;
+    std::vector<float> components;
+};
+
+// Quality of one weighting over all queries
+struct SweepResult {
+    std::vector<float> weights;
+    float precision;
+    float map;
+};
+
+/*
+  Unweighted component distances of the combined CSV features
+*/
+static int feature_components(const std::string &method, const std::vector<std::vector<float>> &data,
+                              int q, std::vector<float> &components) {
+    int n = data.size();
+    components.resize((size_t)2 * n);
+    
+    for(int i = 0; i < n; i++) {
+        float color = 0.0f, texture = 0.0f;
+        if(method == "color_texture") {
+            if(color_texture_components(data[q], data[i], color, texture) != 0) return -1;
+        } else if(method == "laws") {
+            if(color_laws_components(data[q], data[i], color, texture) != 0) return -1;
+        } else {
+            colorGaborComponents(data[q], data[i], color, texture);
+        }
+        components[i] = color;
+        components[n + i] = texture;
+    }
+    return 0;
+}
+
+/*
+  Every weight vector with num_components entries that are multiples of
+  1/steps and sum to 1 (only the ratios matter for a ranking)
+*/
+static void simplex_grid(int num_components, int steps, std::vector<std::vector<float>> &grid) {
+    std::vector<int> parts(num_components, 0);
+    
+    // Walk all compositions of steps into num_components parts
+    std::function<void(int, int)> fill = [&](int c, int left) {
+        if(c == num_components - 1) {
+            parts[c] = left;
+            std::vector<float> w(num_components);
+            for(int j = 0; j < num_components; j++) w[j] = (float)parts[j] / steps;
+            grid.push_back(w);
+            return;
+        }
+        for(int p = 0; p <= left; p++) {
+            parts[c] = p;
+            fill(c + 1, left - p);
+        }
+    };
+    fill(0, steps);
+}
+
+/*
+  Score one weighting: weighted sum of the cached components, top-k, metrics
+*/
+static SweepResult evaluate(const std::vector<CachedQuery> &cache, int num_images, const std::vector<float> &weights,
+                            int k, std::vector<float> &scores, std::vector<int> &order) {
+    SweepResult result;
+    result.weights = weights;
+    result.precision = 0.0f;
+    result.map = 0.0f;
+    
+    int top = std::min(k, num_images - 1);
+    for(const CachedQuery &cq : cache) {
+        std::fill(scores.begin(), scores.end(), 0.0f);
+        for(size_t c = 0; c < weights.size(); c++) {
+            const float w = weights[c];
+            const float *comp = &cq.components[c * num_images];
+            for(int i = 0; i < num_images; i++) {
+                scores[i] += w * comp[i];
+            }
+        }
+        scores[cq.query] = std::numeric_limits<float>::max();
+        
+        for(int i = 0; i < num_images; i++) order[i] = i;
+        auto closer = [&](int a, int b) {
+            return scores[a] < scores[b] || (scores[a] == scores[b] && a < b);
+        };
+        std::nth_element(order.begin(), order.begin() + top, order.end(), closer);
+        std::sort(order.begin(), order.begin() + top, closer);
+        
+        std::vector<int> ranked(order.begin(), order.begin() + top);
+        result.precision += precision_at_k(ranked, cq.relevant, k);
+        result.map += average_precision(ranked, cq.relevant, k);
+    }
+    
+    result.precision /= cache.size();
+    result.map /= cache.size();
+    return result;
+}
+
+static void print_result(const char *label, const SweepResult &r) {
+    printf("%-8s", label);
+    for(float w : r.weights) printf(" %7.3f", w);
+    printf("   %8.4f %8.4f\n", r.precision, r.map);
+}
+
+int main(int argc, char *argv[]) {
+    // Check arguments
+    if(argc < 4) {
+        printf("Usage: %s <method> <features> <ground_truth> [--k K] [--steps S] [--top T]\n", argv[0]);
+        printf("  <method>    color_texture, laws, gabor (features = CSV from build_features)\n");
+        printf("              task7 (features = index from task7_custom --build)\n");
+        printf("  --k K       rank depth for precision@K and mAP@K (default 10)\n");
+        printf("  --steps S   weight grid resolution, 1/S (default 44: 45 points for 2 weights, 1035 for 3)\n");
+        printf("  --top T     number of best weightings to print (default 10)\n");
+        printf("Example: ./weight_sweep task7 olympus.hyb src/olympus_ground_truth.txt --k 5\n");
+        return -1;
+    }
+    
+    std::string method = argv[1];
+    char *features_path = argv[2];
+    char *truth_path = argv[3];
+    int k = 10;
+    int steps = 44;
+    int top = 10;
+    
+    for(int i = 4; i + 1 < argc; i += 2) {
+        if(strcmp(argv[i], "--k") == 0) k = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--steps") == 0) steps = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "--top") == 0) top = atoi(argv[i + 1]);
+        else {
+            printf("Error: Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    if(k <= 0 || steps <= 0) {
+        printf("Error: k and steps must be > 0\n");
+        return -1;
+    }
+    
+    bool is_task7 = method == "task7";
+    if(!is_task7 && method != "color_texture" && method != "laws" && method != "gabor") {
+        printf("Error: Unknown method %s\n", method.c_str());
+        return -1;
+    }
+    
+    std::vector<GroundTruthQuery> truth;
+    if(read_ground_truth(truth_path, truth) != 0) {
+        return -1;
+    }
+    
+    // Load the feature store and name -> row lookup
+    std::vector<std::string> names;
+    std::vector<char *> csv_names;
+    std::vector<std::vector<float>> data;
+    HybridIndex hybrid;
+    if(is_task7) {
+        if(read_hybrid_index(features_path, hybrid) != 0) return -1;
+        names = hybrid.names;
+    } else {
+        if(read_image_data_csv(features_path, csv_names, data, 0) != 0 || data.empty()) {
+            printf("Error: No features in %s\n", features_path);
+            return -1;
+        }
+        for(char *name : csv_names) names.push_back(name);
+    }
+    int num_images = names.size();
+    std::map<std::string, int> row_of;
+    for(int i = 0; i < num_images; i++) row_of[names[i]] = i;
+    
+    // Per-query component distances, computed once
+    auto start = std::chrono::steady_clock::now();
+    std::vector<CachedQuery> cache;
+    for(const GroundTruthQuery &gt : truth) {
+        if(row_of.count(gt.query) == 0) {
+            printf("Warning: query %s is not in %s, skipping\n", gt.query.c_str(), features_path);
+            continue;
+        }
+        CachedQuery cq;
+        cq.query = row_of[gt.query];
+        for(const std::string &rel : gt.relevant) {
+            if(row_of.count(rel)) cq.relevant.push_back(row_of[rel]);
+        }
+        
+        if(is_task7) {
+            hybrid_component_distances(hybrid, cq.query, cq.components);
+        } else if(feature_components(method, data, cq.query, cq.components) != 0) {
+            printf("Error: %s features have the wrong length for method %s\n", features_path, method.c_str());
+            return -1;
+        }
+        cache.push_back(cq);
+    }
+    double cache_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    if(cache.empty() || num_images < 2) {
+        printf("Error: No labeled queries found in the feature store\n");
+        return -1;
+    }
+    
+    // Sweep the grid
+    int num_components = is_task7 ? 3 : 2;
+    std::vector<std::vector<float>> grid;
+    simplex_grid(num_components, steps, grid);
+    
+    start = std::chrono::steady_clock::now();
+    std::vector<float> scores(num_images);
+    std::vector<int> order(num_images);
+    std::vector<SweepResult> results;
+    results.reserve(grid.size());
+    for(const std::vector<float> &w : grid) {
+        results.push_back(evaluate(cache, num_images, w, k, scores, order));
+    }
+    double sweep_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::stable_sort(results.begin(), results.end(), [](const SweepResult &a, const SweepResult &b) {
+        return a.map > b.map || (a.map == b.map && a.precision > b.precision);
+    });
+    
+    // The weights the matchers use today, for comparison
+    std::vector<float> current = is_task7 ? std::vector<float>{0.55f, 0.30f, 0.15f} : std::vector<float>{0.5f, 0.5f};
+    SweepResult baseline = evaluate(cache, num_images, current, k, scores, order);
+    
+    printf("Method: %s, images: %d, labeled queries: %lu\n", method.c_str(), num_images, cache.size());
+    printf("Grid: %lu weightings (step 1/%d), cache %.1f ms, sweep %.1f ms\n\n", grid.size(), steps, cache_ms, sweep_ms);
+    
+    printf("%-8s", "");
+    const char *labels[3] = {is_task7 ? "dnn" : "color", is_task7 ? "hsv" : "texture", "edge"};
+    for(int c = 0; c < num_components; c++) printf(" %7s", labels[c]);
+    printf("   %8s %8s\n", ("P@" + std::to_string(k)).c_str(), ("mAP@" + std::to_string(k)).c_str());
+    
+    print_result("current", baseline);
+    for(int i = 0; i < top && i < (int)results.size(); i++) {
+        print_result(("#" + std::to_string(i + 1)).c_str(), results[i]);
+    }
+    
+    return 0;
+}